@@ -0,0 +1,113 @@
+// Include Guard：避免重複包含
+#ifndef ARENA_ERROR_H
+// 與上方成對
+#define ARENA_ERROR_H
+
+// 原始錯誤型別與資料結構（Config / ValidatedData / Result）
+#include "Config.h"
+// std::byte
+#include <cstddef>
+// std::expected / std::unexpected
+#include <expected>
+// std::pmr::monotonic_buffer_resource
+#include <memory_resource>
+// std::pmr::string
+#include <string>
+// 靜態字面值以 string_view 保存
+#include <string_view>
+// std::variant
+#include <variant>
+// 初始緩衝區
+#include <vector>
+
+/*
+Arena 版本的 PipelineError
+- 與 Config.h 的錯誤型別一一對應，但動態字串改用 std::pmr::string，記憶體取自每批次的 monotonic arena
+- 一定是靜態字面值的欄位（例如 "Data Processing"）只存 std::string_view，完全不配置
+- 錯誤風暴時失敗路徑不再逐筆 new/delete；整批處理完呼叫 ErrorArena::Reset 一次回收
+*/
+
+// 開始命名空間
+namespace config::arena 
+{
+	// 讀設定檔錯誤：檔名為動態字串
+	struct ConfigReadError 
+	{
+		std::pmr::string filename;
+	};
+
+	// 解析設定檔錯誤：出錯那一行的內容為動態字串
+	struct ConfigParseError 
+	{
+		std::pmr::string line_content;
+		int              line_number;
+	};
+
+	// 驗證資料錯誤：欄位名稱與不合法值
+	struct ValidationError 
+	{
+		std::pmr::string field_name;
+		std::pmr::string invalid_value;
+	};
+
+	// 處理階段錯誤：任務名稱與細節皆為靜態字面值，不配置
+	struct ProcessingError 
+	{
+		std::string_view task_name;
+		std::string_view details;
+	};
+
+	// 與 config::PipelineError 相同順序的 variant（variant 索引可互相對照）
+	using PipelineError = std::variant<ConfigReadError,
+									   ConfigParseError,
+									   ValidationError,
+									   ProcessingError>;
+
+	// 每批次的錯誤 arena：monotonic 配置、Reset 一次回收；非執行緒安全，每個工作執行緒各自持有
+	class ErrorArena 
+	{
+	public:
+		// initial_bytes：預先準備的緩衝區大小，錯誤量在此範圍內時完全不向系統要記憶體
+		explicit ErrorArena(std::size_t initial_bytes = 4096)
+			: initial_(initial_bytes),
+			  pool_(initial_.data(), initial_.size()) 
+		{
+		}
+
+		// 不可複製、不可移動：errors 內的 pmr 字串指向 pool_
+		ErrorArena(const ErrorArena&)            = delete;
+		ErrorArena& operator=(const ErrorArena&) = delete;
+
+		// 錯誤字串使用的記憶體來源
+		[[nodiscard]] std::pmr::memory_resource* resource() noexcept { return &pool_; }
+
+		// 回收本批次所有錯誤的記憶體；呼叫後先前取得的 arena 錯誤全部失效
+		void Reset() { pool_.release(); }
+
+	private:
+		// 初始緩衝區（超出時改向預設資源要更大的區塊）
+		std::vector<std::byte>              initial_;
+		// monotonic 配置器：只前進不回收，Reset 時整批歸零
+		std::pmr::monotonic_buffer_resource pool_;
+	};
+// 結束命名空間
+}
+
+// 開始命名空間
+namespace config 
+{
+	// 函式原型宣告：讀設定檔（失敗時錯誤字串配置自 arena）
+	[[nodiscard]] std::expected<Config,        arena::PipelineError> LoadConfig  (const std::string& filename, arena::ErrorArena& errors);
+	// 函式原型宣告：驗證資料（失敗時錯誤字串配置自 arena）
+	[[nodiscard]] std::expected<ValidatedData, arena::PipelineError> ValidateData(const Config& config, arena::ErrorArena& errors);
+	// 函式原型宣告：驗證資料（右值版本，接手 config.data 的緩衝區）
+	[[nodiscard]] std::expected<ValidatedData, arena::PipelineError> ValidateData(Config&& config, arena::ErrorArena& errors);
+	// 函式原型宣告：處理資料（錯誤不配置任何記憶體）
+	[[nodiscard]] std::expected<Result,        arena::PipelineError> ProcessData (const ValidatedData& data, arena::ErrorArena& errors);
+
+	// 轉回一般的 PipelineError（自行擁有字串），供需要在 arena 重置後保留、或交給既有報告流程時使用
+	[[nodiscard]] PipelineError ToOwned(const arena::PipelineError& error);
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,59 @@
+// Include Guard：避免重複包含
+#ifndef ASYNC_LOADER_H
+// 與上方成對
+#define ASYNC_LOADER_H
+
+// WorkStealingPool、BatchStats
+#include "BatchExecutor.h"
+// std::expected
+#include <expected>
+// 輸入路徑
+#include <span>
+// std::string
+#include <string>
+// 結果陣列
+#include <vector>
+
+/*
+非同步批次讀檔
+- 路徑依執行緒切成數個分片，每個分片在一個工作執行緒上以自己的 io_uring 送出 open → read → close，
+  多個檔案的 I/O 同時進行；read 一完成就在同一執行緒接著做 LoadConfigFromBuffer → ValidateData → ProcessData
+- 無法建立 io_uring（舊核心、被 seccomp 禁止）或 use_io_uring 為 false 時，退回在執行緒池上逐檔阻塞讀取
+- 同時開著的檔案數不超過 max_in_flight（預設與 demo::SimulateOpenMany 的 limit 相同）
+- 開檔遇到 EMFILE / ENFILE 視為背壓而非失敗：縮小並行數、等進行中的檔案關閉後重試；
+  只有在沒有任何進行中的檔案、且重試仍失敗時才回報 ConfigReadError
+*/
+
+// 開始命名空間
+namespace config
+{
+	// 非同步讀檔選項
+	struct AsyncLoadOptions
+	{
+		// 同時開著的檔案數上限（所有分片合計）
+		std::size_t max_in_flight = 1024;
+		// 是否嘗試 io_uring；false 時一律使用阻塞式讀檔
+		bool        use_io_uring  = true;
+	};
+
+	// 非同步讀檔統計
+	struct AsyncLoadStats
+	{
+		// 成功 / 失敗筆數（與 RunBatch 相同）
+		BatchStats  batch;
+		// 使用 io_uring 的分片數（0 表示全部退回阻塞式讀檔）
+		std::size_t io_uring_shards     = 0;
+		// 開檔遇到 EMFILE / ENFILE 而延後重試的次數
+		std::size_t backpressure_events = 0;
+		// 各分片同時開著的檔案數峰值之和（上限）
+		std::size_t peak_in_flight      = 0;
+	};
+
+	// 以非同步 I/O 讀取整批設定檔並跑完管線，結果依輸入順序排列；stats 非空時填入統計
+	[[nodiscard]] std::vector<std::expected<Result, PipelineError>>
+	LoadBatchAsync(WorkStealingPool& pool, std::span<const std::string> paths,
+	               const AsyncLoadOptions& options = {}, AsyncLoadStats* stats = nullptr);
+// 結束命名空間
+}
+
+#endif
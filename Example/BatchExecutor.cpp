@@ -0,0 +1,194 @@
+// 引入對應的宣告標頭
+#include "BatchExecutor.h"
+// std::max
+#include <algorithm>
+// 可在編譯期移除的階段量測
+#include "Metrics.h"
+// 可在編譯期移除的故障注入
+#include "FaultInjection.h"
+// std::move
+#include <utility>
+
+// 進入命名空間
+namespace config 
+{
+	// 建立工作執行緒
+	WorkStealingPool::WorkStealingPool(std::size_t thread_count) 
+	{
+		if (thread_count == 0) 
+			thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+		ranges_ = std::make_unique<Range[]>(thread_count);
+		workers_.reserve(thread_count);
+		for (std::size_t w = 0; w < thread_count; ++w) 
+			workers_.emplace_back([this, w] { WorkerLoop(w); });
+	}
+
+	// 通知停止並等待所有執行緒結束
+	WorkStealingPool::~WorkStealingPool() 
+	{
+		{
+			std::lock_guard lock(mutex_);
+			stop_ = true;
+		}
+		wake_.notify_all();
+		for (auto& t : workers_) 
+			t.join();
+	}
+
+	// 切分索引、喚醒工作執行緒並等待整批完成
+	void WorkStealingPool::ForEach(std::size_t count, const std::function<void(std::size_t, std::size_t)>& fn) 
+	{
+		if (count == 0) 
+			return;
+
+		std::unique_lock lock(mutex_);
+		// 平均切成每個執行緒一段（前 extra 段多分一個）
+		const std::size_t n     = workers_.size();
+		const std::size_t base  = count / n;
+		const std::size_t extra = count % n;
+		std::size_t begin = 0;
+		for (std::size_t w = 0; w < n; ++w) 
+		{
+			const std::size_t len = base + (w < extra ? 1 : 0);
+			ranges_[w].next.store(begin, std::memory_order_relaxed);
+			ranges_[w].end = begin + len;
+			begin += len;
+		}
+
+		job_    = &fn;
+		active_ = n;
+		++generation_;
+		wake_.notify_all();
+		// 等到所有執行緒都做完（包含偷來的工作）
+		done_.wait(lock, [this] { return active_ == 0; });
+		job_ = nullptr;
+	}
+
+	// 等待新批次 → 執行 → 回報完成
+	void WorkStealingPool::WorkerLoop(std::size_t worker) 
+	{
+		std::uint64_t seen = 0;
+		for (;;) 
+		{
+			{
+				std::unique_lock lock(mutex_);
+				wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+				if (stop_) 
+					return;
+				seen = generation_;
+			}
+
+			// mutex 的取得/釋放已讓區段設定對本執行緒可見
+			Drain(worker);
+
+			{
+				std::lock_guard lock(mutex_);
+				if (--active_ == 0) 
+					done_.notify_one();
+			}
+		}
+	}
+
+	// 以原子游標領取索引：自己的區段做完後，依序從其他執行緒的區段偷
+	void WorkStealingPool::Drain(std::size_t worker) 
+	{
+		const std::size_t n = workers_.size();
+		for (std::size_t k = 0; k < n; ++k) 
+		{
+			Range& range = ranges_[(worker + k) % n];
+			for (std::size_t i = range.next.fetch_add(1, std::memory_order_relaxed);
+			     i < range.end;
+			     i = range.next.fetch_add(1, std::memory_order_relaxed)) 
+			{
+				(*job_)(i, worker);
+			}
+		}
+	}
+
+	// 僅供本檔使用
+	namespace 
+	{
+		// 兩種 RunBatch 共用：load(i) 取得第 i 筆的 Config，之後驗證、處理，結果寫入第 i 格
+		template<typename Load>
+		std::vector<std::expected<Result, PipelineError>>
+		RunEach(WorkStealingPool& pool, std::size_t count, BatchStats* stats, const Load& load) 
+		{
+			// 預先建立所有結果格：每格只由處理該索引的執行緒寫入
+			std::vector<std::expected<Result, PipelineError>> results(count);
+
+			// 每個執行緒各自的統計（獨占快取線），結束後才合併
+			struct alignas(64) LocalStats { BatchStats value; };
+			std::vector<LocalStats> local(pool.thread_count());
+
+			// 後兩個階段包上量測與故障注入（CONFIG_METRICS / CONFIG_FAULTS 為 0 時即原本的 lambda）；緩衝區歸還各工作執行緒的物件池快取
+			const auto validate = metrics::Instrument(metrics::Stage::kValidateData, fault::Inject(fault::Stage::kValidateData,
+			                                          [](Config&& cfg) { return ValidateDataPooled(std::move(cfg)); }));
+			const auto process  = metrics::Instrument(metrics::Stage::kProcessData, fault::Inject(fault::Stage::kProcessData,
+			                                          [](ValidatedData&& vd) { return ProcessDataPooled(std::move(vd)); }));
+
+			pool.ForEach(count, [&](std::size_t i, std::size_t worker) 
+			{
+				auto r = load(i).and_then(validate).and_then(process);
+
+				auto& s = local[worker].value;
+				if (r) 
+					++s.succeeded;
+				else 
+					++s.errors_by_index[r.error().index()];
+				results[i] = std::move(r);
+			});
+
+			if (stats != nullptr) 
+			{
+				*stats = {};
+				for (const auto& l : local) 
+				{
+					stats->succeeded += l.value.succeeded;
+					for (std::size_t k = 0; k < stats->errors_by_index.size(); ++k) 
+						stats->errors_by_index[k] += l.value.errors_by_index[k];
+				}
+			}
+			return results;
+		}
+	}
+
+	// 以既有的執行緒池跑整批管線
+	std::vector<std::expected<Result, PipelineError>>
+	RunBatch(WorkStealingPool& pool, std::span<const std::string> paths, BatchStats* stats) 
+	{
+		// 讀檔緩衝區取自各工作執行緒的物件池快取
+		const auto load = metrics::Instrument(metrics::Stage::kLoadConfig, fault::Inject(fault::Stage::kLoadConfig,
+		                                      [](const std::string& path) { return LoadConfigPooled(path); }));
+		return RunEach(pool, paths.size(), stats, [&](std::size_t i) { return load(paths[i]); });
+	}
+
+	// 依配置政策讀檔：緩衝區在負責該筆的工作執行緒上新配置並第一次寫入
+	std::vector<std::expected<Result, PipelineError>>
+	RunBatch(WorkStealingPool& pool, std::span<const std::string> paths, const memory::Policy& policy, BatchStats* stats) 
+	{
+		const auto load = metrics::Instrument(metrics::Stage::kLoadConfig, fault::Inject(fault::Stage::kLoadConfig,
+		                                      [&policy](const std::string& path) { return LoadConfig(path, policy); }));
+		return RunEach(pool, paths.size(), stats, [&](std::size_t i) { return load(paths[i]); });
+	}
+
+	// 內容已在記憶體中：直接交給 LoadConfigFromBuffer
+	std::vector<std::expected<Result, PipelineError>>
+	RunBatch(WorkStealingPool& pool, std::span<BufferedConfig> configs, BatchStats* stats) 
+	{
+		const auto load = metrics::Instrument(metrics::Stage::kLoadConfig, fault::Inject(fault::Stage::kLoadConfig,
+		                                      [](BufferedConfig& config) { return LoadConfigFromBuffer(config.name, std::move(config.content)); }));
+		return RunEach(pool, configs.size(), stats, [&](std::size_t i) { return load(configs[i]); });
+	}
+
+	// 建立暫時的執行緒池跑整批管線
+	std::vector<std::expected<Result, PipelineError>>
+	RunBatch(std::span<const std::string> paths, const BatchOptions& options, BatchStats* stats) 
+	{
+		WorkStealingPool pool(options.thread_count);
+		if (options.memory.enabled()) 
+			return RunBatch(pool, paths, options.memory, stats);
+		return RunBatch(pool, paths, stats);
+	}
+// 結束命名空間
+}
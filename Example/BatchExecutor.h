@@ -0,0 +1,144 @@
+// Include Guard：避免重複包含
+#ifndef BATCH_EXECUTOR_H
+// 與上方成對
+#define BATCH_EXECUTOR_H
+
+// 管線階段與錯誤型別
+#include "Config.h"
+// 每種錯誤的計數
+#include <array>
+// 工作範圍游標
+#include <atomic>
+// 喚醒工作執行緒
+#include <condition_variable>
+// 固定寬度整數
+#include <cstdint>
+// std::expected
+#include <expected>
+// 型別抹除後的工作函式
+#include <functional>
+// 工作範圍陣列
+#include <memory>
+// 工作佇列互斥
+#include <mutex>
+// 輸入路徑
+#include <span>
+// std::string
+#include <string>
+// 工作執行緒
+#include <thread>
+// 結果陣列
+#include <vector>
+
+/*
+批次管線執行器
+- WorkStealingPool：常駐工作執行緒；每批工作把索引切成每個執行緒一段，
+  做完自己那段後再去其他執行緒的剩餘區段偷工作（以原子游標領取，不需鎖）
+- RunBatch：把 LoadConfig → ValidateData → ProcessData 套用到每個路徑，結果依輸入順序回傳；
+  使用緩衝區重用版本的階段（LoadConfigPooled 等），每個工作執行緒重複使用自己快取的緩衝區
+  各階段可在建置時開啟量測（CONFIG_METRICS）與故障注入（CONFIG_FAULTS，見 FaultInjection.h）
+- RunBatch(pool, configs)：內容已在記憶體中的版本（ValidationService 的節點以它處理收到的批次）
+- RunBatch(pool, paths, policy)：大型設定依配置政策（MemoryPolicy.h）讀入：緩衝區由負責該筆的工作執行緒新配置
+  （不經過物件池），之後的驗證與處理也在同一執行緒，頁面落在它的 NUMA 節點；BatchOptions::memory 啟用時使用
+- 每個結果格只由一個執行緒寫入；統計數字先在每個執行緒各自累加，最後才合併，不共用計數器
+*/
+
+// 開始命名空間
+namespace config 
+{
+	// 工作竊取執行緒池：ForEach 會阻塞到整批完成；同一時間只接受一批工作
+	class WorkStealingPool 
+	{
+	public:
+		// thread_count 為 0 時使用硬體執行緒數（至少 1）
+		explicit WorkStealingPool(std::size_t thread_count = 0);
+		// 解構：通知所有工作執行緒結束並等待
+		~WorkStealingPool();
+
+		// 不可複製、不可移動：工作執行緒持有 this
+		WorkStealingPool(const WorkStealingPool&)            = delete;
+		WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+		// 對 [0, count) 的每個索引呼叫 fn(index, worker)；worker 為執行該工作的執行緒編號
+		void ForEach(std::size_t count, const std::function<void(std::size_t index, std::size_t worker)>& fn);
+
+		// 工作執行緒數
+		[[nodiscard]] std::size_t thread_count() const noexcept { return workers_.size(); }
+
+	private:
+		// 每個執行緒擁有的一段索引；獨占一條快取線，避免偽共享
+		struct alignas(64) Range 
+		{
+			std::atomic<std::size_t> next{0};
+			std::size_t              end = 0;
+		};
+
+		// 工作執行緒主迴圈
+		void WorkerLoop(std::size_t worker);
+		// 先做自己的區段，再依序偷其他區段
+		void Drain(std::size_t worker);
+
+		// 工作執行緒
+		std::vector<std::thread>  workers_;
+		// 每個執行緒的區段
+		std::unique_ptr<Range[]>  ranges_;
+		// 保護以下所有狀態
+		std::mutex                mutex_;
+		// 新批次或停止
+		std::condition_variable   wake_;
+		// 批次完成
+		std::condition_variable   done_;
+		// 目前批次的工作函式
+		const std::function<void(std::size_t, std::size_t)>* job_ = nullptr;
+		// 批次編號：每批加一，工作執行緒據此判斷是否有新工作
+		std::uint64_t             generation_ = 0;
+		// 尚未完成本批的執行緒數
+		std::size_t               active_ = 0;
+		// 是否正在解構
+		bool                      stop_ = false;
+	};
+
+	// 批次選項
+	struct BatchOptions 
+	{
+		// 工作執行緒數；0 表示使用硬體執行緒數
+		std::size_t thread_count = 0;
+		// 讀檔緩衝區的大頁與 NUMA 配置政策；預設關閉（沿用物件池）
+		memory::Policy memory{};
+	};
+
+	// 批次統計：由每個執行緒各自的計數合併而來
+	struct BatchStats 
+	{
+		// 成功筆數
+		std::size_t succeeded = 0;
+		// 依 PipelineError 的 variant 索引分類的失敗筆數
+		std::array<std::size_t, std::variant_size_v<PipelineError>> errors_by_index{};
+	};
+
+	// 以既有的執行緒池跑整批管線，結果依輸入順序排列；stats 非空時填入統計
+	[[nodiscard]] std::vector<std::expected<Result, PipelineError>>
+	RunBatch(WorkStealingPool& pool, std::span<const std::string> paths, BatchStats* stats = nullptr);
+
+	// 同上，讀檔緩衝區依配置政策新配置
+	[[nodiscard]] std::vector<std::expected<Result, PipelineError>>
+	RunBatch(WorkStealingPool& pool, std::span<const std::string> paths, const memory::Policy& policy, BatchStats* stats = nullptr);
+
+	// 建立暫時的執行緒池跑整批管線
+	[[nodiscard]] std::vector<std::expected<Result, PipelineError>>
+	RunBatch(std::span<const std::string> paths, const BatchOptions& options = {}, BatchStats* stats = nullptr);
+
+	// 已在記憶體中的設定（例如由網路收到）：名稱只用於錯誤訊息
+	struct BufferedConfig 
+	{
+		std::string name;
+		std::string content;
+	};
+
+	// 同一條管線，讀檔改為 LoadConfigFromBuffer；各筆內容被移走（configs 中的 content 之後為空）
+	[[nodiscard]] std::vector<std::expected<Result, PipelineError>>
+	RunBatch(WorkStealingPool& pool, std::span<BufferedConfig> configs, BatchStats* stats = nullptr);
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,348 @@
+// 引入對應的宣告標頭
+#include "BinaryConfig.h"
+// 可在編譯期移除的除錯日誌
+#include "Log.h"
+// std::memcpy
+#include <cstring>
+// rename / remove
+#include <filesystem>
+// 寫檔
+#include <fstream>
+// std::numeric_limits
+#include <limits>
+// std::move
+#include <utility>
+// POSIX：stat（來源檔的大小與修改時間）
+#include <sys/stat.h>
+
+// 進入命名空間
+namespace binary
+{
+	// 僅供本檔使用
+	namespace
+	{
+		// 魔數：以本機位元組序寫入的 64 位元整數，位元組序不同時讀出來不相等
+		constexpr std::uint64_t kMagic = 0x3150414e53474643ull;  // "CFGSNAP1"
+
+		// 檔頭（64 位元組，所有欄位自然對齊）
+		struct Header
+		{
+			std::uint64_t magic;
+			std::uint32_t version;
+			std::uint32_t header_size;
+			// 來源檔的大小與修改時間（奈秒）
+			std::uint64_t source_size;
+			std::int64_t  source_mtime;
+			// 各段長度
+			std::uint32_t entry_count;
+			std::uint32_t pool_size;
+			std::uint64_t data_size;
+			// 酬載（檔頭之後的全部位元組）的雜湊
+			std::uint64_t checksum;
+			std::uint64_t reserved;
+		};
+		static_assert(sizeof(Header) == 64);
+
+		// 欄位表的一列
+		struct Entry
+		{
+			std::uint32_t key_offset;
+			std::uint32_t key_size;
+			std::uint32_t value_offset;
+			std::uint32_t value_size;
+			std::uint32_t line;
+		};
+		static_assert(sizeof(Entry) == 20);
+
+		// 以 8 位元組為單位的 FNV-1a 變形：每個字組一次乘法，加上右移混入高位（逐位元組版本的數倍快）
+		[[nodiscard]] std::uint64_t Checksum(std::string_view bytes) noexcept
+		{
+			constexpr std::uint64_t kPrime = 1099511628211ull;
+			std::uint64_t hash = 14695981039346656037ull ^ bytes.size();
+			std::size_t i = 0;
+			for (; i + 8 <= bytes.size(); i += 8)
+			{
+				std::uint64_t word;
+				std::memcpy(&word, bytes.data() + i, sizeof(word));
+				hash = (hash ^ word) * kPrime;
+				hash ^= hash >> 29;
+			}
+			for (; i < bytes.size(); ++i)
+				hash = (hash ^ static_cast<unsigned char>(bytes[i])) * kPrime;
+			return hash;
+		}
+
+		// 來源檔目前的大小與修改時間
+		struct SourceStamp
+		{
+			std::uint64_t size  = 0;
+			std::int64_t  mtime = 0;
+		};
+		[[nodiscard]] std::optional<SourceStamp> StampOf(const std::string& source) noexcept
+		{
+			struct stat st{};
+			if (::stat(source.c_str(), &st) != 0)
+				return std::nullopt;
+			return SourceStamp{static_cast<std::uint64_t>(st.st_size),
+			                   static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec};
+		}
+
+		// 編譯期間來源檔持續變更時，最多重新讀取的次數
+		constexpr int kCompileAttempts = 3;
+
+		// 第 i 列（映射位址未必對齊 Entry：以 memcpy 讀取，編譯器會展開成一般載入）
+		[[nodiscard]] Entry EntryAt(const char* entries, std::size_t i) noexcept
+		{
+			Entry entry;
+			std::memcpy(&entry, entries + i * sizeof(Entry), sizeof(Entry));
+			return entry;
+		}
+
+		// 失敗的結果
+		[[nodiscard]] std::unexpected<ImageError> Fail(const std::string& path, Fault fault)
+		{
+			CONFIG_LOG(logging::Level::kWarn, "config image unusable: ", path);
+			return std::unexpected(ImageError{path, fault});
+		}
+
+		// 整份快照先在記憶體中組好，寫到暫存檔後 rename 取代舊檔；stamp 為讀取 config 內容之前取得的來源檔戳記
+		[[nodiscard]] std::expected<void, ImageError> WriteStamped(const std::string& path, const config::Config& config, const SourceStamp& stamp)
+		{
+			const kv::Table& fields = config.fields;
+			if (!fields.parsed() || fields.size() > std::numeric_limits<std::uint32_t>::max())
+				return Fail(path, Fault::kWrite);
+
+			// 欄位表與字串池：依 Table 的順序（已依鍵排序）
+			std::string entries;
+			std::string pool;
+			entries.reserve(fields.size() * sizeof(Entry));
+			pool.reserve(fields.pool_bytes());
+			for (std::size_t i = 0; i < fields.size(); ++i)
+			{
+				const kv::Field field = fields[i];
+				Entry entry{};
+				entry.key_offset   = static_cast<std::uint32_t>(pool.size());
+				entry.key_size     = static_cast<std::uint32_t>(field.key.size());
+				pool.append(field.key);
+				entry.value_offset = static_cast<std::uint32_t>(pool.size());
+				entry.value_size   = static_cast<std::uint32_t>(field.value.size());
+				pool.append(field.value);
+				entry.line         = static_cast<std::uint32_t>(field.line);
+				entries.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+			}
+			if (pool.size() > std::numeric_limits<std::uint32_t>::max())
+				return Fail(path, Fault::kWrite);
+
+			std::string image(sizeof(Header), '\0');
+			image.reserve(sizeof(Header) + entries.size() + pool.size() + config.data.size());
+			image += entries;
+			image += pool;
+			image += config.data;
+
+			Header header{};
+			header.magic        = kMagic;
+			header.version      = kImageVersion;
+			header.header_size  = sizeof(Header);
+			header.source_size  = stamp.size;
+			header.source_mtime = stamp.mtime;
+			header.entry_count  = static_cast<std::uint32_t>(fields.size());
+			header.pool_size    = static_cast<std::uint32_t>(pool.size());
+			header.data_size    = config.data.size();
+			header.checksum     = Checksum(std::string_view(image).substr(sizeof(Header)));
+			std::memcpy(image.data(), &header, sizeof(header));
+
+			const std::string temp = path + ".tmp";
+			{
+				std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+				out.write(image.data(), static_cast<std::streamsize>(image.size()));
+				if (!out.flush())
+				{
+					std::error_code ec;
+					std::filesystem::remove(temp, ec);
+					return Fail(path, Fault::kWrite);
+				}
+			}
+			std::error_code ec;
+			std::filesystem::rename(temp, path, ec);
+			if (ec)
+			{
+				std::filesystem::remove(temp, ec);
+				return Fail(path, Fault::kWrite);
+			}
+			CONFIG_LOG(logging::Level::kDebug, "config image written: ", path);
+			return {};
+		}
+	}
+
+	// 原因的名稱
+	std::string_view ToString(Fault fault) noexcept
+	{
+		switch (fault)
+		{
+			case Fault::kOpen:      return "cannot open image";
+			case Fault::kBadMagic:  return "not a config image";
+			case Fault::kVersion:   return "image format version mismatch";
+			case Fault::kTruncated: return "image size does not match header";
+			case Fault::kChecksum:  return "image checksum mismatch";
+			case Fault::kCorrupt:   return "image field table out of range";
+			case Fault::kStale:     return "source changed since image was written";
+			case Fault::kWrite:     return "cannot write image";
+		}
+		return "unknown image fault";
+	}
+
+	// 依鍵排序的第 i 個欄位
+	kv::Field ConfigImage::operator[](std::size_t i) const noexcept
+	{
+		const Entry entry = EntryAt(entries_, i);
+		kv::Field field;
+		field.key   = pool_.substr(entry.key_offset, entry.key_size);
+		field.value = pool_.substr(entry.value_offset, entry.value_size);
+		field.line  = static_cast<int>(entry.line);
+		return field;
+	}
+
+	// 二分搜尋：只比較鍵，不建構整個欄位
+	std::optional<std::string_view> ConfigImage::Find(std::string_view key) const noexcept
+	{
+		std::size_t low  = 0;
+		std::size_t high = count_;
+		while (low < high)
+		{
+			const std::size_t mid = low + (high - low) / 2;
+			const Entry entry = EntryAt(entries_, mid);
+			if (pool_.substr(entry.key_offset, entry.key_size) < key)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+		if (low == count_)
+			return std::nullopt;
+		const Entry entry = EntryAt(entries_, low);
+		if (pool_.substr(entry.key_offset, entry.key_size) != key)
+			return std::nullopt;
+		return pool_.substr(entry.value_offset, entry.value_size);
+	}
+
+	// 與 ValidateData 的結果相同：內容 + 已驗證標記
+	config::ValidatedData ConfigImage::ToValidated() const
+	{
+		return config::ValidatedData{std::string(data_), config::kValidatedTag};
+	}
+
+	// 來源檔名 + 後綴
+	std::string ImagePathFor(const std::string& source)
+	{
+		return source + std::string(kImageSuffix);
+	}
+
+	// 以來源檔目前的戳記寫入
+	std::expected<void, ImageError> WriteImage(const std::string& path, const config::Config& config, const std::string& source)
+	{
+		const auto stamp = StampOf(source);
+		if (!stamp)
+			return Fail(path, Fault::kWrite);
+		return WriteStamped(path, config, *stamp);
+	}
+
+	// 文字路徑全部通過才寫快照：戳記在讀檔之前取得，讀完後來源檔的戳記必須不變，
+	// 否則快照會帶著新的戳記與舊的內容而被 LoadImage 當成最新；變更時重新編譯，連續變更則回報 kStale
+	std::expected<void, CompileError> CompileImage(const std::string& source)
+	{
+		const std::string path = ImagePathFor(source);
+		for (int attempt = 0; attempt < kCompileAttempts; ++attempt)
+		{
+			const auto stamp = StampOf(source);
+			auto config = config::LoadConfig(source, config::Exact{});
+			if (!config)
+				return std::unexpected(meta::Widen<CompileError>(std::move(config).error()));
+			if (auto validated = config::ValidateData(*config, config::Exact{}); !validated)
+				return std::unexpected(meta::Widen<CompileError>(std::move(validated).error()));
+			const auto after = StampOf(source);
+			if (!stamp || !after || stamp->size != after->size || stamp->mtime != after->mtime)
+			{
+				CONFIG_LOG(logging::Level::kWarn, "config source changed while compiling: ", source);
+				continue;
+			}
+			if (auto written = WriteStamped(path, *config, *stamp); !written)
+				return std::unexpected(CompileError{std::move(written).error()});
+			return {};
+		}
+		return std::unexpected(CompileError{ImageError{path, Fault::kStale}});
+	}
+
+	// 先比檔頭與 stat（不碰酬載），最後才算雜湊
+	std::expected<ConfigImage, ImageError> LoadImage(const std::string& path, const std::string& source)
+	{
+		auto mapping = config::MappedFile::Open(path);
+		if (!mapping)
+			return Fail(path, Fault::kOpen);
+		const std::string_view bytes = mapping->view();
+
+		if (bytes.size() < sizeof(std::uint64_t))
+			return Fail(path, Fault::kBadMagic);
+		Header header{};
+		std::memcpy(&header.magic, bytes.data(), sizeof(header.magic));
+		if (header.magic != kMagic)
+			return Fail(path, Fault::kBadMagic);
+		if (bytes.size() < sizeof(Header))
+			return Fail(path, Fault::kTruncated);
+		std::memcpy(&header, bytes.data(), sizeof(Header));
+		if (header.version != kImageVersion || header.header_size != sizeof(Header))
+			return Fail(path, Fault::kVersion);
+
+		const auto stamp = StampOf(source);
+		if (!stamp || stamp->size != header.source_size || stamp->mtime != header.source_mtime)
+			return Fail(path, Fault::kStale);
+
+		// 各段長度加總必須恰好等於檔案長度（以 64 位元計算，不會溢位）
+		const std::uint64_t entries_size = std::uint64_t{header.entry_count} * sizeof(Entry);
+		const std::string_view payload = bytes.substr(sizeof(Header));
+		if (entries_size + header.pool_size + header.data_size != payload.size())
+			return Fail(path, Fault::kTruncated);
+		if (Checksum(payload) != header.checksum)
+			return Fail(path, Fault::kChecksum);
+
+		ConfigImage image;
+		image.entries_ = payload.data();
+		image.count_   = header.entry_count;
+		image.pool_    = payload.substr(entries_size, header.pool_size);
+		image.data_    = payload.substr(entries_size + header.pool_size);
+		// 雜湊相符只表示內容是寫入時的樣子：仍確認每一列都落在字串池內，查詢時不需再檢查
+		for (std::size_t i = 0; i < image.count_; ++i)
+		{
+			const Entry entry = EntryAt(image.entries_, i);
+			if (std::uint64_t{entry.key_offset} + entry.key_size > image.pool_.size() ||
+			    std::uint64_t{entry.value_offset} + entry.value_size > image.pool_.size())
+				return Fail(path, Fault::kCorrupt);
+		}
+		// 映射位址在移動後不變，檢視仍然有效
+		image.mapping_ = std::move(*mapping);
+		return image;
+	}
+
+	// 快照可用時完全跳過解析與驗證
+	std::expected<config::ValidatedData, ValidatedError> LoadValidated(const std::string& source, config::Exact, ImageError* fallback)
+	{
+		auto image = LoadImage(ImagePathFor(source), source);
+		if (image)
+			return image->ToValidated();
+		if (fallback != nullptr)
+			*fallback = std::move(image).error();
+		auto config = config::LoadConfig(source, config::Exact{});
+		if (!config)
+			return std::unexpected(meta::Widen<ValidatedError>(std::move(config).error()));
+		auto validated = config::ValidateData(std::move(*config), config::Exact{});
+		if (!validated)
+			return std::unexpected(meta::Widen<ValidatedError>(std::move(validated).error()));
+		return std::move(*validated);
+	}
+
+	std::expected<config::ValidatedData, config::PipelineError> LoadValidated(const std::string& source, ImageError* fallback)
+	{
+		return LoadValidated(source, config::Exact{}, fallback).transform_error([](ValidatedError&& error) {
+			return meta::Widen<config::PipelineError>(std::move(error));
+		});
+	}
+// 結束命名空間
+}
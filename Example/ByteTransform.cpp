@@ -0,0 +1,194 @@
+// 引入對應的宣告標頭
+#include "ByteTransform.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// x86：以 target 屬性個別編譯 AVX2 / AVX-512 版本，不需全域編譯旗標
+#define BYTES_X86_DISPATCH 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+// AArch64：NEON 為基本指令集
+#include <arm_neon.h>
+#endif
+
+// 進入命名空間
+namespace bytes
+{
+	// 匿名命名空間：各實作只在此檔可見
+	namespace
+	{
+		// 所有實作共用的函式型別：in 與 out 可為同一塊記憶體（就地）
+		using Kernel = void (*)(const char* in, char* out, std::size_t size, std::int8_t delta) noexcept;
+
+		// 純量版本：同時負責 SIMD 版本的尾端
+		void ScalarKernel(const char* in, char* out, std::size_t size, std::int8_t delta) noexcept
+		{
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				const auto c = static_cast<unsigned char>(in[i]);
+				out[i] = static_cast<char>(c == 0 ? 0u : static_cast<unsigned char>(c + static_cast<unsigned char>(delta)));
+			}
+		}
+
+#if defined(__SSE2__)
+		// SSE2：先加上位移，再用「等於 0」的遮罩把原本為 0 的位元組清回 0
+		void Sse2Kernel(const char* in, char* out, std::size_t size, std::int8_t delta) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i step = _mm_set1_epi8(delta);
+			std::size_t i = 0;
+			for (; i + 16 <= size; i += 16)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				const __m128i r = _mm_andnot_si128(_mm_cmpeq_epi8(v, zero), _mm_add_epi8(v, step));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+			}
+			ScalarKernel(in + i, out + i, size - i, delta);
+		}
+#endif
+
+#if defined(BYTES_X86_DISPATCH)
+		// AVX2：同 SSE2，一次 32 個位元組
+		__attribute__((target("avx2")))
+		void Avx2Kernel(const char* in, char* out, std::size_t size, std::int8_t delta) noexcept
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i step = _mm256_set1_epi8(delta);
+			std::size_t i = 0;
+			for (; i + 32 <= size; i += 32)
+			{
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+				const __m256i r = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, zero), _mm256_add_epi8(v, step));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+			}
+			ScalarKernel(in + i, out + i, size - i, delta);
+		}
+
+		// AVX-512BW：遮罩暫存器直接表達「非零才加」；尾端用遮罩載入 / 存回，不必退回純量
+		__attribute__((target("avx512f,avx512bw")))
+		void Avx512Kernel(const char* in, char* out, std::size_t size, std::int8_t delta) noexcept
+		{
+			const __m512i step = _mm512_set1_epi8(delta);
+			std::size_t i = 0;
+			for (; i + 64 <= size; i += 64)
+			{
+				const __m512i v = _mm512_loadu_si512(in + i);
+				_mm512_storeu_si512(out + i, _mm512_maskz_add_epi8(_mm512_test_epi8_mask(v, v), v, step));
+			}
+			if (i < size)
+			{
+				const __mmask64 tail = (~__mmask64{0}) >> (64 - (size - i));
+				const __m512i v = _mm512_maskz_loadu_epi8(tail, in + i);
+				_mm512_mask_storeu_epi8(out + i, tail, _mm512_maskz_add_epi8(_mm512_test_epi8_mask(v, v), v, step));
+			}
+		}
+#endif
+
+#if defined(__ARM_NEON)
+		// NEON：vbic 以「等於 0」遮罩清除位元，一次 16 個位元組
+		void NeonKernel(const char* in, char* out, std::size_t size, std::int8_t delta) noexcept
+		{
+			const uint8x16_t step = vdupq_n_u8(static_cast<std::uint8_t>(delta));
+			std::size_t i = 0;
+			for (; i + 16 <= size; i += 16)
+			{
+				const uint8x16_t v = vld1q_u8(reinterpret_cast<const std::uint8_t*>(in + i));
+				const uint8x16_t r = vbicq_u8(vaddq_u8(v, step), vceqzq_u8(v));
+				vst1q_u8(reinterpret_cast<std::uint8_t*>(out + i), r);
+			}
+			ScalarKernel(in + i, out + i, size - i, delta);
+		}
+#endif
+
+		// 指定實作對應的函式；不支援時退回純量
+		Kernel KernelFor(Isa isa) noexcept
+		{
+			if (!Supported(isa))
+				return ScalarKernel;
+			switch (isa)
+			{
+#if defined(__SSE2__)
+			case Isa::kSse2:   return Sse2Kernel;
+#endif
+#if defined(BYTES_X86_DISPATCH)
+			case Isa::kAvx2:   return Avx2Kernel;
+			case Isa::kAvx512: return Avx512Kernel;
+#endif
+#if defined(__ARM_NEON)
+			case Isa::kNeon:   return NeonKernel;
+#endif
+			default:           return ScalarKernel;
+			}
+		}
+
+		// 第一次呼叫時選定的實作（函式內 static：初始化為執行緒安全）
+		Kernel ActiveKernel() noexcept
+		{
+			static const Kernel kernel = KernelFor(ActiveIsa());
+			return kernel;
+		}
+	}
+
+	// 依支援程度由寬到窄挑選
+	Isa ActiveIsa() noexcept
+	{
+		static const Isa isa = [] {
+			for (const Isa candidate : {Isa::kAvx512, Isa::kAvx2, Isa::kSse2, Isa::kNeon})
+				if (Supported(candidate))
+					return candidate;
+			return Isa::kScalar;
+		}();
+		return isa;
+	}
+
+	// 編譯目標 + CPU 偵測
+	bool Supported(Isa isa) noexcept
+	{
+		switch (isa)
+		{
+		case Isa::kScalar: return true;
+#if defined(__SSE2__)
+		case Isa::kSse2:   return true;
+#endif
+#if defined(BYTES_X86_DISPATCH)
+		case Isa::kAvx2:   return __builtin_cpu_supports("avx2");
+		case Isa::kAvx512: return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+#if defined(__ARM_NEON)
+		case Isa::kNeon:   return true;
+#endif
+		default:           return false;
+		}
+	}
+
+	// 實作名稱
+	std::string_view ToString(Isa isa) noexcept
+	{
+		switch (isa)
+		{
+		case Isa::kScalar: return "scalar";
+		case Isa::kSse2:   return "sse2";
+		case Isa::kAvx2:   return "avx2";
+		case Isa::kAvx512: return "avx512";
+		case Isa::kNeon:   return "neon";
+		}
+		return "unknown";
+	}
+
+	// 就地
+	void OffsetNonZero(std::span<char> buffer, std::int8_t delta) noexcept
+	{
+		ActiveKernel()(buffer.data(), buffer.data(), buffer.size(), delta);
+	}
+
+	// 複製
+	void OffsetNonZero(std::string_view in, std::span<char> out, std::int8_t delta) noexcept
+	{
+		ActiveKernel()(in.data(), out.data(), in.size(), delta);
+	}
+
+	// 指定實作
+	void OffsetNonZero(Isa isa, std::span<char> buffer, std::int8_t delta) noexcept
+	{
+		KernelFor(isa)(buffer.data(), buffer.data(), buffer.size(), delta);
+	}
+// 結束命名空間
+}
@@ -0,0 +1,207 @@
+// Include Guard：避免重複包含
+#ifndef ERROR_CODE_H
+// 與上方成對
+#define ERROR_CODE_H
+
+// 原始錯誤型別與資料結構（PipelineError / Config / ValidatedData / Result）
+#include "Config.h"
+// 固定寬度整數
+#include <cstdint>
+// std::expected / std::unexpected
+#include <expected>
+// std::numeric_limits
+#include <limits>
+// std::string_view
+#include <string_view>
+// std::is_trivially_copyable_v
+#include <type_traits>
+// 明細側表
+#include <vector>
+
+/*
+精簡錯誤碼（lean error）
+- ErrorCode 只有「錯誤種類 + 側表索引」8 個位元組，可平凡複製；std::expected<Result, ErrorCode> 與 Result 幾乎同大小
+- 完整明細（檔名、行內容…）只有在呼叫端提供 ErrorDetails 時才建立，熱迴圈傳 kNoDetails 即可只拿錯誤碼
+- 報告時再以 ToPipelineError 轉成完整的 PipelineError
+
+延遲格式化的錯誤描述子（ErrorDescriptor）
+- 只記錄「錯誤種類 + 訊息代碼 + 行號 + 在原文中的位移與長度」16 個位元組，失敗路徑不建立任何字串
+- 原文是呼叫端持有、在報告之前不會變動的緩衝區（例如 mmap 映射、快取內容、Config::data）；
+  讀檔錯誤的「原文」是檔名。報告時以 ErrorSource 交回原文，再由 ErrorFormat.h 的 FormatTo 直接寫出訊息
+- 大部分失敗只被重試或計數而不會印出，這些失敗完全不需要組字串
+*/
+
+// 開始命名空間
+namespace config 
+{
+	// 錯誤種類：數值與 PipelineError 的 variant 索引相同
+	enum class ErrorKind : std::uint8_t 
+	{
+		kConfigRead  = 0,
+		kConfigParse = 1,
+		kValidation  = 2,
+		kProcessing  = 3,
+	};
+
+	// 精簡錯誤碼：種類 + 明細側表索引（沒有明細時為 kNoDetail）
+	struct ErrorCode 
+	{
+		// 未記錄明細
+		static constexpr std::uint32_t kNoDetail = std::numeric_limits<std::uint32_t>::max();
+
+		// 錯誤種類
+		ErrorKind     kind;
+		// ErrorDetails 中的索引
+		std::uint32_t detail = kNoDetail;
+
+		// 是否帶有明細
+		[[nodiscard]] constexpr bool has_detail() const noexcept { return detail != kNoDetail; }
+		// 比較只看種類與索引
+		friend constexpr bool operator==(const ErrorCode&, const ErrorCode&) = default;
+	};
+
+	// 熱路徑要求：錯誤碼必須可平凡複製，且遠小於 PipelineError
+	static_assert(std::is_trivially_copyable_v<ErrorCode>);
+	static_assert(sizeof(ErrorCode) <= 8);
+
+	// 錯誤明細側表：只在需要完整錯誤時建立；非執行緒安全，每個工作執行緒各自持有
+	class ErrorDetails 
+	{
+	public:
+		// 記錄一筆明細並回傳索引
+		[[nodiscard]] std::uint32_t Record(PipelineError error) 
+		{
+			entries_.push_back(std::move(error));
+			return static_cast<std::uint32_t>(entries_.size() - 1);
+		}
+
+		// 取得明細
+		[[nodiscard]] const PipelineError& at(std::uint32_t index) const { return entries_.at(index); }
+		// 已記錄的筆數
+		[[nodiscard]] std::size_t size() const noexcept { return entries_.size(); }
+		// 清空（保留容量，供下一批次重複使用）
+		void Clear() noexcept { entries_.clear(); }
+
+	private:
+		// 明細本體
+		std::vector<PipelineError> entries_;
+	};
+
+	// 不需要明細時傳入：只回傳錯誤碼，失敗路徑完全不配置
+	inline constexpr ErrorDetails* kNoDetails = nullptr;
+
+	// 錯誤種類名稱（例如計數器標籤）
+	[[nodiscard]] constexpr std::string_view ToString(ErrorKind kind) noexcept 
+	{
+		switch (kind) 
+		{
+			case ErrorKind::kConfigRead:  return "ConfigReadError";
+			case ErrorKind::kConfigParse: return "ConfigParseError";
+			case ErrorKind::kValidation:  return "ValidationError";
+			case ErrorKind::kProcessing:  return "ProcessingError";
+		}
+		return "UnknownError";
+	}
+
+	// 由完整錯誤取得錯誤種類
+	[[nodiscard]] inline ErrorKind KindOf(const PipelineError& error) noexcept 
+	{
+		return static_cast<ErrorKind>(error.index());
+	}
+
+	// 函式原型宣告：讀設定檔（失敗只回傳錯誤碼；details 非空時另記明細）
+	[[nodiscard]] std::expected<Config,        ErrorCode> LoadConfig  (const std::string& filename, ErrorDetails* details);
+	// 函式原型宣告：驗證資料（精簡錯誤碼版本）
+	[[nodiscard]] std::expected<ValidatedData, ErrorCode> ValidateData(const Config& config, ErrorDetails* details);
+	// 函式原型宣告：驗證資料（精簡錯誤碼 + 右值版本）
+	[[nodiscard]] std::expected<ValidatedData, ErrorCode> ValidateData(Config&& config, ErrorDetails* details);
+	// 函式原型宣告：處理資料（精簡錯誤碼版本）
+	[[nodiscard]] std::expected<Result,        ErrorCode> ProcessData (const ValidatedData& data, ErrorDetails* details);
+
+	// 轉成完整的 PipelineError：有明細時取用明細，否則只還原錯誤種類（欄位為空）
+	[[nodiscard]] PipelineError ToPipelineError(ErrorCode code, const ErrorDetails* details);
+
+	/*==============================延遲格式化的錯誤描述子================================*/
+
+	// 處理階段錯誤的固定文字（描述子只存代碼，報告時由代碼取回）
+	inline constexpr std::string_view kProcessingTask     = "Data Processing";
+	inline constexpr std::string_view kDataTooShortDetail = "Input data too short for task";
+
+	// 訊息代碼：決定報告時從原文取哪一段、搭配哪段固定文字
+	enum class MessageId : std::uint8_t 
+	{
+		// 讀檔失敗：原文為檔名
+		kOpenFailed,
+		// 內容不合法（空檔、含 "malformed" 或 key = value 語法錯誤）：位移指向出錯的那一行
+		kMalformedContent,
+		// 欄位違反驗證規則：位移指向整個欄位，報告時再拆出鍵與值
+		kDisallowedField,
+		// 驗證時補解析失敗：位移指向出錯的那一行
+		kMalformedField,
+		// 資料太短
+		kDataTooShort,
+	};
+
+	// 錯誤描述子：不擁有、也不指向任何記憶體，只有數字
+	struct ErrorDescriptor 
+	{
+		// 錯誤種類（與 PipelineError 的 variant 索引相同）
+		ErrorKind     kind;
+		// 訊息代碼
+		MessageId     message;
+		// 行號（以 1 起算；沒有行號時為 0）
+		std::uint32_t line   = 0;
+		// 在原文中的位移與長度
+		std::uint32_t offset = 0;
+		std::uint32_t length = 0;
+
+		friend constexpr bool operator==(const ErrorDescriptor&, const ErrorDescriptor&) = default;
+	};
+
+	// 熱路徑要求：與 ErrorCode 相同，可平凡複製且不超過兩個指標大小
+	static_assert(std::is_trivially_copyable_v<ErrorDescriptor>);
+	static_assert(sizeof(ErrorDescriptor) <= 16);
+
+	// 報告時交回的原文
+	struct ErrorSource 
+	{
+		// 讀檔錯誤的原文
+		std::string_view filename;
+		// 其他錯誤的原文：產生描述子時檢查的那塊緩衝區
+		std::string_view content;
+	};
+
+	// 錯誤的文字檢視：各欄位指向原文或靜態字面值，不配置
+	struct ErrorView 
+	{
+		// 錯誤種類
+		ErrorKind        kind;
+		// 讀檔：檔名；解析：該行內容；驗證：欄位名稱；處理：任務名稱
+		std::string_view subject{};
+		// 驗證：不合法的值；處理：錯誤細節；其他為空
+		std::string_view detail{};
+		// 解析錯誤的行號
+		int              line = 0;
+	};
+
+	// 選擇描述子版本的標籤
+	struct Describe {};
+	inline constexpr Describe kDescribe{};
+
+	// 函式原型宣告：檢查呼叫端持有的內容（失敗只回傳描述子，位移相對於 content）
+	[[nodiscard]] std::expected<Config,        ErrorDescriptor> LoadConfigFromBuffer(const std::string& filename, std::string_view content, Describe);
+	// 函式原型宣告：驗證資料（描述子版本，位移相對於 config.data）
+	[[nodiscard]] std::expected<ValidatedData, ErrorDescriptor> ValidateData(const Config& config, Describe);
+	// 函式原型宣告：驗證 mmap 內容（描述子版本，位移相對於映射內容）
+	[[nodiscard]] std::expected<ValidatedData, ErrorDescriptor> ValidateData(const MappedConfig& config, Describe);
+	// 函式原型宣告：處理資料（描述子版本）
+	[[nodiscard]] std::expected<Result,        ErrorDescriptor> ProcessData (const ValidatedData& data, Describe);
+
+	// 以原文還原文字檢視（不配置）；source 必須是產生描述子時的那一份
+	[[nodiscard]] ErrorView Resolve(const ErrorDescriptor& error, const ErrorSource& source) noexcept;
+	// 轉成完整的 PipelineError（這時才複製字串）
+	[[nodiscard]] PipelineError ToPipelineError(const ErrorDescriptor& error, const ErrorSource& source);
+// 結束命名空間
+}
+
+#endif
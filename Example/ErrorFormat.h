@@ -0,0 +1,188 @@
+// Include Guard：避免重複包含
+#ifndef ERROR_FORMAT_H
+// 與上方成對
+#define ERROR_FORMAT_H
+
+// ErrorDescriptor / ErrorSource / ErrorView / Resolve
+#include "ErrorCode.h"
+// Traced / ContextFrame
+#include "ErrorContext.h"
+// 單一 switch 分派 PipelineError
+#include "VariantMerge.h"
+// std::copy
+#include <algorithm>
+// std::to_chars
+#include <charconv>
+// std::integral
+#include <concepts>
+// std::string_view
+#include <string_view>
+// 有 <format> 時才提供 std::formatter 特化
+#if __has_include(<format>)
+#include <format>
+#endif
+
+/*
+錯誤訊息的格式化：只在真的要報告時才寫出文字
+- FormatTo(out, error) 把訊息逐段寫到輸出迭代器（std::back_insert_iterator、std::ostreambuf_iterator、
+  std::format 的 ctx.out()…），不先組出中間的 std::string
+- 完整錯誤（PipelineError 與各成員）與描述子（ErrorDescriptor + 原文）先轉成同一種 ErrorView，
+  再由同一份程式寫出，兩者的訊息逐字相同
+- Traced<E> 在訊息之後由內而外列出每一層來源脈絡：" [stage 1, file 7, offset 0]"
+- 標準函式庫提供 <format> 時，PipelineError 與每個成員都有 std::formatter 特化：std::format("{}", error)
+*/
+
+// 開始命名空間
+namespace config
+{
+	// 各錯誤的文字檢視（不配置；檢視指向錯誤本身的字串）
+	[[nodiscard]] inline ErrorView ViewOf(const ConfigReadError& e) noexcept
+	{
+		return {ErrorKind::kConfigRead, e.filename};
+	}
+	[[nodiscard]] inline ErrorView ViewOf(const ConfigParseError& e) noexcept
+	{
+		return {ErrorKind::kConfigParse, e.line_content, {}, e.line_number};
+	}
+	[[nodiscard]] inline ErrorView ViewOf(const ValidationError& e) noexcept
+	{
+		return {ErrorKind::kValidation, e.field_name, e.invalid_value};
+	}
+	[[nodiscard]] inline ErrorView ViewOf(const ProcessingError& e) noexcept
+	{
+		return {ErrorKind::kProcessing, e.task_name, e.details};
+	}
+	[[nodiscard]] inline ErrorView ViewOf(const PipelineError& e)
+	{
+		return meta::Dispatch(e, [](const auto& alternative) { return ViewOf(alternative); });
+	}
+
+	// 實作細節
+	namespace detail
+	{
+		// 寫出一段文字
+		template<typename Out>
+		Out Write(Out out, std::string_view text)
+		{
+			return std::copy(text.begin(), text.end(), out);
+		}
+
+		// 寫出十進位整數（不經過 locale 與 std::to_string）
+		template<typename Out, std::integral Int>
+		Out Write(Out out, Int value)
+		{
+			char digits[24];
+			const auto converted = std::to_chars(digits, digits + sizeof(digits), value);
+			return std::copy(digits, converted.ptr, out);
+		}
+	}
+
+	// 寫出訊息（不含結尾換行）
+	template<typename Out>
+	Out FormatTo(Out out, const ErrorView& error)
+	{
+		using detail::Write;
+		switch (error.kind)
+		{
+			case ErrorKind::kConfigRead:
+				out = Write(out, "Configuration Read Error: Could not open file '");
+				out = Write(out, error.subject);
+				return Write(out, "'");
+			case ErrorKind::kConfigParse:
+				out = Write(out, "Configuration Parse Error: Malformed content at line ");
+				out = Write(out, error.line);
+				out = Write(out, " (Context: '");
+				out = Write(out, error.subject);
+				return Write(out, "')");
+			case ErrorKind::kValidation:
+				out = Write(out, "Data Validation Error: Field '");
+				out = Write(out, error.subject);
+				out = Write(out, "' has invalid value '");
+				out = Write(out, error.detail);
+				return Write(out, "'");
+			case ErrorKind::kProcessing:
+				break;
+		}
+		out = Write(out, "Data Processing Error: Task '");
+		out = Write(out, error.subject);
+		out = Write(out, "' failed. Details: ");
+		return Write(out, error.detail);
+	}
+
+	// 完整錯誤：PipelineError 或任一成員
+	template<typename Out, typename Error>
+		requires requires(const Error& e) { ViewOf(e); }
+	Out FormatTo(Out out, const Error& error)
+	{
+		return FormatTo(out, ViewOf(error));
+	}
+
+	// 描述子：這時才回原文取字；source 必須是產生描述子時的那一份
+	template<typename Out>
+	Out FormatTo(Out out, const ErrorDescriptor& error, const ErrorSource& source)
+	{
+		return FormatTo(out, Resolve(error, source));
+	}
+
+	// 帶有來源脈絡的錯誤：訊息之後由內而外列出每一層
+	template<typename Out, typename E, std::size_t N>
+	Out FormatTo(Out out, const Traced<E, N>& traced)
+	{
+		using detail::Write;
+		out = FormatTo(out, traced.error);
+		for (const ContextFrame& frame : traced.context)
+		{
+			out = Write(out, " [stage ");
+			out = Write(out, frame.stage);
+			out = Write(out, ", file ");
+			out = Write(out, frame.file);
+			out = Write(out, ", offset ");
+			out = Write(out, frame.offset);
+			out = Write(out, "]");
+		}
+		if (traced.context.dropped() != 0)
+		{
+			out = Write(out, " [+");
+			out = Write(out, traced.context.dropped());
+			out = Write(out, " more]");
+		}
+		return out;
+	}
+// 結束命名空間
+}
+
+#if defined(__cpp_lib_format)
+// 實作細節
+namespace config::detail
+{
+	// 各錯誤共用的 formatter：不接受格式規格，內容交給 FormatTo
+	template<typename Error>
+	struct ErrorFormatter
+	{
+		constexpr auto parse(std::format_parse_context& ctx)
+		{
+			auto it = ctx.begin();
+			if (it != ctx.end() && *it != '}')
+				throw std::format_error("config errors take no format spec");
+			return it;
+		}
+
+		template<typename Context>
+		auto format(const Error& error, Context& ctx) const
+		{
+			return config::FormatTo(ctx.out(), error);
+		}
+	};
+}
+
+// std::format("{}", error)：PipelineError、每個成員與 Traced
+template<> struct std::formatter<config::ConfigReadError>  : config::detail::ErrorFormatter<config::ConfigReadError>  {};
+template<> struct std::formatter<config::ConfigParseError> : config::detail::ErrorFormatter<config::ConfigParseError> {};
+template<> struct std::formatter<config::ValidationError>  : config::detail::ErrorFormatter<config::ValidationError>  {};
+template<> struct std::formatter<config::ProcessingError>  : config::detail::ErrorFormatter<config::ProcessingError>  {};
+template<> struct std::formatter<config::PipelineError>    : config::detail::ErrorFormatter<config::PipelineError>    {};
+template<typename E, std::size_t N>
+struct std::formatter<config::Traced<E, N>> : config::detail::ErrorFormatter<config::Traced<E, N>> {};
+#endif
+
+#endif
@@ -0,0 +1,177 @@
+// 引入對應的宣告標頭
+#include "FaultInjection.h"
+// std::min
+#include <algorithm>
+// 原子門檻
+#include <atomic>
+// std::from_chars（機率）
+#include <charconv>
+// 固定寬度整數
+#include <cstdint>
+// std::getenv
+#include <cstdlib>
+
+// 進入命名空間
+namespace fault
+{
+	// 僅供本檔使用
+	namespace
+	{
+		// 機率以 2^32 為刻度：擲出的 32 位元亂數小於門檻即命中（機率 1 的門檻為 2^32，必定命中）
+		constexpr double kScale = 4294967296.0;
+
+		// 每個階段的累積門檻：第 k 格為種類 0 ~ k 的機率總和；最後一格為 0 表示此階段不注入
+		struct Thresholds
+		{
+			std::array<std::array<std::atomic<std::uint64_t>, kKindCount>, kStageCount> cumulative{};
+		};
+
+		Thresholds& Current()
+		{
+			static Thresholds instance;
+			return instance;
+		}
+
+		// 每個執行緒各自的 xorshift64* 亂數（以執行緒本地變數的位址做種子，各執行緒不同）
+		[[nodiscard]] std::uint32_t NextRandom() noexcept
+		{
+			thread_local std::uint64_t state = reinterpret_cast<std::uintptr_t>(&state) * 0x9E3779B97F4A7C15ull | 1;
+			state ^= state >> 12;
+			state ^= state << 25;
+			state ^= state >> 27;
+			return static_cast<std::uint32_t>((state * 0x2545F4914F6CDD1Dull) >> 32);
+		}
+
+		// 去掉前後空白
+		[[nodiscard]] std::string_view Trim(std::string_view text) noexcept
+		{
+			while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+				text.remove_prefix(1);
+			while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+				text.remove_suffix(1);
+			return text;
+		}
+
+		// 名稱 → 階段 / 錯誤種類（名稱即 metrics::ToString / config::ToString 的輸出）
+		[[nodiscard]] std::optional<Stage> StageNamed(std::string_view name) noexcept
+		{
+			for (std::size_t s = 0; s < kStageCount; ++s)
+				if (metrics::ToString(static_cast<Stage>(s)) == name)
+					return static_cast<Stage>(s);
+			return std::nullopt;
+		}
+		[[nodiscard]] std::optional<config::ErrorKind> KindNamed(std::string_view name) noexcept
+		{
+			for (std::size_t k = 0; k < kKindCount; ++k)
+				if (config::ToString(static_cast<config::ErrorKind>(k)) == name)
+					return static_cast<config::ErrorKind>(k);
+			return std::nullopt;
+		}
+	}
+
+	// 各種類相加
+	double Plan::Total(Stage stage) const noexcept
+	{
+		double total = 0;
+		for (const double p : probability[static_cast<std::size_t>(stage)])
+			total += p;
+		return total;
+	}
+
+	// 逐項解析："Stage.Kind=機率"
+	std::expected<Plan, PlanError> ParsePlan(std::string_view spec)
+	{
+		Plan plan;
+		std::size_t pos = 0;
+		while (pos <= spec.size())
+		{
+			const std::size_t comma = std::min(spec.find(',', pos), spec.size());
+			const std::string_view item = Trim(spec.substr(pos, comma - pos));
+			const std::size_t at = pos;
+			pos = comma + 1;
+			if (item.empty())
+				continue;
+
+			const std::size_t dot   = item.find('.');
+			const std::size_t equal = item.find('=');
+			if (dot == std::string_view::npos || equal == std::string_view::npos || dot > equal)
+				return std::unexpected(PlanError{at, "expected Stage.Kind=probability"});
+			const auto stage = StageNamed(Trim(item.substr(0, dot)));
+			if (!stage)
+				return std::unexpected(PlanError{at, "unknown stage"});
+			const auto kind = KindNamed(Trim(item.substr(dot + 1, equal - dot - 1)));
+			if (!kind)
+				return std::unexpected(PlanError{at, "unknown error kind"});
+
+			const std::string_view number = Trim(item.substr(equal + 1));
+			double p = 0;
+			const auto [end, ec] = std::from_chars(number.data(), number.data() + number.size(), p);
+			if (ec != std::errc{} || end != number.data() + number.size() || !(p >= 0 && p <= 1))
+				return std::unexpected(PlanError{at, "probability must be between 0 and 1"});
+			plan.Set(*stage, *kind, p);
+			if (plan.Total(*stage) > 1)
+				return std::unexpected(PlanError{at, "probabilities of a stage exceed 1"});
+		}
+		return plan;
+	}
+
+	// 換算成累積門檻後逐格寫入
+	void Configure(const Plan& plan) noexcept
+	{
+		auto& current = Current();
+		for (std::size_t s = 0; s < kStageCount; ++s)
+		{
+			double sum = 0;
+			for (std::size_t k = 0; k < kKindCount; ++k)
+			{
+				sum = std::min(sum + plan.probability[s][k], 1.0);
+				current.cumulative[s][k].store(static_cast<std::uint64_t>(sum * kScale), std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void Clear() noexcept
+	{
+		Configure(Plan{});
+	}
+
+	// 環境變數
+	std::expected<Plan, PlanError> ConfigureFromEnvironment()
+	{
+		const char* spec = std::getenv(kPlanVariable);
+		if (spec == nullptr)
+			return Plan{};
+		auto plan = ParsePlan(spec);
+		if (plan)
+			Configure(*plan);
+		return plan;
+	}
+
+	// 熱路徑：總門檻為 0 時只多一次載入
+	std::optional<config::ErrorKind> Roll(Stage stage) noexcept
+	{
+		const auto& cumulative = Current().cumulative[static_cast<std::size_t>(stage)];
+		if (cumulative[kKindCount - 1].load(std::memory_order_relaxed) == 0)
+			return std::nullopt;
+		const std::uint64_t roll = NextRandom();
+		for (std::size_t k = 0; k < kKindCount; ++k)
+			if (roll < cumulative[k].load(std::memory_order_relaxed))
+				return static_cast<config::ErrorKind>(k);
+		return std::nullopt;
+	}
+
+	// 與真正的錯誤同型別，內容固定為 kInjectedDetail
+	config::PipelineError MakeError(config::ErrorKind kind)
+	{
+		const std::string detail(kInjectedDetail);
+		switch (kind)
+		{
+			case config::ErrorKind::kConfigRead:  return config::ConfigReadError{detail};
+			case config::ErrorKind::kConfigParse: return config::ConfigParseError{detail, 0};
+			case config::ErrorKind::kValidation:  return config::ValidationError{"", detail};
+			case config::ErrorKind::kProcessing:  return config::ProcessingError{std::string(config::kProcessingTask), detail};
+		}
+		return config::ProcessingError{std::string(config::kProcessingTask), detail};
+	}
+// 結束命名空間
+}
@@ -0,0 +1,250 @@
+// 引入對應的宣告標頭
+#include "FileCache.h"
+// errno：區分「不存在」與其他失敗
+#include <cerrno>
+// std::next / std::prev
+#include <iterator>
+// std::move
+#include <utility>
+// POSIX：open
+#include <fcntl.h>
+// POSIX：stat / fstat
+#include <sys/stat.h>
+// POSIX：read / close
+#include <unistd.h>
+
+// 進入命名空間
+namespace filecache
+{
+	// 僅供本檔使用的 POSIX 工具
+	namespace
+	{
+		// 以奈秒表示的 mtime：秒級精度不足以分辨同一秒內的改寫
+		[[nodiscard]] std::int64_t MtimeOf(const struct stat& st) noexcept
+		{
+			return static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+		}
+
+		// 這些 errno 代表路徑不存在，可作為負面結果快取
+		[[nodiscard]] bool IsNotFound(int error) noexcept
+		{
+			return error == ENOENT || error == ENOTDIR;
+		}
+
+		// 開檔 / stat 失敗的 errno → 失敗原因
+		[[nodiscard]] Failure FailureFrom(int error) noexcept
+		{
+			if (IsNotFound(error))
+				return Failure::kNotFound;
+			if (error == EACCES || error == EPERM)
+				return Failure::kPermissionDenied;
+			if (error == EMFILE || error == ENFILE)
+				return Failure::kTooManyOpenFiles;
+			return Failure::kOpenFailed;
+		}
+
+		// 讀檔結果：內容與開檔後 fstat 取得的鍵（避免 stat 與 open 之間檔案被替換）
+		struct Loaded
+		{
+			std::string  data;
+			std::int64_t mtime_ns = 0;
+			std::size_t  size     = 0;
+		};
+
+		// 單次 open + fstat + read：依 fstat 的大小一次配置，讀到 EOF 為止
+		[[nodiscard]] std::expected<Loaded, Failure> ReadFile(const std::string& path)
+		{
+			const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0)
+				return std::unexpected(FailureFrom(errno));
+
+			struct stat st{};
+			if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+			{
+				::close(fd);
+				return std::unexpected(Failure::kOpenFailed);
+			}
+
+			Loaded loaded{std::string(static_cast<std::size_t>(st.st_size), '\0'), MtimeOf(st), static_cast<std::size_t>(st.st_size)};
+			std::size_t filled = 0;
+			for (;;)
+			{
+				// 檔案在 fstat 之後變大：擴充緩衝繼續讀
+				if (filled == loaded.data.size())
+					loaded.data.resize(loaded.data.size() + 4096);
+				const ::ssize_t got = ::read(fd, loaded.data.data() + filled, loaded.data.size() - filled);
+				if (got < 0 && errno == EINTR)
+					continue;
+				if (got < 0)
+				{
+					::close(fd);
+					return std::unexpected(Failure::kReadFailed);
+				}
+				if (got == 0)
+					break;
+				filled += static_cast<std::size_t>(got);
+			}
+			::close(fd);
+			loaded.data.resize(filled);
+			return loaded;
+		}
+	}
+
+	// 建構：只保存設定，不預先配置
+	FileCache::FileCache(const scanner::MultiPatternScanner& scanner, Options options)
+		: scanner_(scanner), options_(options)
+	{
+	}
+
+	// 查詢：負面結果 → stat → 比對鍵 → 必要時讀檔
+	std::expected<EntryPtr, Failure> FileCache::Get(const std::string& path)
+	{
+		const auto now = std::chrono::steady_clock::now();
+		{
+			// 有效期限內的負面結果：連 stat 都不做
+			std::lock_guard lock(mutex_);
+			if (const auto it = index_.find(path); it != index_.end() && !it->second->entry && now < it->second->expires)
+			{
+				++stats_.negative_hits;
+				return std::unexpected(Failure::kNotFound);
+			}
+		}
+
+		// 唯一一次系統呼叫（命中時）
+		struct stat st{};
+		if (::stat(path.c_str(), &st) != 0)
+		{
+			if (const int error = errno; !IsNotFound(error))
+				return std::unexpected(FailureFrom(error));
+			std::lock_guard lock(mutex_);
+			if (options_.negative_ttl.count() > 0)
+			{
+				// 負面結果同樣佔用項目數：大量不同的缺檔路徑不會讓快取無限成長
+				Store(Node{path, nullptr, 0, 0, now + options_.negative_ttl});
+				Trim(now);
+			}
+			else if (const auto it = index_.find(path); it != index_.end())
+				Erase(it->second);
+			return std::unexpected(Failure::kNotFound);
+		}
+
+		{
+			// 鍵相符：移到 LRU 前端後直接回傳
+			std::lock_guard lock(mutex_);
+			if (const auto it = index_.find(path); it != index_.end())
+			{
+				const Node& node = *it->second;
+				if (node.entry && node.mtime_ns == MtimeOf(st) && node.size == static_cast<std::size_t>(st.st_size))
+				{
+					lru_.splice(lru_.begin(), lru_, it->second);
+					++stats_.hits;
+					return node.entry;
+				}
+			}
+		}
+
+		// 未命中或已變更：在鎖外讀檔與掃描
+		auto loaded = ReadFile(path);
+		if (!loaded)
+		{
+			std::lock_guard lock(mutex_);
+			if (const auto it = index_.find(path); it != index_.end())
+				Erase(it->second);
+			return std::unexpected(loaded.error());
+		}
+
+		auto scan  = scanner_.Scan(loaded->data);
+		auto entry = std::make_shared<const Entry>(Entry{std::move(loaded->data), std::move(scan)});
+
+		std::lock_guard lock(mutex_);
+		++stats_.misses;
+		// 單一檔案就超過上限：照常回傳，但不佔用快取
+		if (entry->data.size() > options_.max_bytes)
+		{
+			if (const auto it = index_.find(path); it != index_.end())
+				Erase(it->second);
+			return entry;
+		}
+		Store(Node{path, entry, loaded->mtime_ns, loaded->size, {}});
+		Trim(now);
+		return entry;
+	}
+
+	// 移除單一路徑
+	void FileCache::Invalidate(const std::string& path)
+	{
+		std::lock_guard lock(mutex_);
+		if (const auto it = index_.find(path); it != index_.end())
+			Erase(it->second);
+	}
+
+	// 清空
+	void FileCache::Clear()
+	{
+		std::lock_guard lock(mutex_);
+		lru_.clear();
+		index_.clear();
+		bytes_ = 0;
+	}
+
+	// 統計數字（複製一份）
+	Stats FileCache::stats() const
+	{
+		std::lock_guard lock(mutex_);
+		return stats_;
+	}
+
+	// 內容總位元組數
+	std::size_t FileCache::bytes() const
+	{
+		std::lock_guard lock(mutex_);
+		return bytes_;
+	}
+
+	// 項目數
+	std::size_t FileCache::size() const
+	{
+		std::lock_guard lock(mutex_);
+		return lru_.size();
+	}
+
+	// 加入或取代：舊項目先移除，新項目放在前端
+	void FileCache::Store(Node node)
+	{
+		if (const auto it = index_.find(node.path); it != index_.end())
+			Erase(it->second);
+		bytes_ += node.entry ? node.entry->data.size() : 0;
+		lru_.push_front(std::move(node));
+		index_.emplace(lru_.front().path, lru_.begin());
+	}
+
+	// 移除節點並扣除位元組數
+	void FileCache::Erase(List::iterator it)
+	{
+		bytes_ -= it->entry ? it->entry->data.size() : 0;
+		index_.erase(it->path);
+		lru_.erase(it);
+	}
+
+	// 已過期的負面結果不論位置先逐出（不再有用）；仍超過時從尾端（最久未用）開始逐出，前端剛放入的項目保留
+	void FileCache::Trim(std::chrono::steady_clock::time_point now)
+	{
+		const auto over = [this] { return bytes_ > options_.max_bytes || lru_.size() > options_.max_entries; };
+		for (auto it = lru_.begin(); it != lru_.end() && over();)
+		{
+			const auto next = std::next(it);
+			if (!it->entry && it != lru_.begin() && it->expires <= now)
+			{
+				Erase(it);
+				++stats_.evictions;
+			}
+			it = next;
+		}
+		while (lru_.size() > 1 && over())
+		{
+			Erase(std::prev(lru_.end()));
+			++stats_.evictions;
+		}
+	}
+// 結束命名空間
+}
@@ -0,0 +1,146 @@
+// Include Guard：避免重複包含
+#ifndef FILE_CACHE_H
+// 與上方成對
+#define FILE_CACHE_H
+
+// 單次掃描結果隨內容一起快取
+#include "Scanner.h"
+// 負面結果的有效期限
+#include <chrono>
+// 固定寬度整數（mtime 奈秒）
+#include <cstdint>
+// std::expected：查詢結果
+#include <expected>
+// LRU 串列
+#include <list>
+// std::shared_ptr：交給呼叫端的唯讀緩衝
+#include <memory>
+// 保護索引與 LRU 串列
+#include <mutex>
+// std::string：路徑與內容
+#include <string>
+// 路徑 → LRU 節點
+#include <unordered_map>
+
+/*
+檔案內容快取
+- 以 (路徑, mtime, 大小) 為鍵：每次查詢只做一次 stat，未變更即直接回傳快取，不再開檔、讀檔
+- 內容與讀入當下的單次哨兵掃描結果一起保存為不可變的 Entry，以 shared_ptr 共用；被逐出後仍持有者不受影響
+- 以位元組數與項目數設定上限（負面結果計入項目數），超過時先逐出已過期的負面結果，再依 LRU 逐出
+- 「檔案不存在」也會快取 negative_ttl 這麼久，期間內不再 stat，避免缺檔造成大量系統呼叫
+- 執行緒安全；讀檔在鎖外進行，同一檔案同時未命中時可能重複讀取，結果以最後寫入者為準
+*/
+
+// 開始命名空間
+namespace filecache
+{
+	// 快取上限與負面結果有效期限
+	struct Options
+	{
+		// 所有內容的位元組上限
+		std::size_t               max_bytes    = 64u << 20;
+		// 項目數上限（含負面結果）
+		std::size_t               max_entries  = 1024;
+		// 「檔案不存在」的快取時間；0 表示不快取負面結果
+		std::chrono::milliseconds negative_ttl{1000};
+	};
+
+	// 快取的內容（建立後不再修改）
+	struct Entry
+	{
+		// 整份檔案內容
+		std::string         data;
+		// 建立快取時用 FileCache 的掃描器掃描一次的結果
+		scanner::ScanResult scan;
+	};
+
+	// 交給呼叫端的共享唯讀內容
+	using EntryPtr = std::shared_ptr<const Entry>;
+
+	// 查詢失敗的原因；由各管線換成自己的錯誤型別
+	enum class Failure : std::uint8_t
+	{
+		// 檔案不存在（會被快取）
+		kNotFound,
+		// 權限不足（EACCES / EPERM）
+		kPermissionDenied,
+		// 行程或系統的開檔數已用盡（EMFILE / ENFILE）
+		kTooManyOpenFiles,
+		// 其他無法開啟的情況（例如非一般檔案）
+		kOpenFailed,
+		// 讀取過程失敗
+		kReadFailed,
+	};
+
+	// 統計數字（測試與監控用）
+	struct Stats
+	{
+		// stat 結果與快取相符，直接回傳
+		std::size_t hits          = 0;
+		// 需要讀檔（首次或內容已變更）
+		std::size_t misses        = 0;
+		// 在有效期限內命中的負面結果（未做 stat）
+		std::size_t negative_hits = 0;
+		// 因超過上限而逐出的項目
+		std::size_t evictions     = 0;
+	};
+
+	// 檔案內容快取：同一個快取只搭配一個掃描器（例如 config::SentinelScanner()）
+	class FileCache
+	{
+	public:
+		// scanner 必須比快取活得久（通常是函式內 static 的單例）
+		explicit FileCache(const scanner::MultiPatternScanner& scanner, Options options = {});
+
+		// 不可複製：內部持有互斥鎖與索引
+		FileCache(const FileCache&)            = delete;
+		FileCache& operator=(const FileCache&) = delete;
+
+		// 取得檔案內容：未變更時不開檔；已變更或不在快取中則重新讀取並掃描
+		[[nodiscard]] std::expected<EntryPtr, Failure> Get(const std::string& path);
+		// 移除指定路徑（含負面結果），下次查詢必定重新讀取
+		void Invalidate(const std::string& path);
+		// 清空所有項目
+		void Clear();
+
+		// 統計數字
+		[[nodiscard]] Stats stats() const;
+		// 目前快取內容的總位元組數
+		[[nodiscard]] std::size_t bytes() const;
+		// 目前項目數（含負面結果）
+		[[nodiscard]] std::size_t size() const;
+
+	private:
+		// 快取項目：正面結果有 entry；負面結果 entry 為空，只看 expires
+		struct Node
+		{
+			std::string                           path;
+			EntryPtr                              entry;
+			// 讀入時的 mtime（奈秒）與大小
+			std::int64_t                          mtime_ns = 0;
+			std::size_t                           size     = 0;
+			// 負面結果的到期時間
+			std::chrono::steady_clock::time_point expires{};
+		};
+		using List = std::list<Node>;
+
+		// 加入或取代 path 的項目，並移到 LRU 前端；呼叫時需持有鎖
+		void Store(Node node);
+		// 移除指定節點；呼叫時需持有鎖
+		void Erase(List::iterator it);
+		// 逐出項目直到符合上限：先移除 now 時已過期的負面結果，再從最久未用的開始；呼叫時需持有鎖
+		void Trim(std::chrono::steady_clock::time_point now);
+
+		const scanner::MultiPatternScanner&              scanner_;
+		Options                                          options_;
+		mutable std::mutex                               mutex_;
+		// 前端為最近使用
+		List                                             lru_;
+		std::unordered_map<std::string, List::iterator>  index_;
+		std::size_t                                      bytes_ = 0;
+		Stats                                            stats_{};
+	};
+// 結束命名空間
+}
+
+#endif
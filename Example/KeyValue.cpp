@@ -0,0 +1,168 @@
+// 引入對應的宣告標頭
+#include "KeyValue.h"
+// std::sort / std::lower_bound / std::any_of
+#include <algorithm>
+// std::numeric_limits
+#include <limits>
+
+// 進入命名空間
+namespace kv
+{
+	// 僅供本檔使用的工具
+	namespace
+	{
+		// 欄位前後要去除的空白
+		[[nodiscard]] constexpr bool IsSpace(char c) noexcept
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		// 去除前後空白
+		[[nodiscard]] std::string_view Trim(std::string_view s) noexcept
+		{
+			while (!s.empty() && IsSpace(s.front()))
+				s.remove_prefix(1);
+			while (!s.empty() && IsSpace(s.back()))
+				s.remove_suffix(1);
+			return s;
+		}
+	}
+
+	// 二分搜尋
+	std::optional<std::string_view> Table::Find(std::string_view key) const noexcept
+	{
+		const auto it = std::lower_bound(entries_.begin(), entries_.end(), key,
+		                                 [&](const Entry& e, std::string_view k) { return KeyOf(e) < k; });
+		if (it == entries_.end() || KeyOf(*it) != key)
+			return std::nullopt;
+		return FieldOf(*it).value;
+	}
+
+	// 以第一個 '=' 分隔，鍵與值各自去除空白
+	Field SplitField(std::string_view raw) noexcept
+	{
+		const std::size_t eq = raw.find('=');
+		Field field;
+		field.key   = Trim(raw.substr(0, eq));
+		field.value = eq == std::string_view::npos ? std::string_view{} : Trim(raw.substr(eq + 1));
+		return field;
+	}
+
+	// 單次掃過原文：逐欄位複製到字串池，最後排序並去除重複的鍵
+	std::expected<void, SyntaxError> Table::Build(Table& table, std::string_view content, std::vector<SyntaxError>* errors)
+	{
+		// 位移以 32 位元保存：字串池不會超過原文大小
+		if (content.size() > std::numeric_limits<std::uint32_t>::max())
+			return std::unexpected(SyntaxError{0, "config too large"});
+
+		table.clear();
+		table.parsed_ = true;
+		table.pool_.reserve(content.size());
+
+		std::uint32_t line = 1;
+		std::size_t   pos  = 0;
+		// 下一個換行與下一個 ';'：各自以 memchr 尋找並沿用到越過為止
+		// （find_first_of 對每個位元組逐一比對集合，比兩次 memchr 慢數倍）
+		std::size_t next_newline   = std::min(content.find('\n'), content.size());
+		std::size_t next_semicolon = std::min(content.find(';'), content.size());
+		while (pos < content.size())
+		{
+			// 欄位結尾：換行或 ';'
+			if (next_newline < pos)
+				next_newline = std::min(content.find('\n', pos), content.size());
+			if (next_semicolon < pos)
+				next_semicolon = std::min(content.find(';', pos), content.size());
+			const std::size_t stop = std::min(next_newline, next_semicolon);
+			const std::string_view raw = Trim(content.substr(pos, stop - pos));
+			const std::size_t start = pos;
+			const std::uint32_t field_line = line;
+
+			// 註解：略過到行尾（註解內的 ';' 不分隔欄位）
+			if (!raw.empty() && raw.front() == '#')
+			{
+				pos = next_newline + 1;
+				++line;
+				continue;
+			}
+			pos = stop + 1;
+			if (stop < content.size() && content[stop] == '\n')
+				++line;
+			if (raw.empty())
+				continue;
+
+			const Field split = SplitField(raw);
+			const std::string_view key   = split.key;
+			const std::string_view value = split.value;
+			std::string_view reason;
+			if (key.empty())
+				reason = "empty key";
+			else if (std::any_of(key.begin(), key.end(), [](char c) { return IsSpace(c); }))
+				reason = "whitespace in key";
+			if (!reason.empty())
+			{
+				if (errors == nullptr)
+					return std::unexpected(SyntaxError{start, reason});
+				// 收集模式：記下錯誤、略過這個欄位
+				errors->push_back({start, reason});
+				continue;
+			}
+
+			Table::Entry entry{};
+			entry.key_offset    = static_cast<std::uint32_t>(table.pool_.size());
+			entry.key_size      = static_cast<std::uint32_t>(key.size());
+			table.pool_.append(key);
+			entry.value_offset  = static_cast<std::uint32_t>(table.pool_.size());
+			entry.value_size    = static_cast<std::uint32_t>(value.size());
+			table.pool_.append(value);
+			entry.line          = field_line;
+			entry.source_offset = static_cast<std::uint32_t>(raw.data() - content.data());
+			entry.source_size   = static_cast<std::uint32_t>(raw.size());
+			table.entries_.push_back(entry);
+		}
+
+		// 依鍵排序，同鍵依出現位置（等同穩定排序，但 std::sort 不需要暫存緩衝區），同鍵只保留最後一次
+		auto& entries = table.entries_;
+		std::sort(entries.begin(), entries.end(), [&](const Table::Entry& a, const Table::Entry& b) {
+			const int order = table.KeyOf(a).compare(table.KeyOf(b));
+			return order != 0 ? order < 0 : a.source_offset < b.source_offset;
+		});
+		std::size_t kept = 0;
+		for (std::size_t i = 0; i < entries.size(); ++i)
+		{
+			if (i + 1 < entries.size() && table.KeyOf(entries[i]) == table.KeyOf(entries[i + 1]))
+				continue;
+			entries[kept++] = entries[i];
+		}
+		entries.resize(kept);
+		return {};
+	}
+
+	// 在第一個語法錯誤停下
+	std::expected<Table, SyntaxError> Parse(std::string_view content)
+	{
+		Table table;
+		if (auto built = Table::Build(table, content, nullptr); !built)
+			return std::unexpected(built.error());
+		return table;
+	}
+
+	// 略過語法錯誤的欄位；只有原文過大時整份放棄
+	Table Parse(std::string_view content, std::vector<SyntaxError>& errors)
+	{
+		Table table;
+		if (auto built = Table::Build(table, content, &errors); !built)
+		{
+			errors.push_back(built.error());
+			table.clear();
+			table.parsed_ = true;
+		}
+		return table;
+	}
+
+	// 沿用 table 的容量
+	std::expected<void, SyntaxError> ParseInto(std::string_view content, Table& table)
+	{
+		return Table::Build(table, content, nullptr);
+	}
+// 結束命名空間
+}
@@ -0,0 +1,184 @@
+// 引入對應的宣告標頭
+#include "LoadGenerator.h"
+// std::max
+#include <algorithm>
+// 欄寬
+#include <iomanip>
+// 送出請求的執行緒
+#include <thread>
+
+// 進入命名空間
+namespace load
+{
+	// 僅供本檔使用
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		// 提早醒來的餘裕：sleep_until 常晚醒數十微秒，剩下的時間改為讓出 CPU 等待
+		constexpr auto kSpinWindow = std::chrono::microseconds(50);
+
+		// 一個執行緒的結果（只由該執行緒寫入，結束後才合併）
+		struct alignas(64) Local
+		{
+			std::uint64_t      requests = 0;
+			std::uint64_t      failures = 0;
+			Clock::time_point  last_end{};
+			metrics::Histogram success_latency;
+			metrics::Histogram failure_latency;
+		};
+
+		// 記錄一筆延遲
+		void Record(metrics::Histogram& histogram, std::uint64_t nanoseconds) noexcept
+		{
+			++histogram.buckets[metrics::BucketOf(nanoseconds)];
+			++histogram.count;
+			histogram.sum_ns += nanoseconds;
+		}
+
+		// 合併直方圖
+		void Merge(metrics::Histogram& into, const metrics::Histogram& from) noexcept
+		{
+			for (std::size_t b = 0; b < metrics::kBucketCount; ++b)
+				into.buckets[b] += from.buckets[b];
+			into.count  += from.count;
+			into.sum_ns += from.sum_ns;
+		}
+
+		// 等到 when：遠的先睡，最後一段讓出 CPU
+		void WaitUntil(Clock::time_point when)
+		{
+			if (when - Clock::now() > kSpinWindow)
+				std::this_thread::sleep_until(when - kSpinWindow);
+			while (Clock::now() < when)
+				std::this_thread::yield();
+		}
+
+		// 一個執行緒的迴圈：從 first 起每 interval 排定一個請求，延遲自排定時間起算
+		void Drive(const Operation& operation, std::size_t thread, Clock::time_point first, Clock::time_point stop,
+		           Clock::duration interval, Local& local)
+		{
+			const bool paced = interval > Clock::duration::zero();
+			Clock::time_point scheduled = first;
+			while (scheduled < stop)
+			{
+				if (paced)
+					WaitUntil(scheduled);
+				else
+					scheduled = Clock::now();
+				const bool ok = operation(thread);
+				const auto end = Clock::now();
+				const auto latency = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - scheduled).count());
+				++local.requests;
+				if (ok)
+					Record(local.success_latency, latency);
+				else
+				{
+					++local.failures;
+					Record(local.failure_latency, latency);
+				}
+				local.last_end = end;
+				if (paced)
+					scheduled += interval;
+				else if (end >= stop)
+					break;
+			}
+		}
+	}
+
+	double Report::throughput() const noexcept
+	{
+		const double seconds = std::chrono::duration<double>(elapsed).count();
+		return seconds > 0 ? static_cast<double>(requests) / seconds : 0;
+	}
+
+	double Report::error_ratio() const noexcept
+	{
+		return requests > 0 ? static_cast<double>(failures) / static_cast<double>(requests) : 0;
+	}
+
+	// 全部執行緒同時開始；每個執行緒的間隔為 threads / rate
+	Report Run(const Options& options, const Operation& operation)
+	{
+		const std::size_t threads = std::max<std::size_t>(1, options.threads);
+		const auto interval = options.rate > 0
+			? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(static_cast<double>(threads) / options.rate))
+			: Clock::duration::zero();
+		// 起點稍微延後，讓所有執行緒都已建立
+		const auto start = Clock::now() + std::chrono::milliseconds(1);
+		const auto stop  = start + options.duration;
+
+		std::vector<Local> local(threads);
+		{
+			std::vector<std::jthread> workers;
+			workers.reserve(threads);
+			for (std::size_t t = 0; t < threads; ++t)
+			{
+				// 各執行緒錯開起點，合計的請求間隔平均
+				const auto first = start + interval * static_cast<Clock::rep>(t) / static_cast<Clock::rep>(threads);
+				workers.emplace_back([&, t, first] { Drive(operation, t, first, stop, interval, local[t]); });
+			}
+		}
+
+		Report report;
+		auto last_end = start;
+		for (const auto& l : local)
+		{
+			report.requests += l.requests;
+			report.failures += l.failures;
+			Merge(report.success_latency, l.success_latency);
+			Merge(report.failure_latency, l.failure_latency);
+			last_end = std::max(last_end, l.last_end);
+		}
+		Merge(report.latency, report.success_latency);
+		Merge(report.latency, report.failure_latency);
+		report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(last_end - start);
+		return report;
+	}
+
+	// 管線結果只看成功與否
+	Report RunPipeline(const Options& options, const std::string& path)
+	{
+		constexpr fault::FaultyConfigPipeline pipeline{};
+		return Run(options, [&](std::size_t) { return pipeline(path).has_value(); });
+	}
+
+	// 每個比例之間停止注入，避免上一輪的設定影響下一輪的暖機
+	std::vector<Report> SweepErrorRatios(const Options& options, const std::string& path,
+	                                     fault::Stage stage, config::ErrorKind kind, std::span<const double> ratios)
+	{
+		std::vector<Report> reports;
+		reports.reserve(ratios.size());
+		for (const double ratio : ratios)
+		{
+			fault::Configure(fault::Plan{}.Set(stage, kind, ratio));
+			reports.push_back(RunPipeline(options, path));
+			fault::Clear();
+		}
+		return reports;
+	}
+
+	// 延遲換算成微秒
+	void WriteReports(std::ostream& out, std::span<const Report> reports)
+	{
+		const auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+		// 結束後還原串流的格式設定
+		const auto flags     = out.flags();
+		const auto precision = out.precision();
+		out << "error_ratio  throughput/s   p50_us   p99_us  p999_us  ok_p99_us  err_p99_us\n";
+		for (const auto& r : reports)
+		{
+			out << std::fixed << std::setprecision(4) << std::setw(11) << r.error_ratio()
+			    << std::setprecision(0) << std::setw(14) << r.throughput()
+			    << std::setprecision(1)
+			    << std::setw(9)  << us(r.latency.Percentile(0.50))
+			    << std::setw(9)  << us(r.latency.Percentile(0.99))
+			    << std::setw(9)  << us(r.latency.Percentile(0.999))
+			    << std::setw(11) << us(r.success_latency.Percentile(0.99))
+			    << std::setw(12) << us(r.failure_latency.Percentile(0.99)) << '\n';
+		}
+		out.flags(flags);
+		out.precision(precision);
+	}
+// 結束命名空間
+}
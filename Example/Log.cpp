@@ -0,0 +1,200 @@
+// 引入對應的宣告標頭
+#include "Log.h"
+// std::min / std::max
+#include <algorithm>
+// std::memcpy
+#include <cstring>
+// 預設後端的 std::cout / std::cerr
+#include <iostream>
+// 批次格式化緩衝
+#include <string>
+// std::bit_ceil
+#include <bit>
+
+// 進入命名空間
+namespace logging 
+{
+	// 僅供本檔使用
+	namespace 
+	{
+		// 格式化一行："TAG: message arg\n"
+		void AppendLine(std::string& out, Level level, std::string_view message, std::string_view arg) 
+		{
+			out.append(ToString(level)).append(": ").append(message).append(arg).push_back('\n');
+		}
+
+		// 目前的後端（nullptr 表示預設）
+		std::atomic<Sink*> g_sink{nullptr};
+
+		// 預設後端
+		Sink& DefaultSink() 
+		{
+			static StreamSink instance(std::cout, std::cerr);
+			return instance;
+		}
+	}
+
+	// 等級標籤
+	std::string_view ToString(Level level) noexcept 
+	{
+		switch (level) 
+		{
+			case Level::kDebug: return "DEBUG";
+			case Level::kInfo:  return "INFO";
+			case Level::kWarn:  return "WARN";
+			case Level::kError: return "ERROR";
+			case Level::kOff:   break;
+		}
+		return "OFF";
+	}
+
+	// 替換目前的後端
+	void SetSink(Sink* sink) noexcept 
+	{
+		g_sink.store(sink, std::memory_order_release);
+	}
+
+	// 目前的後端
+	Sink& CurrentSink() noexcept 
+	{
+		Sink* sink = g_sink.load(std::memory_order_acquire);
+		return sink != nullptr ? *sink : DefaultSink();
+	}
+
+	// 同步輸出：先組好整行再一次寫出，避免多執行緒時行內交錯
+	// 每個執行緒重用同一個行緩衝區（保留容量）：穩定狀態下寫出一行不配置記憶體
+	void StreamSink::Write(Level level, std::string_view message, std::string_view arg) 
+	{
+		thread_local std::string line;
+		line.clear();
+		AppendLine(line, level, message, arg);
+		std::ostream& os = level >= Level::kWarn ? err_ : out_;
+		os.write(line.data(), static_cast<std::streamsize>(line.size()));
+	}
+
+	// 建立環形緩衝區與背景執行緒
+	AsyncRingSink::AsyncRingSink(std::ostream& target, std::size_t capacity)
+		: target_(target),
+		  slots_(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+		  mask_(slots_.size() - 1) 
+	{
+		// 槽位序號初始化為其索引（Vyukov 有界佇列）
+		for (std::size_t i = 0; i < slots_.size(); ++i) 
+			slots_[i].sequence.store(i, std::memory_order_relaxed);
+		worker_ = std::thread([this] { Consume(); });
+	}
+
+	// 結束背景執行緒（剩餘紀錄會先寫完）
+	AsyncRingSink::~AsyncRingSink() 
+	{
+		stop_.store(true, std::memory_order_release);
+		{
+			std::lock_guard lock(mutex_);
+			sleeping_.store(false, std::memory_order_relaxed);
+		}
+		wake_.notify_one();
+		worker_.join();
+	}
+
+	// 熱路徑：CAS 取得一個槽位後複製紀錄，不格式化、不上鎖
+	void AsyncRingSink::Write(Level level, std::string_view message, std::string_view arg) 
+	{
+		std::size_t pos = enqueue_.load(std::memory_order_relaxed);
+		Slot* slot = nullptr;
+		for (;;) 
+		{
+			slot = &slots_[pos & mask_];
+			const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+			const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+			if (diff == 0) 
+			{
+				if (enqueue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) 
+					break;
+			}
+			else if (diff < 0) 
+			{
+				// 緩衝區已滿：丟棄並計數
+				dropped_.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			else 
+			{
+				pos = enqueue_.load(std::memory_order_relaxed);
+			}
+		}
+
+		slot->level    = level;
+		slot->message  = message;
+		slot->arg_size = static_cast<std::uint16_t>(std::min(arg.size(), kArgCapacity));
+		// 空的 string_view 可能是 nullptr：長度為 0 時不呼叫 memcpy
+		if (slot->arg_size != 0) 
+			std::memcpy(slot->arg, arg.data(), slot->arg_size);
+		accepted_.fetch_add(1, std::memory_order_relaxed);
+		// 發布：序號 + 1 代表此槽位可被消費
+		slot->sequence.store(pos + 1, std::memory_order_release);
+
+		// 與 Consume 的屏障配對：不是背景執行緒看到這筆紀錄，就是這裡看到它已宣告休眠；只有後者才上鎖喚醒
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (sleeping_.load(std::memory_order_relaxed)) 
+		{
+			{
+				std::lock_guard lock(mutex_);
+				sleeping_.store(false, std::memory_order_relaxed);
+			}
+			wake_.notify_one();
+		}
+	}
+
+	// 背景執行緒：一次取出所有可用紀錄，格式化成一塊後寫出
+	void AsyncRingSink::Consume() 
+	{
+		std::string batch;
+		for (;;) 
+		{
+			batch.clear();
+			std::uint64_t taken = 0;
+			for (;;) 
+			{
+				Slot& slot = slots_[dequeue_ & mask_];
+				if (slot.sequence.load(std::memory_order_acquire) != dequeue_ + 1) 
+					break;
+				AppendLine(batch, slot.level, slot.message, {slot.arg, slot.arg_size});
+				// 釋放槽位給下一輪的生產者
+				slot.sequence.store(dequeue_ + slots_.size(), std::memory_order_release);
+				++dequeue_;
+				++taken;
+			}
+
+			if (taken != 0) 
+			{
+				target_.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+				target_.flush();
+				written_.fetch_add(taken, std::memory_order_release);
+				continue;
+			}
+
+			// 沒有紀錄：結束或休眠到生產端喚醒
+			if (stop_.load(std::memory_order_acquire)) 
+				return;
+			std::unique_lock lock(mutex_);
+			sleeping_.store(true, std::memory_order_relaxed);
+			// 宣告休眠後再檢查一次：生產者可能在上面的檢查之後、宣告之前發布，而且已經略過喚醒
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (slots_[dequeue_ & mask_].sequence.load(std::memory_order_acquire) == dequeue_ + 1 || stop_.load(std::memory_order_acquire)) 
+			{
+				sleeping_.store(false, std::memory_order_relaxed);
+				continue;
+			}
+			wake_.wait(lock, [this] { return !sleeping_.load(std::memory_order_relaxed); });
+		}
+	}
+
+	// 等待目前已接受的紀錄都寫出
+	void AsyncRingSink::Flush() 
+	{
+		const std::uint64_t target = accepted_.load(std::memory_order_acquire);
+		while (written_.load(std::memory_order_acquire) < target) 
+			std::this_thread::yield();
+	}
+// 結束命名空間
+}
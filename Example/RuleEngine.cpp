@@ -0,0 +1,273 @@
+// 引入對應的宣告標頭
+#include "RuleEngine.h"
+// std::stable_sort / std::sort
+#include <algorithm>
+// std::from_chars
+#include <charconv>
+// std::iota
+#include <numeric>
+// std::move
+#include <utility>
+
+// 進入命名空間
+namespace rules
+{
+	// 建構式 API：只記錄，檢查與編譯留給 Compile
+	RuleSet& RuleSet::Required(std::string key)
+	{
+		specs_.push_back({Op::kRequired, std::move(key)});
+		return *this;
+	}
+	RuleSet& RuleSet::Range(std::string key, std::int64_t lo, std::int64_t hi)
+	{
+		specs_.push_back({Op::kRange, std::move(key), lo, hi});
+		return *this;
+	}
+	RuleSet& RuleSet::OneOf(std::string key, std::vector<std::string> values)
+	{
+		specs_.push_back({Op::kOneOf, std::move(key), 0, 0, std::move(values)});
+		return *this;
+	}
+	RuleSet& RuleSet::Matches(std::string key, std::string pattern)
+	{
+		specs_.push_back({Op::kMatches, std::move(key), 0, 0, {}, std::move(pattern)});
+		return *this;
+	}
+	RuleSet& RuleSet::MaxLength(std::string key, std::size_t n)
+	{
+		specs_.push_back({Op::kMaxLength, std::move(key), 0, static_cast<std::int64_t>(n)});
+		return *this;
+	}
+	RuleSet& RuleSet::Forbid(std::string key, std::string text)
+	{
+		specs_.push_back({Op::kForbid, std::move(key), 0, 0, {}, std::move(text)});
+		return *this;
+	}
+
+	// 依鍵排序（kAnyField 最後、同鍵保持加入順序）後逐條放進 SoA 陣列
+	std::expected<Program, RuleError> RuleSet::Compile() const
+	{
+		const auto is_any = [](const Spec& spec) { return spec.key == kAnyField; };
+		std::vector<std::size_t> order(specs_.size());
+		std::iota(order.begin(), order.end(), std::size_t{0});
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+			const Spec& x = specs_[a];
+			const Spec& y = specs_[b];
+			if (is_any(x) != is_any(y))
+				return is_any(y);
+			return x.key < y.key;
+		});
+
+		Program program;
+		bool any_started = false;
+		const auto pool_append = [&](std::string_view text) {
+			const auto offset = static_cast<std::uint32_t>(program.pool_.size());
+			program.pool_.append(text);
+			return offset;
+		};
+
+		for (const std::size_t index : order)
+		{
+			const Spec& spec = specs_[index];
+			if (spec.key.empty())
+				return std::unexpected(RuleError{index, "empty key"});
+
+			// 新的鍵：開一個規則區段
+			if (is_any(spec))
+			{
+				if (spec.op == Op::kRequired)
+					return std::unexpected(RuleError{index, "required rule needs a concrete key"});
+				if (!any_started)
+				{
+					program.any_first_ = program.op_.size();
+					any_started = true;
+				}
+			}
+			else if (program.key_offset_.empty() || program.KeyAt(program.key_offset_.size() - 1) != spec.key)
+			{
+				program.key_offset_.push_back(pool_append(spec.key));
+				program.key_size_.push_back(static_cast<std::uint32_t>(spec.key.size()));
+				program.first_rule_.push_back(static_cast<std::uint32_t>(program.op_.size()));
+				program.required_.push_back(0);
+			}
+
+			// 必填只記在鍵上，評估時由合併走訪檢查
+			if (spec.op == Op::kRequired)
+			{
+				program.required_.back() = 1;
+				continue;
+			}
+
+			std::uint32_t arg   = 0;
+			std::uint32_t count = 0;
+			switch (spec.op)
+			{
+				case Op::kRange:
+					if (spec.lo > spec.hi)
+						return std::unexpected(RuleError{index, "range lower bound exceeds upper bound"});
+					break;
+				case Op::kOneOf:
+				{
+					if (spec.values.empty())
+						return std::unexpected(RuleError{index, "empty choice list"});
+					std::vector<std::string> sorted = spec.values;
+					std::sort(sorted.begin(), sorted.end());
+					arg   = static_cast<std::uint32_t>(program.choice_offset_.size());
+					count = static_cast<std::uint32_t>(sorted.size());
+					for (const std::string& value : sorted)
+					{
+						program.choice_offset_.push_back(pool_append(value));
+						program.choice_size_.push_back(static_cast<std::uint32_t>(value.size()));
+					}
+					break;
+				}
+				case Op::kMatches:
+					// 標準函式庫以例外回報樣式錯誤：只在編譯時出現，轉成 RuleError
+					try
+					{
+						program.patterns_.emplace_back(spec.text, std::regex::ECMAScript | std::regex::optimize);
+					}
+					catch (const std::regex_error& e)
+					{
+						return std::unexpected(RuleError{index, e.what()});
+					}
+					arg = static_cast<std::uint32_t>(program.patterns_.size() - 1);
+					break;
+				case Op::kForbid:
+					arg   = pool_append(spec.text);
+					count = static_cast<std::uint32_t>(spec.text.size());
+					break;
+				case Op::kMaxLength:
+				case Op::kRequired:
+					break;
+			}
+			program.op_.push_back(spec.op);
+			program.lo_.push_back(spec.lo);
+			program.hi_.push_back(spec.hi);
+			program.arg_.push_back(arg);
+			program.count_.push_back(count);
+		}
+
+		// 最後一個鍵的區段到套用全部欄位的規則之前為止
+		if (!any_started)
+			program.any_first_ = program.op_.size();
+		program.first_rule_.push_back(static_cast<std::uint32_t>(program.any_first_));
+		return program;
+	}
+
+	// 同一個鍵的規則在各陣列中相鄰：逐條比對，遇到第一條不通過即停止
+	bool Program::Run(std::size_t first, std::size_t last, std::string_view value) const
+	{
+		for (std::size_t r = first; r < last; ++r)
+		{
+			switch (op_[r])
+			{
+				case Op::kRange:
+				{
+					std::int64_t number = 0;
+					const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+					if (ec != std::errc{} || end != value.data() + value.size() || number < lo_[r] || number > hi_[r])
+						return false;
+					break;
+				}
+				case Op::kOneOf:
+				{
+					// 區段內已排序：二分搜尋
+					std::size_t low  = arg_[r];
+					std::size_t high = low + count_[r];
+					const std::size_t end = high;
+					while (low < high)
+					{
+						const std::size_t mid = low + (high - low) / 2;
+						if (PoolAt(choice_offset_[mid], choice_size_[mid]) < value)
+							low = mid + 1;
+						else
+							high = mid;
+					}
+					if (low == end || PoolAt(choice_offset_[low], choice_size_[low]) != value)
+						return false;
+					break;
+				}
+				case Op::kMatches:
+					if (!std::regex_match(value.begin(), value.end(), patterns_[arg_[r]]))
+						return false;
+					break;
+				case Op::kMaxLength:
+					if (static_cast<std::int64_t>(value.size()) > hi_[r])
+						return false;
+					break;
+				case Op::kForbid:
+					if (value.find(PoolAt(arg_[r], count_[r])) != std::string_view::npos)
+						return false;
+					break;
+				case Op::kRequired:
+					break;
+			}
+		}
+		return true;
+	}
+
+	// 合併走訪：欄位表與程式的鍵都依鍵排序
+	// 缺少的必填欄位在原文中沒有位置：位移記為最後一個欄位的結尾（補上欄位之處），走訪完才知道
+	std::vector<config::ValidationError> Program::Evaluate(const kv::Table& fields) const
+	{
+		std::vector<config::ValidationError> errors;
+		std::vector<std::size_t> absent;
+		std::size_t end = 0;
+		const std::size_t keys = key_count();
+		std::size_t k = 0;
+		const auto missing = [&](std::size_t key) {
+			if (required_[key] != 0)
+			{
+				absent.push_back(errors.size());
+				errors.push_back({std::string(KeyAt(key)), "missing required field"});
+			}
+		};
+
+		for (std::size_t i = 0; i < fields.size(); ++i)
+		{
+			const kv::Field field = fields[i];
+			end = std::max(end, field.source_offset + field.source_size);
+			while (k < keys && KeyAt(k) < field.key)
+				missing(k++);
+
+			bool passed = true;
+			if (k < keys && KeyAt(k) == field.key)
+			{
+				passed = Run(first_rule_[k], first_rule_[k + 1], field.value);
+				++k;
+			}
+			if (passed)
+				passed = Run(any_first_, size(), field.value);
+			if (!passed)
+				errors.push_back({std::string(field.key), field.value.empty() ? std::string("empty value") : std::string(field.value),
+				                  field.source_offset});
+		}
+		while (k < keys)
+			missing(k++);
+		for (const std::size_t at : absent)
+			errors[at].offset = end;
+		return errors;
+	}
+
+	// 已解析的 Config 直接評估欄位表；手動建立的先解析
+	std::expected<void, std::vector<config::ValidationError>> Program::Validate(const config::Config& config) const
+	{
+		std::vector<config::ValidationError> errors;
+		if (config.fields.parsed())
+			errors = Evaluate(config.fields);
+		else if (auto parsed = kv::Parse(config.data))
+			errors = Evaluate(*parsed);
+		else
+		{
+			// 欄位名稱為出錯的那一段（到行尾為止）
+			const std::string_view rest = std::string_view(config.data).substr(parsed.error().offset);
+			errors.push_back({std::string(rest.substr(0, rest.find('\n'))), std::string(parsed.error().reason), parsed.error().offset});
+		}
+
+		if (!errors.empty())
+			return std::unexpected(std::move(errors));
+		return {};
+	}
+// 結束命名空間
+}
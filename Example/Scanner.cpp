@@ -0,0 +1,251 @@
+// 引入對應的宣告標頭
+#include "Scanner.h"
+// std::find_if
+#include <algorithm>
+// std::countr_zero
+#include <bit>
+// BFS 建立失敗連結
+#include <queue>
+// std::move
+#include <utility>
+#if defined(__SSE2__)
+// SSE2：x86-64 的基本指令集，不需另外的編譯旗標
+#include <emmintrin.h>
+#endif
+
+// 進入命名空間
+namespace scanner 
+{
+	// 是否曾命中指定樣式
+	bool ScanResult::Contains(std::size_t pattern) const noexcept 
+	{
+		return First(pattern).has_value();
+	}
+
+	// 指定樣式第一次出現的位移：命中依結尾排序，同一樣式長度固定，第一筆即最早起點
+	std::optional<std::size_t> ScanResult::First(std::size_t pattern) const noexcept 
+	{
+		const auto it = std::find_if(hits.begin(), hits.end(),
+		                             [pattern](const Hit& h) { return h.pattern == pattern; });
+		if (it == hits.end()) 
+			return std::nullopt;
+		return it->offset;
+	}
+
+	// 位移 → 行：第 k 個換行之後即第 k + 1 行
+	LineLocation ScanResult::Locate(std::string_view text, std::size_t offset) const noexcept 
+	{
+		// 位移之前（含）共有幾個換行 = 位移所在行之前的行數
+		const auto next = std::lower_bound(newlines.begin(), newlines.end(), offset);
+		const auto line_index = static_cast<std::size_t>(next - newlines.begin());
+
+		// 行起點：前一個換行之後；行終點：下一個換行（或輸入結尾）
+		const std::size_t begin = line_index == 0 ? 0 : newlines[line_index - 1] + 1;
+		std::size_t end = next == newlines.end() ? text.size() : *next;
+		// Windows 換行（CRLF）不把 '\r' 算進內容
+		if (end > begin && text[end - 1] == '\r') 
+			--end;
+
+		return LineLocation{static_cast<int>(line_index + 1), text.substr(begin, end - begin)};
+	}
+
+	// 建立自動機：字元類別壓縮 → 建 trie → BFS 補齊失敗轉移，得到完整 DFA
+	MultiPatternScanner::MultiPatternScanner(std::vector<std::string> patterns)
+		: patterns_(std::move(patterns)) 
+	{
+		// 1. 字元類別：只替樣式用到的位元組分配類別，讓轉移表列寬保持很小
+		for (const auto& p : patterns_) 
+			for (unsigned char b : p) 
+				if (byte_class_[b] == 0) 
+					byte_class_[b] = static_cast<std::uint16_t>(class_count_++);
+
+		// 各樣式的首字元（SIMD 前置過濾用）
+		for (const auto& p : patterns_) 
+		{
+			if (p.empty()) 
+				continue;
+			const auto b = static_cast<unsigned char>(p.front());
+			if (std::find(first_bytes_.begin(), first_bytes_.end(), b) == first_bytes_.end()) 
+				first_bytes_.push_back(b);
+		}
+
+		// 尚未建立的轉移
+		constexpr std::uint32_t kNone = UINT32_MAX;
+		// 根狀態
+		next_.assign(class_count_, kNone);
+		std::vector<std::vector<std::uint32_t>> out(1);
+
+		// 2. 插入每個樣式（空字串永遠不會命中，直接略過）
+		for (std::size_t id = 0; id < patterns_.size(); ++id) 
+		{
+			if (patterns_[id].empty()) 
+				continue;
+			std::uint32_t state = 0;
+			for (unsigned char b : patterns_[id]) 
+			{
+				auto& slot = next_[state * class_count_ + byte_class_[b]];
+				if (slot == kNone) 
+				{
+					slot = static_cast<std::uint32_t>(out.size());
+					out.emplace_back();
+					next_.resize(next_.size() + class_count_, kNone);
+				}
+				// resize 會使 slot 失效，因此改以索引重新讀取
+				state = next_[state * class_count_ + byte_class_[b]];
+			}
+			out[state].push_back(static_cast<std::uint32_t>(id));
+		}
+
+		// 3. BFS：根的缺漏轉移回到根；其他狀態的缺漏轉移沿用失敗狀態的轉移
+		const std::size_t state_count = out.size();
+		std::vector<std::uint32_t> fail(state_count, 0);
+		std::queue<std::uint32_t> pending;
+		for (std::size_t c = 0; c < class_count_; ++c) 
+		{
+			auto& slot = next_[c];
+			if (slot == kNone) 
+				slot = 0;
+			else 
+				pending.push(slot);
+		}
+		while (!pending.empty()) 
+		{
+			const std::uint32_t s = pending.front();
+			pending.pop();
+			for (std::size_t c = 0; c < class_count_; ++c) 
+			{
+				auto& slot = next_[s * class_count_ + c];
+				const std::uint32_t via_fail = next_[fail[s] * class_count_ + c];
+				if (slot == kNone) 
+				{
+					slot = via_fail;
+					continue;
+				}
+				// 子狀態的失敗連結，並繼承失敗狀態的輸出（處理樣式互為後綴的情況）
+				fail[slot] = via_fail;
+				out[slot].insert(out[slot].end(), out[via_fail].begin(), out[via_fail].end());
+				pending.push(slot);
+			}
+		}
+
+		// 4. 輸出表扁平化，掃描時不需追指標
+		output_begin_.reserve(state_count + 1);
+		for (const auto& o : out) 
+		{
+			output_begin_.push_back(static_cast<std::uint32_t>(outputs_.size()));
+			outputs_.insert(outputs_.end(), o.begin(), o.end());
+		}
+		output_begin_.push_back(static_cast<std::uint32_t>(outputs_.size()));
+	}
+
+	// 單次走訪：每個位元組只查一次轉移表，並順便記錄換行
+	ScanResult MultiPatternScanner::Scan(std::string_view text) const 
+	{
+		ScanResult result;
+		result.scanned = true;
+		std::uint32_t state = 0;
+		Run(state, text, 0, result);
+		return result;
+	}
+
+	// 沿用 into 的容量
+	void MultiPatternScanner::Scan(std::string_view text, ScanResult& into) const 
+	{
+		into.hits.clear();
+		into.newlines.clear();
+		into.scanned = true;
+		std::uint32_t state = 0;
+		Run(state, text, 0, into);
+	}
+
+	// 串流掃描：DFA 狀態跨區塊延續
+	ScanResult MultiPatternScanner::Feed(StreamState& stream, std::string_view chunk) const 
+	{
+		ScanResult result;
+		result.scanned = true;
+		Run(stream.state, chunk, stream.offset, result);
+		stream.offset        += chunk.size();
+		stream.newline_count += result.newlines.size();
+		return result;
+	}
+
+	// 區塊內的行號：區塊之前的換行數 + 區塊內位於 pos 之前的換行數 + 1
+	int StreamState::LineOf(const ScanResult& chunk, std::size_t pos) const noexcept 
+	{
+		const std::size_t lines_before = newline_count - chunk.newlines.size();
+		const auto inside = std::lower_bound(chunk.newlines.begin(), chunk.newlines.end(), pos) - chunk.newlines.begin();
+		return static_cast<int>(lines_before + static_cast<std::size_t>(inside) + 1);
+	}
+
+	// 共用走訪：從 state 開始，位移加上 base
+	void MultiPatternScanner::Run(std::uint32_t& resume, std::string_view text, std::size_t base, ScanResult& result) const 
+	{
+		// 狀態放在區域變數，避免經由參考存取而無法留在暫存器
+		std::uint32_t state = resume;
+		// 先把成員取成區域變數：迴圈內對 hits/newlines 的寫入不會迫使編譯器每個位元組重新載入它們
+		const std::uint32_t* const next    = next_.data();
+		const std::uint16_t* const classes = byte_class_;
+		const std::uint32_t* const begin   = output_begin_.data();
+		const std::size_t          width   = class_count_;
+		const char* const          data    = text.data();
+		const std::size_t          size    = text.size();
+
+		// 逐位元組走 DFA（每一步都依賴上一步的狀態，是延遲瓶頸）
+		const auto step = [&](std::size_t i) 
+		{
+			const auto byte = static_cast<unsigned char>(data[i]);
+			// 換行索引與哨兵比對共用同一次讀取，不必再為行號另掃一遍
+			if (byte == '\n') 
+				result.newlines.push_back(base + i);
+			state = next[state * width + classes[byte]];
+			// 大多數狀態沒有輸出，這個區間通常為空（串流時命中起點可能落在前一個區塊）
+			for (std::uint32_t k = begin[state]; k < begin[state + 1]; ++k) 
+			{
+				const std::uint32_t id = outputs_[k];
+				result.hits.push_back(Hit{id, base + i + 1 - patterns_[id].size()});
+			}
+		};
+
+		std::size_t i = 0;
+#if defined(__SSE2__)
+		// SIMD 前置過濾：位於根狀態時，16 個位元組內若沒有任何樣式的首字元，DFA 必定停在根狀態，
+		// 整塊直接跳過；換行位置則由同一次比較的位元遮罩取得
+		if (!first_bytes_.empty() && first_bytes_.size() <= kMaxPrefilterBytes) 
+		{
+			const __m128i newline = _mm_set1_epi8('\n');
+			__m128i firsts[kMaxPrefilterBytes];
+			for (std::size_t k = 0; k < first_bytes_.size(); ++k) 
+				firsts[k] = _mm_set1_epi8(static_cast<char>(first_bytes_[k]));
+
+			for (; i + 16 <= size; i += 16) 
+			{
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+				__m128i starts = _mm_cmpeq_epi8(block, firsts[0]);
+				for (std::size_t k = 1; k < first_bytes_.size(); ++k) 
+					starts = _mm_or_si128(starts, _mm_cmpeq_epi8(block, firsts[k]));
+
+				if (state != 0 || _mm_movemask_epi8(starts) != 0) 
+				{
+					// 可能命中：這一塊逐位元組走 DFA
+					for (std::size_t j = 0; j < 16; ++j) 
+						step(i + j);
+					continue;
+				}
+
+				// 整塊留在根狀態：只需記錄換行
+				auto lines = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)));
+				while (lines != 0) 
+				{
+					result.newlines.push_back(base + i + static_cast<std::size_t>(std::countr_zero(lines)));
+					lines &= lines - 1;
+				}
+			}
+		}
+#endif
+		// 尾端（或不支援 SIMD 的平台）：逐位元組
+		for (; i < size; ++i) 
+			step(i);
+		resume = state;
+	}
+// 結束命名空間
+}
@@ -0,0 +1,118 @@
+// Include Guard：避免重複包含
+#ifndef TYPE_LIST_H
+// 與上方成對
+#define TYPE_LIST_H
+
+// std::size_t
+#include <cstddef>
+// std::is_same_v / std::conditional_t
+#include <type_traits>
+// std::variant
+#include <variant>
+
+/*
+編譯期型別清單：讓各階段各自宣告會產生的錯誤，再由編譯器算出整條管線的錯誤 variant
+- Union<L...>：依出現順序合併多個 TypeList，重複的型別只保留第一次
+- AsVariant<L>：TypeList<Ts...> → std::variant<Ts...>
+- variant 之間的合併與轉換見 VariantMerge.h
+*/
+
+// 開始命名空間
+namespace meta
+{
+	// 型別清單（只在編譯期使用，沒有任何成員）
+	template<typename... Ts>
+	struct TypeList {};
+
+	// T 是否在清單中
+	template<typename List, typename T>
+	inline constexpr bool kContains = false;
+	template<typename... Ts, typename T>
+	inline constexpr bool kContains<TypeList<Ts...>, T> = (std::is_same_v<Ts, T> || ...);
+
+	// 清單長度
+	template<typename List>
+	inline constexpr std::size_t kSize = 0;
+	template<typename... Ts>
+	inline constexpr std::size_t kSize<TypeList<Ts...>> = sizeof...(Ts);
+
+	// 實作細節
+	namespace detail
+	{
+		// 逐一把 Rest 中還沒出現過的型別接到 Done 後面
+		template<typename Done, typename... Rest>
+		struct UniqueImpl
+		{
+			using type = Done;
+		};
+		template<typename... Done, typename T, typename... Rest>
+		struct UniqueImpl<TypeList<Done...>, T, Rest...>
+			: UniqueImpl<std::conditional_t<kContains<TypeList<Done...>, T>, TypeList<Done...>, TypeList<Done..., T>>, Rest...>
+		{
+		};
+
+		// 串接多個清單
+		template<typename... Lists>
+		struct ConcatImpl
+		{
+			using type = TypeList<>;
+		};
+		template<typename... Ts>
+		struct ConcatImpl<TypeList<Ts...>>
+		{
+			using type = TypeList<Ts...>;
+		};
+		template<typename... As, typename... Bs, typename... Lists>
+		struct ConcatImpl<TypeList<As...>, TypeList<Bs...>, Lists...> : ConcatImpl<TypeList<As..., Bs...>, Lists...>
+		{
+		};
+
+		// TypeList → variant
+		template<typename List>
+		struct AsVariantImpl;
+		template<typename... Ts>
+		struct AsVariantImpl<TypeList<Ts...>>
+		{
+			using type = std::variant<Ts...>;
+		};
+
+		// variant → TypeList
+		template<typename Variant>
+		struct AlternativesImpl;
+		template<typename... Ts>
+		struct AlternativesImpl<std::variant<Ts...>>
+		{
+			using type = TypeList<Ts...>;
+		};
+
+		// 清單 → 去除重複
+		template<typename List>
+		struct DedupImpl;
+		template<typename... Ts>
+		struct DedupImpl<TypeList<Ts...>> : UniqueImpl<TypeList<>, Ts...>
+		{
+		};
+	}
+
+	// 串接
+	template<typename... Lists>
+	using Concat = typename detail::ConcatImpl<Lists...>::type;
+	// 去除重複（保留第一次出現的位置）
+	template<typename List>
+	using Unique = typename detail::DedupImpl<List>::type;
+	// 合併後去重
+	template<typename... Lists>
+	using Union = Unique<Concat<Lists...>>;
+	// 轉成 variant
+	template<typename List>
+	using AsVariant = typename detail::AsVariantImpl<List>::type;
+	// 取出 variant 的各個型別
+	template<typename Variant>
+	using Alternatives = typename detail::AlternativesImpl<Variant>::type;
+	// 多個錯誤清單合併成單一 variant
+	template<typename... Lists>
+	using UnionVariant = AsVariant<Union<Lists...>>;
+// 結束命名空間
+}
+
+#endif
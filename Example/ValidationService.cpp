@@ -0,0 +1,540 @@
+// 引入對應的宣告標頭
+#include "ValidationService.h"
+// 可在編譯期移除的除錯日誌
+#include "Log.h"
+// std::min / std::max
+#include <algorithm>
+// errno
+#include <cerrno>
+// 退避等待
+#include <chrono>
+// std::numeric_limits
+#include <limits>
+// std::optional（各節點的錯誤）
+#include <optional>
+// std::exchange / std::move
+#include <utility>
+// POSIX：socket、位址轉換、TCP 選項
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// 進入命名空間
+namespace service
+{
+	// 僅供本檔使用
+	namespace
+	{
+		// 寫完整段（處理短寫與 EINTR）；MSG_NOSIGNAL：對方已關閉時回傳 EPIPE，而不是送出 SIGPIPE
+		[[nodiscard]] bool SendAll(int fd, std::string_view bytes) noexcept
+		{
+			while (!bytes.empty())
+			{
+				const ::ssize_t n = ::send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+				if (n < 0 && errno == EINTR)
+					continue;
+				if (n <= 0)
+					return false;
+				bytes.remove_prefix(static_cast<std::size_t>(n));
+			}
+			return true;
+		}
+
+		// 讀滿 size 個位元組；對方關閉連線時 code 為 0
+		[[nodiscard]] std::expected<void, NetError> RecvAll(int fd, char* out, std::size_t size) noexcept
+		{
+			std::size_t got = 0;
+			while (got < size)
+			{
+				const ::ssize_t n = ::recv(fd, out + got, size - got, 0);
+				if (n < 0 && errno == EINTR)
+					continue;
+				if (n < 0)
+					return std::unexpected(NetError{"recv", errno});
+				if (n == 0)
+					return std::unexpected(NetError{"recv", 0});
+				got += static_cast<std::size_t>(n);
+			}
+			return {};
+		}
+
+		// 一個訊框：訊息種類與其後的內容（檢視 buffer，下一次讀取前有效）
+		struct Frame
+		{
+			wire::Message    type;
+			std::string_view body;
+		};
+
+		// 先讀長度，再一次讀完內容（沿用 buffer 的容量）
+		[[nodiscard]] std::expected<Frame, ClientError> ReadFrame(int fd, std::string& buffer)
+		{
+			char header[wire::kLengthSize];
+			if (auto got = RecvAll(fd, header, sizeof(header)); !got)
+				return std::unexpected(got.error());
+			const auto length = wire::FrameLength(std::string_view(header, sizeof(header)));
+			if (!length)
+				return std::unexpected(length.error());
+			buffer.resize(*length);
+			if (auto got = RecvAll(fd, buffer.data(), buffer.size()); !got)
+				return std::unexpected(got.error());
+			return Frame{static_cast<wire::Message>(buffer[0]), std::string_view(buffer).substr(1)};
+		}
+
+		// 小訊框（kDone、kBusy）立即送出，不等 Nagle 合併
+		void DisableNagle(int fd) noexcept
+		{
+			int one = 1;
+			::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+		}
+
+		// 線路格式的計數欄位為 u32
+		[[nodiscard]] std::uint32_t Clamp32(std::size_t value) noexcept
+		{
+			return static_cast<std::uint32_t>(std::min<std::size_t>(value, std::numeric_limits<std::uint32_t>::max()));
+		}
+	}
+
+	/*==============================節點======================================*/
+
+	// 一條已接受的連線：讀取端只有 ReadLoop，寫入端（結果與 kBusy）以 write_mutex 串行
+	struct Server::Connection
+	{
+		explicit Connection(int descriptor) noexcept : fd(descriptor) {}
+		~Connection() { ::close(fd); }
+
+		[[nodiscard]] bool Send(std::string_view bytes)
+		{
+			const std::lock_guard lock(write_mutex);
+			return SendAll(fd, bytes);
+		}
+
+		int               fd;
+		std::mutex        write_mutex;
+		// ReadLoop 結束（可回收其執行緒）
+		std::atomic<bool> closed{false};
+	};
+
+	// 監聽所有介面；port 為 0 時由系統指定
+	std::expected<std::unique_ptr<Server>, NetError> Server::Start(const ServerOptions& options)
+	{
+		const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (fd < 0)
+			return std::unexpected(NetError{"socket", errno});
+		int one = 1;
+		::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+		sockaddr_in address{};
+		address.sin_family      = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_ANY);
+		address.sin_port        = htons(options.port);
+		if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			const int error = errno;
+			::close(fd);
+			return std::unexpected(NetError{"bind", error});
+		}
+		socklen_t size = sizeof(address);
+		if (::listen(fd, SOMAXCONN) != 0 || ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &size) != 0)
+		{
+			const int error = errno;
+			::close(fd);
+			return std::unexpected(NetError{"listen", error});
+		}
+		CONFIG_LOG(logging::Level::kInfo, "validation node listening on port ", std::to_string(ntohs(address.sin_port)));
+		return std::unique_ptr<Server>(new Server(fd, ntohs(address.sin_port), options));
+	}
+
+	Server::Server(int listen_fd, std::uint16_t port, const ServerOptions& options)
+		: listen_fd_(listen_fd), port_(port), options_(options), pool_(options.threads)
+	{
+		options_.chunk = std::max<std::size_t>(1, options_.chunk);
+		acceptor_   = std::thread([this] { AcceptLoop(); });
+		dispatcher_ = std::thread([this] { DispatchLoop(); });
+	}
+
+	Server::~Server()
+	{
+		Stop();
+	}
+
+	// shutdown 讓阻塞中的 accept / recv / send 立即返回
+	void Server::Stop()
+	{
+		{
+			const std::lock_guard lock(mutex_);
+			if (stop_)
+				return;
+			stop_ = true;
+		}
+		wake_.notify_all();
+		::shutdown(listen_fd_, SHUT_RDWR);
+		acceptor_.join();
+
+		// 接受執行緒已結束：連線清單不再增加
+		std::vector<Session> sessions;
+		{
+			const std::lock_guard lock(mutex_);
+			sessions.swap(sessions_);
+		}
+		for (auto& session : sessions)
+			::shutdown(session.connection->fd, SHUT_RDWR);
+		for (auto& session : sessions)
+			session.reader.join();
+		dispatcher_.join();
+
+		{
+			const std::lock_guard lock(mutex_);
+			jobs_.clear();
+		}
+		queued_.store(0, std::memory_order_relaxed);
+		::close(listen_fd_);
+	}
+
+	// 每條連線一個讀取執行緒；順便回收已結束的連線
+	void Server::AcceptLoop()
+	{
+		for (;;)
+		{
+			const int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+			const int error = errno;
+
+			std::unique_lock lock(mutex_);
+			if (stop_)
+			{
+				if (fd >= 0)
+					::close(fd);
+				return;
+			}
+			// ReadLoop 設定 closed 之後不再取鎖：在此 join 不會互相等待
+			std::erase_if(sessions_, [](Session& session)
+			{
+				if (!session.connection->closed.load(std::memory_order_acquire))
+					return false;
+				session.reader.join();
+				return true;
+			});
+			if (fd < 0)
+			{
+				lock.unlock();
+				// 開檔數用盡：稍後再試，其餘錯誤（例如對方已放棄連線）直接略過
+				if (error == EMFILE || error == ENFILE)
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				continue;
+			}
+
+			DisableNagle(fd);
+			auto connection = std::make_shared<Connection>(fd);
+			sessions_.push_back(Session{connection, std::thread([this, connection] { ReadLoop(connection); })});
+		}
+	}
+
+	// 讀取錯誤、格式錯誤或對方關閉時結束；佇列已滿時回覆 kBusy 並繼續讀
+	void Server::ReadLoop(std::shared_ptr<Connection> connection)
+	{
+		std::string buffer;
+		std::string reply;
+		for (;;)
+		{
+			auto frame = ReadFrame(connection->fd, buffer);
+			if (!frame)
+				break;
+			if (frame->type != wire::Message::kBatch)
+			{
+				CONFIG_LOG(logging::Level::kWarn, "validation node dropped connection: ", "unexpected message");
+				break;
+			}
+			auto batch = wire::ParseBatch(frame->body);
+			if (!batch)
+			{
+				CONFIG_LOG(logging::Level::kWarn, "validation node dropped connection: ", batch.error().reason);
+				break;
+			}
+
+			const std::size_t count = batch->configs.size();
+			std::unique_lock lock(mutex_);
+			if (stop_)
+				break;
+			const std::size_t depth = queued_.load(std::memory_order_relaxed);
+			if (depth + count > options_.max_queued_configs)
+			{
+				lock.unlock();
+				reply.clear();
+				wire::AppendBusy(reply, {batch->id, Clamp32(depth), Clamp32(options_.max_queued_configs)});
+				if (!connection->Send(reply))
+					break;
+				continue;
+			}
+			queued_.store(depth + count, std::memory_order_relaxed);
+			jobs_.push_back(Job{connection, batch->id, std::move(batch->configs)});
+			lock.unlock();
+			wake_.notify_one();
+		}
+		connection->closed.store(true, std::memory_order_release);
+	}
+
+	// 每 chunk 筆跑一次 RunBatch 並立即送回；連線中斷時捨棄該批次其餘部分
+	void Server::DispatchLoop()
+	{
+		std::string reply;
+		for (;;)
+		{
+			Job job;
+			{
+				std::unique_lock lock(mutex_);
+				wake_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+				if (stop_)
+					return;
+				job = std::move(jobs_.front());
+				jobs_.pop_front();
+			}
+
+			const std::size_t total = job.configs.size();
+			std::size_t sent = 0;
+			bool connected = true;
+			while (sent < total && connected)
+			{
+				const std::size_t count = std::min(options_.chunk, total - sent);
+				const auto outcomes = config::RunBatch(pool_, std::span(job.configs).subspan(sent, count));
+				reply.clear();
+				wire::AppendResults(reply, job.id, Clamp32(sent), outcomes);
+				connected = job.connection->Send(reply);
+				sent += count;
+				queued_.fetch_sub(count, std::memory_order_relaxed);
+			}
+			queued_.fetch_sub(total - sent, std::memory_order_relaxed);
+			if (connected)
+			{
+				reply.clear();
+				wire::AppendDone(reply, {job.id, Clamp32(total)});
+				(void)job.connection->Send(reply);
+			}
+		}
+	}
+
+	/*==============================客戶端======================================*/
+
+	// host 必須是數字形式的 IPv4 位址
+	std::expected<Client, NetError> Client::Connect(const Endpoint& endpoint)
+	{
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_port   = htons(endpoint.port);
+		if (::inet_pton(AF_INET, endpoint.host.c_str(), &address.sin_addr) != 1)
+			return std::unexpected(NetError{"inet_pton", EINVAL});
+
+		const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (fd < 0)
+			return std::unexpected(NetError{"socket", errno});
+		if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			const int error = errno;
+			::close(fd);
+			return std::unexpected(NetError{"connect", error});
+		}
+		DisableNagle(fd);
+		return Client(fd);
+	}
+
+	Client::Client(Client&& other) noexcept
+		: fd_(std::exchange(other.fd_, -1)), next_id_(other.next_id_), buffer_(std::move(other.buffer_))
+	{
+	}
+
+	Client& Client::operator=(Client&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (fd_ >= 0)
+				::close(fd_);
+			fd_      = std::exchange(other.fd_, -1);
+			next_id_ = other.next_id_;
+			buffer_  = std::move(other.buffer_);
+		}
+		return *this;
+	}
+
+	Client::~Client()
+	{
+		if (fd_ >= 0)
+			::close(fd_);
+	}
+
+	// 全部項目
+	std::expected<Outcomes, ClientError> Client::Validate(std::span<const config::BufferedConfig> configs)
+	{
+		std::vector<const config::BufferedConfig*> selected;
+		selected.reserve(configs.size());
+		for (const auto& config : configs)
+			selected.push_back(&config);
+		return Validate(std::span<const config::BufferedConfig* const>(selected));
+	}
+
+	// 送出後讀到 kDone（或 kBusy）為止；結果訊框可能分成多個、依序到達
+	std::expected<Outcomes, ClientError> Client::Validate(std::span<const config::BufferedConfig* const> selected)
+	{
+		// 節點拒收超過上限的訊框並關閉連線：先計算大小，不編碼、不送出
+		std::size_t size = wire::kBatchOverhead;
+		for (const auto* config : selected)
+			size += wire::BatchEntrySize(*config);
+		if (size > wire::kMaxFrameSize)
+			return std::unexpected(NetError{"send", EMSGSIZE});
+
+		const std::uint32_t id = next_id_++;
+		buffer_.clear();
+		wire::AppendBatch(buffer_, id, selected);
+		if (!SendAll(fd_, buffer_))
+			return std::unexpected(NetError{"send", errno});
+
+		Outcomes outcomes(selected.size());
+		std::size_t received = 0;
+		for (;;)
+		{
+			auto frame = ReadFrame(fd_, buffer_);
+			if (!frame)
+				return std::unexpected(frame.error());
+			switch (frame->type)
+			{
+				case wire::Message::kResults:
+				{
+					auto results = wire::ParseResults(frame->body);
+					if (!results)
+						return std::unexpected(results.error());
+					if (results->id != id || results->first + results->outcomes.size() > outcomes.size())
+						return std::unexpected(wire::DecodeError{0, "results do not match batch"});
+					std::move(results->outcomes.begin(), results->outcomes.end(), outcomes.begin() + results->first);
+					received += results->outcomes.size();
+					break;
+				}
+				case wire::Message::kDone:
+				{
+					auto done = wire::ParseDone(frame->body);
+					if (!done)
+						return std::unexpected(done.error());
+					if (done->id != id || done->total != outcomes.size() || received != outcomes.size())
+						return std::unexpected(wire::DecodeError{0, "incomplete results"});
+					return outcomes;
+				}
+				case wire::Message::kBusy:
+				{
+					auto busy = wire::ParseBusy(frame->body);
+					if (!busy)
+						return std::unexpected(busy.error());
+					return std::unexpected(BusyError{busy->queue_depth, busy->limit});
+				}
+				default:
+					return std::unexpected(wire::DecodeError{0, "unexpected message"});
+			}
+		}
+	}
+
+	/*==============================分片======================================*/
+
+	// FNV-1a：同一名稱在任何程序、任何平台都分到同一個節點
+	std::size_t ShardOf(std::string_view name, std::size_t nodes) noexcept
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		for (const char c : name)
+			hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+		return nodes == 0 ? 0 : static_cast<std::size_t>(hash % nodes);
+	}
+
+	// 僅供本檔使用
+	namespace
+	{
+		// 一個節點負責的項目：依 max_batch 與訊框大小分批送出；忙碌時縮小批次或退避重送
+		// （單筆設定本身就超過訊框上限時，Validate 回傳 EMSGSIZE）
+		[[nodiscard]] std::expected<void, ClientError> ValidateShard(const Endpoint& node, std::span<const config::BufferedConfig> configs,
+		                                                             std::span<const std::size_t> indices, const ShardOptions& options,
+		                                                             Outcomes& outcomes)
+		{
+			auto client = Client::Connect(node);
+			if (!client)
+				return std::unexpected(client.error());
+
+			std::size_t batch = std::max<std::size_t>(1, options.max_batch);
+			std::vector<const config::BufferedConfig*> selected;
+			int attempt = 0;
+			for (std::size_t done = 0; done < indices.size();)
+			{
+				const std::size_t limit = std::min(batch, indices.size() - done);
+				selected.clear();
+				std::size_t bytes = wire::kBatchOverhead;
+				for (std::size_t k = 0; k < limit; ++k)
+				{
+					const config::BufferedConfig& config = configs[indices[done + k]];
+					const std::size_t entry = wire::BatchEntrySize(config);
+					if (k > 0 && bytes + entry > wire::kMaxFrameSize)
+						break;
+					bytes += entry;
+					selected.push_back(&config);
+				}
+				const std::size_t count = selected.size();
+
+				auto results = client->Validate(selected);
+				if (!results)
+				{
+					const auto* busy = std::get_if<BusyError>(&results.error());
+					if (busy == nullptr)
+						return std::unexpected(results.error());
+					// 批次本身超過節點的上限：縮小後立即重送
+					if (busy->limit > 0 && busy->limit < count)
+					{
+						batch = busy->limit;
+						continue;
+					}
+					if (++attempt > options.max_retries)
+						return std::unexpected(results.error());
+					std::this_thread::sleep_for(std::chrono::milliseconds(1 << std::min(attempt, 6)));
+					continue;
+				}
+
+				// 各節點寫入不同的索引，不需同步
+				for (std::size_t k = 0; k < count; ++k)
+					outcomes[indices[done + k]] = std::move((*results)[k]);
+				done += count;
+				attempt = 0;
+			}
+			return {};
+		}
+	}
+
+	// 先依名稱分組，再每個節點一個執行緒
+	std::expected<Outcomes, ClientError> ValidateSharded(std::span<const Endpoint> nodes,
+	                                                     std::span<const config::BufferedConfig> configs,
+	                                                     const ShardOptions& options)
+	{
+		if (nodes.empty())
+		{
+			if (configs.empty())
+				return Outcomes{};
+			return std::unexpected(NetError{"connect", EINVAL});
+		}
+
+		std::vector<std::vector<std::size_t>> shards(nodes.size());
+		for (std::size_t i = 0; i < configs.size(); ++i)
+			shards[ShardOf(configs[i].name, nodes.size())].push_back(i);
+
+		Outcomes outcomes(configs.size());
+		std::vector<std::optional<ClientError>> failures(nodes.size());
+		{
+			std::vector<std::jthread> workers;
+			for (std::size_t n = 0; n < nodes.size(); ++n)
+			{
+				if (shards[n].empty())
+					continue;
+				workers.emplace_back([&, n]
+				{
+					if (auto sent = ValidateShard(nodes[n], configs, shards[n], options, outcomes); !sent)
+						failures[n] = std::move(sent).error();
+				});
+			}
+		}
+		for (auto& failure : failures)
+			if (failure)
+				return std::unexpected(std::move(*failure));
+		return outcomes;
+	}
+// 結束命名空間
+}
@@ -0,0 +1,198 @@
+// Include Guard：避免重複包含
+#ifndef VALIDATION_SERVICE_H
+// 與上方成對
+#define VALIDATION_SERVICE_H
+
+// WorkStealingPool / BufferedConfig
+#include "BatchExecutor.h"
+// 線路格式
+#include "Wire.h"
+// 已接收的設定筆數
+#include <atomic>
+// 分派執行緒的喚醒
+#include <condition_variable>
+// std::size_t
+#include <cstddef>
+// 固定寬度整數
+#include <cstdint>
+// 待處理的批次
+#include <deque>
+// std::expected
+#include <expected>
+// 伺服器物件（不可移動）
+#include <memory>
+// 佇列與連線清單的鎖
+#include <mutex>
+// 批次檢視
+#include <span>
+// 主機位址
+#include <string>
+// 系統呼叫名稱
+#include <string_view>
+// 接受連線、分派與每個連線的讀取執行緒
+#include <thread>
+// 客戶端錯誤
+#include <variant>
+// 結果
+#include <vector>
+
+/*
+分散式驗證服務：多個節點各自以 RunBatch 驗證收到的批次，客戶端依名稱雜湊把設定分到各節點
+- Server：在 TCP 連接埠上接受批次（格式見 Wire.h），依到達順序交給同一個 WorkStealingPool；
+  結果每 chunk 筆送回一個 kResults 訊框（先完成的先送，不等整批），最後送 kDone
+- 背壓：已接收但尚未送出結果的設定筆數（佇列深度）加上新批次超過 max_queued_configs 時，
+  該批次直接回覆 kBusy（附目前深度與上限），不排入佇列；節點的記憶體用量因此有上限
+- Client：一條連線依序送出批次、收回結果；節點忙碌時回傳 BusyError，由呼叫端決定重送或改送其他節點
+- ValidateSharded：以 ShardOf(名稱) 選擇節點（FNV-1a，與程序、平台無關），各節點平行送出；
+  批次同時受筆數（max_batch）與編碼後的大小（wire::kMaxFrameSize）限制，大型設定不會組成節點拒收的訊框；
+  收到 kBusy 時，批次大於上限就縮小批次，否則指數退避後重送；結果依輸入順序排列
+- 位址只接受數字形式的 IPv4（例如 "127.0.0.1"），不做名稱解析
+*/
+
+// 開始命名空間
+namespace service
+{
+	// 節點位址
+	struct Endpoint
+	{
+		std::string   host = "127.0.0.1";
+		std::uint16_t port = 0;
+	};
+
+	// 系統呼叫失敗：呼叫名稱（靜態字面值）與 errno；對方關閉連線時 code 為 0
+	struct NetError
+	{
+		std::string_view op;
+		int              code = 0;
+	};
+
+	// 節點拒收批次（背壓）
+	struct BusyError
+	{
+		std::uint32_t queue_depth = 0;
+		std::uint32_t limit       = 0;
+	};
+
+	// 客戶端可能遇到的錯誤：連線、格式、背壓
+	using ClientError = std::variant<NetError, wire::DecodeError, BusyError>;
+
+	// 每筆設定的管線結果（依輸入順序）
+	using Outcomes = std::vector<wire::Outcome>;
+
+	// 節點參數
+	struct ServerOptions
+	{
+		// 監聽的連接埠；0 由系統指定（以 Server::port() 查詢）
+		std::uint16_t port               = 0;
+		// 執行緒池大小；0 為硬體執行緒數
+		std::size_t   threads            = 0;
+		// 佇列深度上限（設定筆數）
+		std::size_t   max_queued_configs = 1 << 16;
+		// 每個 kResults 訊框的筆數
+		std::size_t   chunk              = 256;
+	};
+
+	// 驗證節點：建立後立即開始接受連線，解構時停止
+	class Server
+	{
+	public:
+		// 建立監聽 socket 與背景執行緒；bind / listen 失敗時回傳 NetError
+		[[nodiscard]] static std::expected<std::unique_ptr<Server>, NetError> Start(const ServerOptions& options = {});
+		~Server();
+
+		Server(const Server&)            = delete;
+		Server& operator=(const Server&) = delete;
+
+		// 停止接受連線、關閉所有連線並等待背景執行緒結束（尚未處理的批次被捨棄）
+		void Stop();
+
+		// 實際監聽的連接埠
+		[[nodiscard]] std::uint16_t port() const noexcept { return port_; }
+		// 目前的佇列深度
+		[[nodiscard]] std::size_t queue_depth() const noexcept { return queued_.load(std::memory_order_relaxed); }
+
+	private:
+		struct Connection;
+		// 一個待處理的批次
+		struct Job
+		{
+			std::shared_ptr<Connection>         connection;
+			std::uint32_t                       id = 0;
+			std::vector<config::BufferedConfig> configs;
+		};
+		// 一條連線與它的讀取執行緒
+		struct Session
+		{
+			std::shared_ptr<Connection> connection;
+			std::thread                 reader;
+		};
+
+		Server(int listen_fd, std::uint16_t port, const ServerOptions& options);
+
+		// 接受連線
+		void AcceptLoop();
+		// 讀取一條連線的批次並排入佇列（或回覆 kBusy）
+		void ReadLoop(std::shared_ptr<Connection> connection);
+		// 依序處理佇列中的批次並送回結果
+		void DispatchLoop();
+
+		int                        listen_fd_ = -1;
+		std::uint16_t              port_      = 0;
+		ServerOptions              options_;
+		config::WorkStealingPool   pool_;
+		// 已接收但尚未送完結果的設定筆數
+		std::atomic<std::size_t>   queued_{0};
+		// 保護以下狀態
+		std::mutex                 mutex_;
+		std::condition_variable    wake_;
+		std::deque<Job>            jobs_;
+		std::vector<Session>       sessions_;
+		bool                       stop_ = false;
+		std::thread                acceptor_;
+		std::thread                dispatcher_;
+	};
+
+	// 一條連到節點的連線（只能移動）
+	class Client
+	{
+	public:
+		[[nodiscard]] static std::expected<Client, NetError> Connect(const Endpoint& endpoint);
+
+		Client(Client&& other) noexcept;
+		Client& operator=(Client&& other) noexcept;
+		~Client();
+
+		// 送出一個批次並等待全部結果；編碼後超過 wire::kMaxFrameSize 時不送出，回傳 NetError（EMSGSIZE）
+		[[nodiscard]] std::expected<Outcomes, ClientError> Validate(std::span<const config::BufferedConfig> configs);
+		// 同上，只送 configs 中的部分項目（結果依 selected 的順序）
+		[[nodiscard]] std::expected<Outcomes, ClientError> Validate(std::span<const config::BufferedConfig* const> selected);
+
+	private:
+		explicit Client(int fd) noexcept : fd_(fd) {}
+
+		int           fd_      = -1;
+		std::uint32_t next_id_ = 1;
+		// 重複使用的收送緩衝區
+		std::string   buffer_;
+	};
+
+	// 名稱 → 節點編號（0 ~ nodes - 1）
+	[[nodiscard]] std::size_t ShardOf(std::string_view name, std::size_t nodes) noexcept;
+
+	// 分片送出的參數
+	struct ShardOptions
+	{
+		// 每個批次最多的筆數（另外以編碼後的大小不超過 wire::kMaxFrameSize 切分）
+		std::size_t max_batch   = 1024;
+		// 節點忙碌時最多重送的次數
+		int         max_retries = 8;
+	};
+
+	// 依名稱雜湊分到 nodes，各節點平行驗證；任何節點失敗時回傳第一個節點的錯誤
+	[[nodiscard]] std::expected<Outcomes, ClientError> ValidateSharded(std::span<const Endpoint> nodes,
+	                                                                   std::span<const config::BufferedConfig> configs,
+	                                                                   const ShardOptions& options = {});
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,158 @@
+// Include Guard：避免重複包含
+#ifndef VARIANT_MERGE_H
+// 與上方成對
+#define VARIANT_MERGE_H
+
+// 編譯期型別清單
+#include "TypeList.h"
+// std::size_t
+#include <cstddef>
+// std::invoke / std::invoke_result_t
+#include <functional>
+// std::remove_cvref_t
+#include <type_traits>
+// std::forward / std::unreachable
+#include <utility>
+// std::variant / std::bad_variant_access
+#include <variant>
+
+/*
+合併不相干的錯誤 variant（例如 config::PipelineError 與 demo 的 Error），不產生巢狀 variant
+- Merge<V...>：把多個 variant（或單一型別）攤平成一個 variant，內層 variant 的成員直接展開，重複的型別只保留一次
+- Widen<To>(from)：把較窄的 variant（可含巢狀 variant）或單一錯誤放進 To；編譯期檢查 To 涵蓋所有成員
+- ConvertVariant<To>(from)：收窄（或任意方向）轉換；目前的成員不在 To 中時擲出 std::bad_variant_access
+- Dispatch(v, f)：以單一 switch 依 index() 分派（取代 std::visit 與巢狀 visit），成員數超過
+  kMaxSwitchAlternatives 時退回 std::visit
+合併後的 variant 只比最大的成員多一個索引，錯誤路徑上不需要第二層 variant，也不需要第二次分派
+*/
+
+// 開始命名空間
+namespace meta
+{
+	// Dispatch 以 switch 展開的最大成員數
+	inline constexpr std::size_t kMaxSwitchAlternatives = 16;
+
+	// 是否為 std::variant
+	template<typename T>
+	inline constexpr bool kIsVariant = false;
+	template<typename... Ts>
+	inline constexpr bool kIsVariant<std::variant<Ts...>> = true;
+
+	// 實作細節
+	namespace detail
+	{
+		// 單一型別 → 清單；variant 遞迴展開
+		template<typename T>
+		struct FlattenOne
+		{
+			using type = TypeList<T>;
+		};
+		template<typename... Ts>
+		struct FlattenOne<std::variant<Ts...>>
+		{
+			using type = Concat<typename FlattenOne<Ts>::type...>;
+		};
+
+		// 清單中的每個型別各自展開後串接
+		template<typename List>
+		struct FlattenImpl;
+		template<typename... Ts>
+		struct FlattenImpl<TypeList<Ts...>>
+		{
+			using type = Concat<typename FlattenOne<Ts>::type...>;
+		};
+
+		// Sub 的每個型別都在 Super 中
+		template<typename Sub, typename Super>
+		inline constexpr bool kSubset = false;
+		template<typename... Ts, typename Super>
+		inline constexpr bool kSubset<TypeList<Ts...>, Super> = (kContains<Super, Ts> && ...);
+	}
+
+	// 攤平：內層 variant 的成員直接展開
+	template<typename List>
+	using Flatten = typename detail::FlattenImpl<List>::type;
+	// 合併多個 variant（或單一型別）成一個攤平、去重的 variant
+	template<typename... Vs>
+	using Merge = AsVariant<Unique<Flatten<TypeList<Vs...>>>>;
+	// From（單一型別或 variant，攤平後）的每個成員都是 To 的成員
+	template<typename From, typename To>
+	inline constexpr bool kWidensTo = detail::kSubset<Flatten<TypeList<From>>, Alternatives<To>>;
+
+	// 依 index() 分派到 f；所有成員呼叫 f 的回傳型別必須相同
+	template<typename Variant, typename F>
+	constexpr decltype(auto) Dispatch(Variant&& v, F&& f)
+	{
+		using V = std::remove_cvref_t<Variant>;
+		constexpr std::size_t kCount = std::variant_size_v<V>;
+		using R = std::invoke_result_t<F, decltype(std::get<0>(std::forward<Variant>(v)))>;
+
+		if constexpr (kCount > kMaxSwitchAlternatives)
+			return std::visit(std::forward<F>(f), std::forward<Variant>(v));
+		else
+		{
+			// 每個 case 在編譯期確認索引；不存在的索引不會走到
+#define META_DISPATCH_CASE(I)                                                                                      \
+			case I:                                                                                                \
+				if constexpr (I < kCount)                                                                          \
+					return static_cast<R>(std::invoke(std::forward<F>(f), std::get<I>(std::forward<Variant>(v)))); \
+				else                                                                                               \
+					std::unreachable();
+			switch (v.index())
+			{
+				META_DISPATCH_CASE(0)  META_DISPATCH_CASE(1)  META_DISPATCH_CASE(2)  META_DISPATCH_CASE(3)
+				META_DISPATCH_CASE(4)  META_DISPATCH_CASE(5)  META_DISPATCH_CASE(6)  META_DISPATCH_CASE(7)
+				META_DISPATCH_CASE(8)  META_DISPATCH_CASE(9)  META_DISPATCH_CASE(10) META_DISPATCH_CASE(11)
+				META_DISPATCH_CASE(12) META_DISPATCH_CASE(13) META_DISPATCH_CASE(14) META_DISPATCH_CASE(15)
+			default:
+				break;
+			}
+#undef META_DISPATCH_CASE
+			// 與 std::visit 相同：valueless_by_exception 的 variant 無法分派
+			throw std::bad_variant_access{};
+		}
+	}
+
+	// 實作細節：Widen / ConvertVariant 共用
+	namespace detail
+	{
+		// kChecked：To 必須涵蓋 From 的所有成員（Widen）；否則不在 To 中的成員於執行期擲出例外（ConvertVariant）
+		template<typename To, bool kChecked, typename From>
+		[[nodiscard]] constexpr To Convert(From&& from)
+		{
+			using Source = std::remove_cvref_t<From>;
+			if constexpr (std::is_same_v<Source, To>)
+				return std::forward<From>(from);
+			else if constexpr (kIsVariant<Source>)
+				return Dispatch(std::forward<From>(from), [](auto&& value) -> To {
+					return Convert<To, kChecked>(std::forward<decltype(value)>(value));
+				});
+			else if constexpr (kContains<Alternatives<To>, Source>)
+				return To{std::in_place_type<Source>, std::forward<From>(from)};
+			else
+			{
+				static_assert(!kChecked, "Widen: target variant does not contain this error type");
+				throw std::bad_variant_access{};
+			}
+		}
+	}
+
+	// 放寬：把錯誤（單一型別、variant 或巢狀 variant）放進較寬的 To
+	template<typename To, typename From>
+	[[nodiscard]] constexpr To Widen(From&& from)
+	{
+		static_assert(kWidensTo<std::remove_cvref_t<From>, To>, "Widen: target variant must contain every alternative");
+		return detail::Convert<To, true>(std::forward<From>(from));
+	}
+
+	// 轉換：型別集合相同時原樣移動；否則 from 目前的成員必須在 To 中
+	// （不在 To 中時擲出 std::bad_variant_access；管線內部只用 Widen，這裡留給呼叫端自行判斷的轉換）
+	template<typename To, typename From>
+	[[nodiscard]] constexpr To ConvertVariant(From&& from)
+	{
+		return detail::Convert<To, false>(std::forward<From>(from));
+	}
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,312 @@
+// 引入對應的宣告標頭
+#include "Wire.h"
+// std::optional（依索引建構錯誤）
+#include <optional>
+// std::index_sequence / std::in_place_index
+#include <utility>
+// std::variant_size_v
+#include <variant>
+
+// 進入命名空間
+namespace wire
+{
+	// 僅供本檔使用
+	namespace
+	{
+		// 位移以 u32 傳送：超出範圍時寫入 kUnknownOffset，不截斷成另一個（錯誤的）位置
+		void Offset(Writer& w, std::size_t offset) { w.U32(offset < kUnknownOffset ? static_cast<std::uint32_t>(offset) : kUnknownOffset); }
+
+		// 錯誤成員的欄位：依宣告順序寫入
+		void WriteFields(Writer& w, const config::ConfigReadError& e)  { w.Str(e.filename); }
+		void WriteFields(Writer& w, const config::ConfigParseError& e) { w.Str(e.line_content); w.I32(e.line_number); Offset(w, e.offset); }
+		void WriteFields(Writer& w, const config::ValidationError& e)  { w.Str(e.field_name); w.Str(e.invalid_value); Offset(w, e.offset); }
+		void WriteFields(Writer& w, const config::ProcessingError& e)  { w.Str(e.task_name); w.Str(e.details); }
+
+		// 依相同順序讀回（之後若還有位元組，是較新版本多出的欄位，略過）
+		void ReadFields(Reader& r, config::ConfigReadError& e)  { e.filename = r.Str(); }
+		void ReadFields(Reader& r, config::ConfigParseError& e) { e.line_content = r.Str(); e.line_number = r.I32(); e.offset = r.U32(); }
+		void ReadFields(Reader& r, config::ValidationError& e)  { e.field_name = r.Str(); e.invalid_value = r.Str(); e.offset = r.U32(); }
+		void ReadFields(Reader& r, config::ProcessingError& e)  { e.task_name = r.Str(); e.details = r.Str(); }
+
+		// 依 variant 索引建構對應的成員並讀取欄位；索引超出範圍時回傳 nullopt
+		template<std::size_t... I>
+		[[nodiscard]] std::optional<config::PipelineError> ReadError(std::size_t index, Reader& r, std::index_sequence<I...>)
+		{
+			std::optional<config::PipelineError> error;
+			((index == I ? (ReadFields(r, std::get<I>(error.emplace(std::in_place_index<I>))), void()) : void()), ...);
+			return error;
+		}
+
+		// 訊框內容必須恰好讀完
+		template<typename T>
+		[[nodiscard]] std::expected<T, DecodeError> Finish(const Reader& r, T&& message)
+		{
+			if (!r.ok())
+				return std::unexpected(DecodeError{r.offset(), "truncated message"});
+			if (r.remaining() != 0)
+				return std::unexpected(DecodeError{r.offset(), "trailing bytes in message"});
+			return std::forward<T>(message);
+		}
+	}
+
+	/*==============================編碼======================================*/
+
+	void Writer::U8(std::uint8_t value)
+	{
+		out_.push_back(static_cast<char>(value));
+	}
+
+	// little-endian：逐位元組寫入，與主機位元組序無關
+	void Writer::U32(std::uint32_t value)
+	{
+		const char bytes[4] = {static_cast<char>(value), static_cast<char>(value >> 8),
+		                       static_cast<char>(value >> 16), static_cast<char>(value >> 24)};
+		out_.append(bytes, sizeof(bytes));
+	}
+
+	void Writer::I32(std::int32_t value)
+	{
+		U32(static_cast<std::uint32_t>(value));
+	}
+
+	void Writer::Str(std::string_view value)
+	{
+		U32(static_cast<std::uint32_t>(value.size()));
+		out_.append(value);
+	}
+
+	void Writer::BeginFrame(Message type)
+	{
+		frame_start_ = out_.size();
+		U32(0);
+		U8(static_cast<std::uint8_t>(type));
+	}
+
+	// 回填長度欄位（不含自身）
+	void Writer::EndFrame()
+	{
+		PatchLength(frame_start_);
+	}
+
+	// at 處的 u32 改為其後到目前結尾的位元組數
+	void Writer::PatchLength(std::size_t at)
+	{
+		const auto length = static_cast<std::uint32_t>(out_.size() - at - kLengthSize);
+		for (std::size_t i = 0; i < kLengthSize; ++i)
+			out_[at + i] = static_cast<char>(length >> (8 * i));
+	}
+
+	// 標記 | 內容長度（先佔位，寫完內容後回填）| 內容
+	void Writer::Record(const Outcome& outcome)
+	{
+		U8(outcome ? 0 : static_cast<std::uint8_t>(1 + outcome.error().index()));
+		const std::size_t length_at = out_.size();
+		U32(0);
+		if (outcome)
+			I32(outcome->final_result_code);
+		else
+			std::visit([this](const auto& error) { WriteFields(*this, error); }, outcome.error());
+		PatchLength(length_at);
+	}
+
+	void AppendBatch(std::string& out, std::uint32_t id, std::span<const config::BufferedConfig> configs)
+	{
+		Writer w(out);
+		w.BeginFrame(Message::kBatch);
+		w.U32(id);
+		w.U32(static_cast<std::uint32_t>(configs.size()));
+		for (const auto& config : configs)
+		{
+			w.Str(config.name);
+			w.Str(config.content);
+		}
+		w.EndFrame();
+	}
+
+	// 分片後只送部分項目：不先複製成新的陣列
+	void AppendBatch(std::string& out, std::uint32_t id, std::span<const config::BufferedConfig* const> selected)
+	{
+		Writer w(out);
+		w.BeginFrame(Message::kBatch);
+		w.U32(id);
+		w.U32(static_cast<std::uint32_t>(selected.size()));
+		for (const auto* config : selected)
+		{
+			w.Str(config->name);
+			w.Str(config->content);
+		}
+		w.EndFrame();
+	}
+
+	void AppendResults(std::string& out, std::uint32_t id, std::uint32_t first, std::span<const Outcome> outcomes)
+	{
+		Writer w(out);
+		w.BeginFrame(Message::kResults);
+		w.U32(id);
+		w.U32(first);
+		w.U32(static_cast<std::uint32_t>(outcomes.size()));
+		for (const auto& outcome : outcomes)
+			w.Record(outcome);
+		w.EndFrame();
+	}
+
+	void AppendDone(std::string& out, const DoneMessage& done)
+	{
+		Writer w(out);
+		w.BeginFrame(Message::kDone);
+		w.U32(done.id);
+		w.U32(done.total);
+		w.EndFrame();
+	}
+
+	void AppendBusy(std::string& out, const BusyMessage& busy)
+	{
+		Writer w(out);
+		w.BeginFrame(Message::kBusy);
+		w.U32(busy.id);
+		w.U32(busy.queue_depth);
+		w.U32(busy.limit);
+		w.EndFrame();
+	}
+
+	/*==============================解碼======================================*/
+
+	// 越界時標記失敗並回傳空檢視
+	std::string_view Reader::Take(std::size_t size) noexcept
+	{
+		if (!ok_ || size > remaining())
+		{
+			ok_ = false;
+			return {};
+		}
+		const std::string_view bytes = in_.substr(offset_, size);
+		offset_ += size;
+		return bytes;
+	}
+
+	std::uint8_t Reader::U8() noexcept
+	{
+		const std::string_view bytes = Take(1);
+		return bytes.empty() ? 0 : static_cast<std::uint8_t>(bytes[0]);
+	}
+
+	std::uint32_t Reader::U32() noexcept
+	{
+		const std::string_view bytes = Take(4);
+		if (bytes.empty())
+			return 0;
+		std::uint32_t value = 0;
+		for (std::size_t i = 0; i < 4; ++i)
+			value |= std::uint32_t{static_cast<unsigned char>(bytes[i])} << (8 * i);
+		return value;
+	}
+
+	std::int32_t Reader::I32() noexcept
+	{
+		return static_cast<std::int32_t>(U32());
+	}
+
+	std::string_view Reader::Str() noexcept
+	{
+		const std::uint32_t size = U32();
+		return Take(size);
+	}
+
+	// 內容在自己的範圍內讀取：欄位不足為錯誤，多出的位元組略過
+	std::expected<Outcome, DecodeError> Reader::Record()
+	{
+		const std::size_t at = offset_;
+		const std::uint8_t tag = U8();
+		const std::string_view payload = Str();
+		if (!ok_)
+			return std::unexpected(DecodeError{at, "truncated record"});
+
+		Reader fields(payload);
+		Outcome outcome;
+		if (tag == 0)
+			outcome = config::Result{fields.I32()};
+		else
+		{
+			constexpr std::size_t kCount = std::variant_size_v<config::PipelineError>;
+			auto error = ReadError(tag - 1u, fields, std::make_index_sequence<kCount>{});
+			if (!error)
+				return std::unexpected(DecodeError{at, "unknown error alternative"});
+			outcome = std::unexpected(std::move(*error));
+		}
+		if (!fields.ok())
+			return std::unexpected(DecodeError{at, "truncated record"});
+		return outcome;
+	}
+
+	// 長度必須至少容納訊息種類，且不超過上限
+	std::expected<std::uint32_t, DecodeError> FrameLength(std::string_view header) noexcept
+	{
+		Reader r(header);
+		const std::uint32_t length = r.U32();
+		if (!r.ok())
+			return std::unexpected(DecodeError{0, "truncated frame header"});
+		if (length == 0 || length > kMaxFrameSize)
+			return std::unexpected(DecodeError{0, "frame length out of range"});
+		return length;
+	}
+
+	std::expected<BatchMessage, DecodeError> ParseBatch(std::string_view body)
+	{
+		Reader r(body);
+		BatchMessage batch;
+		batch.id = r.U32();
+		const std::uint32_t count = r.U32();
+		// 每筆至少 8 個位元組（兩個長度欄位）：先檢查，避免依偽造的筆數預留大量記憶體
+		if (!r.ok() || count > r.remaining() / 8)
+			return std::unexpected(DecodeError{r.offset(), "batch count exceeds message size"});
+		batch.configs.reserve(count);
+		for (std::uint32_t i = 0; i < count && r.ok(); ++i)
+		{
+			const std::string_view name    = r.Str();
+			const std::string_view content = r.Str();
+			batch.configs.push_back({std::string(name), std::string(content)});
+		}
+		return Finish(r, std::move(batch));
+	}
+
+	std::expected<ResultsMessage, DecodeError> ParseResults(std::string_view body)
+	{
+		Reader r(body);
+		ResultsMessage results;
+		results.id    = r.U32();
+		results.first = r.U32();
+		const std::uint32_t count = r.U32();
+		// 每筆至少 5 個位元組（標記 + 長度）
+		if (!r.ok() || count > r.remaining() / 5)
+			return std::unexpected(DecodeError{r.offset(), "result count exceeds message size"});
+		results.outcomes.reserve(count);
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			auto outcome = r.Record();
+			if (!outcome)
+				return std::unexpected(outcome.error());
+			results.outcomes.push_back(std::move(*outcome));
+		}
+		return Finish(r, std::move(results));
+	}
+
+	std::expected<DoneMessage, DecodeError> ParseDone(std::string_view body)
+	{
+		Reader r(body);
+		DoneMessage done;
+		done.id    = r.U32();
+		done.total = r.U32();
+		return Finish(r, std::move(done));
+	}
+
+	std::expected<BusyMessage, DecodeError> ParseBusy(std::string_view body)
+	{
+		Reader r(body);
+		BusyMessage busy;
+		busy.id          = r.U32();
+		busy.queue_depth = r.U32();
+		busy.limit       = r.U32();
+		return Finish(r, std::move(busy));
+	}
+// 結束命名空間
+}
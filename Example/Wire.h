@@ -0,0 +1,170 @@
+// Include Guard：避免重複包含
+#ifndef WIRE_H
+// 與上方成對
+#define WIRE_H
+
+// Result / PipelineError
+#include "Config.h"
+// BufferedConfig（批次內容）
+#include "BatchExecutor.h"
+// std::size_t
+#include <cstddef>
+// 固定寬度整數
+#include <cstdint>
+// std::expected
+#include <expected>
+// 批次與結果的檢視
+#include <span>
+// 編碼輸出
+#include <string>
+// 解碼輸入
+#include <string_view>
+// 批次
+#include <vector>
+
+/*
+驗證服務的線路格式（與主機位元組序無關：所有整數以 little-endian 逐位元組寫入）
+- 訊框：u32 長度（不含自身）| u8 訊息種類 | 內容；長度超過 kMaxFrameSize 的訊框一律拒絕
+- kBatch（客戶端 → 節點）：u32 批次編號 | u32 筆數 | 每筆 str 名稱、str 內容
+- kResults（節點 → 客戶端）：u32 批次編號 | u32 起始索引 | u32 筆數 | 每筆一個結果紀錄；一個批次分成多個 kResults 依序送回
+- kDone：u32 批次編號 | u32 總筆數，表示該批次的結果已全部送出
+- kBusy：u32 批次編號 | u32 目前佇列深度 | u32 佇列上限：節點拒收此批次（背壓），客戶端稍後重送或縮小批次
+- 結果紀錄：u8 標記（0 為成功，1 + i 為 PipelineError 的第 i 個成員）| u32 內容長度 | 內容
+  成功的內容為 i32 結果碼；錯誤的內容為該成員的欄位依宣告順序（str 為 u32 長度 + 位元組，int 為 i32，位移為 u32；
+  u32 容不下的位移寫成 kUnknownOffset）
+  內容有長度前綴：解碼端可以略過看不懂的欄位，結構新增欄位時舊的解碼端仍能讀取
+*/
+
+// 開始命名空間
+namespace wire
+{
+	// 單一訊框的長度上限
+	inline constexpr std::uint32_t kMaxFrameSize  = 64u << 20;
+	// 訊框長度欄位的位元組數
+	inline constexpr std::size_t   kLengthSize    = 4;
+	// 錯誤紀錄中無法以 u32 表示的位移（4 GiB 以上）
+	inline constexpr std::uint32_t kUnknownOffset = 0xFFFFFFFFu;
+
+	// 訊息種類
+	enum class Message : std::uint8_t
+	{
+		kBatch   = 1,
+		kResults = 2,
+		kDone    = 3,
+		kBusy    = 4,
+	};
+
+	// 解碼失敗：位置與原因（原因為靜態字面值）
+	struct DecodeError
+	{
+		std::size_t      offset = 0;
+		std::string_view reason;
+	};
+
+	// 一筆管線結果
+	using Outcome = std::expected<config::Result, config::PipelineError>;
+
+	// 附加到 out 的編碼器
+	class Writer
+	{
+	public:
+		explicit Writer(std::string& out) noexcept : out_(out) {}
+
+		void U8(std::uint8_t value);
+		void U32(std::uint32_t value);
+		void I32(std::int32_t value);
+		// u32 長度 + 位元組
+		void Str(std::string_view value);
+
+		// 開始一個訊框（長度欄位先填 0），EndFrame 時回填
+		void BeginFrame(Message type);
+		void EndFrame();
+
+		// 一筆結果紀錄
+		void Record(const Outcome& outcome);
+
+	private:
+		void PatchLength(std::size_t at);
+
+		std::string& out_;
+		std::size_t  frame_start_ = 0;
+	};
+
+	// 從 in 依序讀取；任何一次讀取越界後 ok() 為 false，之後的讀取都回傳零值
+	class Reader
+	{
+	public:
+		explicit Reader(std::string_view in) noexcept : in_(in) {}
+
+		[[nodiscard]] std::uint8_t     U8() noexcept;
+		[[nodiscard]] std::uint32_t    U32() noexcept;
+		[[nodiscard]] std::int32_t     I32() noexcept;
+		// 檢視 in 內的位元組（生命週期與 in 相同）
+		[[nodiscard]] std::string_view Str() noexcept;
+
+		// 一筆結果紀錄
+		[[nodiscard]] std::expected<Outcome, DecodeError> Record();
+
+		[[nodiscard]] bool        ok() const noexcept { return ok_; }
+		[[nodiscard]] std::size_t offset() const noexcept { return offset_; }
+		[[nodiscard]] std::size_t remaining() const noexcept { return in_.size() - offset_; }
+
+	private:
+		[[nodiscard]] std::string_view Take(std::size_t size) noexcept;
+
+		std::string_view in_;
+		std::size_t      offset_ = 0;
+		bool             ok_     = true;
+	};
+
+	// 讀取訊框標頭：header 為前 kLengthSize 個位元組，回傳內容長度（含訊息種類）
+	[[nodiscard]] std::expected<std::uint32_t, DecodeError> FrameLength(std::string_view header) noexcept;
+
+	// 各訊息的內容（不含訊框長度與訊息種類）
+	struct BatchMessage
+	{
+		std::uint32_t                       id = 0;
+		std::vector<config::BufferedConfig> configs;
+	};
+	struct ResultsMessage
+	{
+		std::uint32_t        id    = 0;
+		std::uint32_t        first = 0;
+		std::vector<Outcome> outcomes;
+	};
+	struct DoneMessage
+	{
+		std::uint32_t id    = 0;
+		std::uint32_t total = 0;
+	};
+	struct BusyMessage
+	{
+		std::uint32_t id          = 0;
+		std::uint32_t queue_depth = 0;
+		std::uint32_t limit       = 0;
+	};
+
+	// kBatch 訊框內容（不含長度欄位）中各筆設定以外的位元組數：訊息種類、批次編號、筆數
+	inline constexpr std::size_t kBatchOverhead = 1 + 4 + 4;
+	// 一筆設定在 kBatch 訊框中的位元組數；整個訊框為 kBatchOverhead 加上各筆的總和，不可超過 kMaxFrameSize
+	[[nodiscard]] inline std::size_t BatchEntrySize(const config::BufferedConfig& config) noexcept
+	{
+		return 4 + config.name.size() + 4 + config.content.size();
+	}
+
+	// 編碼成完整訊框（附加到 out）
+	void AppendBatch(std::string& out, std::uint32_t id, std::span<const config::BufferedConfig> configs);
+	void AppendBatch(std::string& out, std::uint32_t id, std::span<const config::BufferedConfig* const> selected);
+	void AppendResults(std::string& out, std::uint32_t id, std::uint32_t first, std::span<const Outcome> outcomes);
+	void AppendDone(std::string& out, const DoneMessage& done);
+	void AppendBusy(std::string& out, const BusyMessage& busy);
+
+	// 解碼訊框內容（訊息種類之後的位元組）；內容必須恰好用完
+	[[nodiscard]] std::expected<BatchMessage, DecodeError>   ParseBatch(std::string_view body);
+	[[nodiscard]] std::expected<ResultsMessage, DecodeError> ParseResults(std::string_view body);
+	[[nodiscard]] std::expected<DoneMessage, DecodeError>    ParseDone(std::string_view body);
+	[[nodiscard]] std::expected<BusyMessage, DecodeError>    ParseBusy(std::string_view body);
+// 結束命名空間
+}
+
+#endif
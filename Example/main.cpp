@@ -1,19 +1,53 @@
 // 引入我們的工具標頭（宣告）
 #include "Config_Processing_Utils.h"
+// 引入批次管線執行器
+#include "BatchExecutor.h"
+// 引入編譯期組合的管線
+#include "Pipeline.h"
+// 引入協程管線與事件迴圈
+#include "IoContext.h"
+// 引入錯誤訊息格式化
+#include "ErrorFormat.h"
+// 引入故障注入與負載產生器
+#include "FaultInjection.h"
+#include "LoadGenerator.h"
+// 引入日誌後端（負載產生期間換成不輸出的後端）
+#include "Log.h"
+// 引入分散式驗證服務（--serve 節點模式與情境十）
+#include "ValidationService.h"
+// 引入 std::chrono（負載產生器每一輪的長度）
+#include <chrono>
+// 引入 <csignal> 以等待 SIGINT / SIGTERM（節點模式）
+#include <csignal>
 // 引入 <cstdio> 以使用 std::remove 刪除檔案
 #include <cstdio>
+// 引入 <cstdlib> 以使用 std::strtoul 解析連接埠
+#include <cstdlib>
 // 引入 <fstream> 以使用 std::ofstream 建立示範檔案
 #include <fstream>
 // 引入標準輸出入（顯示結果）
 #include <iostream>
+// 引入 std::ostreambuf_iterator（錯誤訊息直接寫進串流）
+#include <iterator>
+// 引入 std::ostringstream（情境十把檔案內容讀進記憶體）
+#include <sstream>
 // 引入 std::string
 #include <string>
-// 引入 std::variant（搭配 std::visit）
-#include <variant>
+// 引入 std::forward
+#include <utility>
+// 引入 std::vector（批次路徑）
+#include <vector>
 
 // 使用命名空間
 using namespace config;
 
+// 轉發式階段：and_then 作用在暫存的 expected 上時會傳入右值，
+// 因此會自動選到 ValidateData(Config&&) / ProcessData(ValidatedData&&)，沿用同一塊緩衝區
+static constexpr auto Validate = [](auto&& cfg) { return ValidateData(std::forward<decltype(cfg)>(cfg)); };
+static constexpr auto Process  = [](auto&& vd)  { return ProcessData(std::forward<decltype(vd)>(vd)); };
+// 編譯期組合的完整管線：讀檔 → 驗證 → 處理，錯誤型別由各階段的錯誤清單算出
+static constexpr ConfigPipeline kPipeline{};
+
 // 宣告一個輔助函式：負責把最終結果（成功或錯誤）輸出到主控台
 static void HandlePipelineResult(const std::expected<Result, PipelineError>& r) 
 {
@@ -27,59 +61,61 @@ static void HandlePipelineResult(const std::expected<Result, PipelineError>& r)
     }
     // 否則為失敗：先輸出前綴訊息
     std::cerr << "\nPipeline Failed! Error details: ";
-    // 使用 std::visit 根據實際錯誤型別分派處理
-    std::visit(Overloaded{
-        // 若為讀檔錯誤
-        [](const ConfigReadError& e) 
-		{
-            // 印出檔名
-            std::cerr << "Configuration Read Error: Could not open file '" << e.filename << "'\n";
-        },
-        // 若為解析錯誤
-        [](const ConfigParseError& e) 
-		{
-            // 印出行號與片段
-            std::cerr << "Configuration Parse Error: Malformed content at line "
-                      << e.line_number << " (Context: '" << e.line_content << "')\n";
-        },
-        // 若為驗證錯誤
-        [](const ValidationError& e) 
-		{
-            // 印出欄位與不合法值
-            std::cerr << "Data Validation Error: Field '" << e.field_name
-                      << "' has invalid value '" << e.invalid_value << "'\n";
-        },
-        // 若為處理錯誤
-        [](const ProcessingError& e) 
-		{
-            // 印出任務名稱與細節
-            std::cerr << "Data Processing Error: Task '" << e.task_name
-                      << "' failed. Details: " << e.details << '\n';
-        }
-        // Overloaded 結束
-    }, r.error());
+    // 報告時才格式化：訊息直接寫進 std::cerr，不先組出中間字串
+    FormatTo(std::ostreambuf_iterator<char>(std::cerr), r.error());
+    std::cerr << '\n';
+}
+
+// 節點模式：在 port 上提供驗證服務，直到收到 SIGINT / SIGTERM
+static int Serve(std::uint16_t port) 
+{
+    // 先封鎖訊號再建立執行緒：所有執行緒繼承此遮罩，訊號只由 sigwait 接收
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    auto server = service::Server::Start(service::ServerOptions{port});
+    if (!server) 
+    {
+        std::cerr << "validation node: " << server.error().op << " failed, errno " << server.error().code << '\n';
+        return 1;
+    }
+    std::cout << "validation node listening on port " << (*server)->port() << std::endl;
+    int received = 0;
+    sigwait(&signals, &received);
+    // 停止接受連線並等待背景執行緒結束
+    (*server)->Stop();
+    return 0;
 }
 
 // 主程式進入點
-int main() 
+int main(int argc, char** argv) 
 {
+    // 故障注入由外部設定（CONFIG_FAULT_PLAN，需以 -DCONFIG_FAULTS=1 建置）；規格有誤時直接結束
+    if (auto plan = fault::ConfigureFromEnvironment(); !plan) 
+    {
+        std::cerr << fault::kPlanVariable << ": " << plan.error().reason << " at offset " << plan.error().offset << '\n';
+        return 1;
+    }
+    // 節點模式：main --serve PORT
+    if (argc == 3 && std::string_view(argv[1]) == "--serve") 
+        return Serve(static_cast<std::uint16_t>(std::strtoul(argv[2], nullptr, 10)));
+
     // 情境一：成功案例
     std::cout << "--- Scenario 1: Successful Execution ---" << std::endl;
     // 建立一個內容充分的合法設定檔
     std::ofstream("valid_config.txt") << "valid_data_content";
-    // 建立管線：讀檔 → 驗證 → 處理；任何一步錯誤，後續 and_then 不會執行
-    auto ok = LoadConfig("valid_config.txt")
-            .and_then([](const Config& cfg){ return ValidateData(cfg); })
-            .and_then([](const ValidatedData& vd){ return ProcessData(vd); });
+    // 執行管線：讀檔 → 驗證 → 處理；任何一步錯誤，後續階段不會執行
+    auto ok = kPipeline("valid_config.txt");
     // 輸出此情境的結果
     HandlePipelineResult(ok);
 
     // 情境二：讀檔錯誤（檔案不存在）
     std::cout << "\n--- Scenario 2: Config Read Error ---" << std::endl;
     // 嘗試讀取不存在的檔案，將直接得到 ConfigReadError
-    auto rerr = LoadConfig("non_existent_config.txt")
-              .and_then([](const Config& cfg){ return ValidateData(cfg); })
-              .and_then([](const ValidatedData& vd){ return ProcessData(vd); });
+    auto rerr = kPipeline("non_existent_config.txt");
     // 輸出此情境的結果
     HandlePipelineResult(rerr);
 
@@ -88,9 +124,7 @@ int main()
     // 建立一個包含 "malformed" 的檔案
     std::ofstream("malformed_config.txt") << "malformed content";
     // 讀檔後將在 LoadConfig 階段回傳 ConfigParseError
-    auto perr = LoadConfig("malformed_config.txt")
-              .and_then([](const Config& cfg){ return ValidateData(cfg); })
-              .and_then([](const ValidatedData& vd){ return ProcessData(vd); });
+    auto perr = kPipeline("malformed_config.txt");
     // 輸出此情境的結果
     HandlePipelineResult(perr);
 
@@ -99,9 +133,7 @@ int main()
     // 建立一個在後續驗證會失敗的檔案
     std::ofstream("invalid_data_config.txt") << "valid_data\ninvalid_field";
     // 讀檔成功，但 ValidateData 會回傳 ValidationError
-    auto verr = LoadConfig("invalid_data_config.txt")
-              .and_then([](const Config& cfg){ return ValidateData(cfg); })
-              .and_then([](const ValidatedData& vd){ return ProcessData(vd); });
+    auto verr = kPipeline("invalid_data_config.txt");
     // 輸出此情境的結果
     HandlePipelineResult(verr);
 
@@ -110,12 +142,86 @@ int main()
     // 建立一個字串過短的檔案
     std::ofstream("short_data_config.txt") << "short";
     // 讀檔、驗證通過，但 ProcessData 會因長度不足回錯誤
-    auto perr2 = LoadConfig("short_data_config.txt")
-               .and_then([](const Config& cfg){ return ValidateData(cfg); })
-               .and_then([](const ValidatedData& vd){ return ProcessData(vd); });
+    auto perr2 = kPipeline("short_data_config.txt");
     // 輸出此情境的結果
     HandlePipelineResult(perr2);
 
+    // 情境六：mmap 零複製讀檔模式（合法內容，與情境一相同結果）
+    std::cout << "\n--- Scenario 6: Memory-Mapped Load ---" << std::endl;
+    // 直接在映射記憶體上檢查與驗證，不先複製整份檔案
+    auto mapped = LoadConfigMapped("valid_config.txt")
+                .and_then(Validate)
+                .and_then(Process);
+    // 輸出此情境的結果
+    HandlePipelineResult(mapped);
+
+    // 情境七：批次執行（多個檔案平行跑完整管線，結果依輸入順序）
+    std::cout << "\n--- Scenario 7: Parallel Batch ---" << std::endl;
+    // 前面情境建立的檔案一次丟進批次執行器
+    const std::vector<std::string> batch{"valid_config.txt", "non_existent_config.txt",
+                                         "malformed_config.txt", "invalid_data_config.txt"};
+    // 逐一輸出每個檔案的結果
+    for (const auto& r : RunBatch(batch, BatchOptions{2}))
+        HandlePipelineResult(r);
+
+    // 情境八：協程管線（同一個事件迴圈上同時跑多條，I/O 不阻塞執行緒）
+    std::cout << "\n--- Scenario 8: Coroutine Pipeline ---" << std::endl;
+    // 建立事件迴圈（io_uring 不可用時自動改為同步 I/O）
+    coro::IoContext io;
+    // 每個檔案一條管線，全部排入後一次執行
+    std::vector<coro::Task<Result>> tasks;
+    for (const auto& path : batch)
+    {
+        tasks.push_back(coro::RunPipelineAsync(io, path));
+        io.Post(tasks.back().handle());
+    }
+    io.Run();
+    // 依輸入順序輸出
+    for (auto& task : tasks)
+        HandlePipelineResult(std::move(task).result());
+
+    // 情境九：負載產生（固定速率、兩個執行緒；以 -DCONFIG_FAULTS=1 建置時依序注入 0% / 1% / 10% / 50% 的驗證錯誤）
+    std::cout << "\n--- Scenario 9: Load Generator ---" << std::endl;
+    // 量測期間不輸出逐筆日誌（否則量到的是終端機輸出的速度）
+    struct QuietSink : logging::Sink 
+    {
+        void Write(logging::Level, std::string_view, std::string_view) override {}
+    } quiet;
+    logging::SetSink(&quiet);
+    // 每個錯誤比例跑 200 毫秒，比較吞吐量與 p99
+    const double ratios[] = {0.0, 0.01, 0.1, 0.5};
+    const auto reports = load::SweepErrorRatios(load::Options{20000, 2, std::chrono::milliseconds(200)}, "valid_config.txt",
+                                                fault::Stage::kValidateData, ErrorKind::kValidation, ratios);
+    // 恢復預設的日誌後端
+    logging::SetSink(nullptr);
+    load::WriteReports(std::cout, reports);
+
+    // 情境十：分散式驗證（同一程序內啟動兩個節點，依名稱雜湊分片送出，結果依輸入順序）
+    std::cout << "\n--- Scenario 10: Sharded Validation Service ---" << std::endl;
+    auto first  = service::Server::Start();
+    auto second = service::Server::Start();
+    if (!first || !second) 
+    {
+        std::cerr << "validation node failed to start\n";
+        return 1;
+    }
+    const service::Endpoint nodes[] = {{"127.0.0.1", (*first)->port()}, {"127.0.0.1", (*second)->port()}};
+    // 節點收到的是內容：先把檔案讀進記憶體
+    std::vector<BufferedConfig> contents;
+    for (const char* path : {"valid_config.txt", "malformed_config.txt", "invalid_data_config.txt", "short_data_config.txt"}) 
+    {
+        std::ostringstream text;
+        text << std::ifstream(path).rdbuf();
+        contents.push_back({path, std::move(text).str()});
+    }
+    if (auto outcomes = service::ValidateSharded(nodes, contents); outcomes) 
+    {
+        for (const auto& r : *outcomes) 
+            HandlePipelineResult(r);
+    }
+    else 
+        std::cerr << "sharded validation failed (alternative " << outcomes.error().index() << ")\n";
+
     // 清理測試檔案（避免殘留）
     std::remove("valid_config.txt");
     std::remove("malformed_config.txt");
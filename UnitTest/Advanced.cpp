@@ -1,108 +1,15 @@
 #include <gtest/gtest.h>
 
-#include <expected>
 #include <filesystem>
 #include <fstream>
-#include <iterator>     // ← 使用 istreambuf_iterator 需要此標頭
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <variant>
 
-// 1. 定義 錯誤類型 & 錯誤回傳內容
-
-struct FileNotFoundError   { std::string path; };
-struct PermissionError     { std::string path; };
-struct IOError             { std::string path; std::string op; };
-struct BadFormatError      { std::string reason; int line; };
-struct MemoryError         { std::string reason; };
-struct TooManyOpenFiles    { int limit; };
-
-
-// 2. 串接 錯誤類型
-using Error = std::variant<
-  FileNotFoundError, PermissionError, IOError,
-  BadFormatError, MemoryError, TooManyOpenFiles
->;
-
-// 建立 Visitor helper
-template<class... Ts>
-struct Overloaded : Ts... { using Ts::operator()...; };
-template<class... Ts>
-Overloaded(Ts...) -> Overloaded<Ts...>;
-
-
-// 3. 建立“被測”對象
-namespace demo
-{
-    // 縮寫
-    namespace fs = std::filesystem;
-
-    // 功能: 讀取所有檔案
-    // 若檔名含 "PERM_DENIED" 則 PermissionError；
-    // 若檔案內容含 "TRIGGER_IO_ERROR" → IOError（模擬）
-    [[nodiscard]] std::expected<std::string, Error> ReadAll(const fs::path& p)
-    {
-        const auto fname = p.filename().string();
-
-        // 檔案不存在
-        if (!fs::exists(p))
-            return std::unexpected(FileNotFoundError{p.string()});
-
-        // 檔名帶有 PERM_DENIED → 模擬權限被拒
-        if (fname.find("PERM_DENIED") != std::string::npos)
-            return std::unexpected(PermissionError{p.string()});
-
-        // 嘗試開檔
-        std::ifstream fin(p, std::ios::binary);
-        if (!fin.is_open())
-            return std::unexpected(IOError{p.string(), "open"});
-
-        // 讀取內容
-        std::string content{std::istreambuf_iterator<char>(fin), {}};
-
-        // 檢查讀取狀態：若既非 good 亦非 EOF，視為 I/O 錯誤
-        if (!fin.good() && !fin.eof())
-            return std::unexpected(IOError{p.string(), "read"});
-
-        // 內容含 TRIGGER_IO_ERROR → 模擬讀取錯誤
-        if (content.find("TRIGGER_IO_ERROR") != std::string::npos)
-            return std::unexpected(IOError{p.string(), "read (simulated)"});
-
-        return content;
-    }
-
-    // 功能: 解析檔案
-    // 內容含 "MALFORMED" → BadFormatError
-    // 若字數超過 1024 → MemoryError（模擬 out-of-memory）
-    [[nodiscard]] std::expected<std::string, Error> ParseConfig(std::string content)
-    {
-        if (content.find("MALFORMED") != std::string::npos)
-            return std::unexpected(BadFormatError{"MALFORMED token", 1});
-
-        if (content.size() > 1024)
-            return std::unexpected(MemoryError{"simulated out-of-memory"});
-
-        // 模擬解析（做一點點轉換，實務上可忽略）
-        for (char &c : content)
-            c = (c == 0) ? c : static_cast<char>(c - 1);
-
-        return content;
-    }
-
-    // 模擬「同時開太多檔案」
-    [[nodiscard]] std::expected<void, Error> SimulateOpenMany(int count, int limit = 1024)
-    {
-        if (count >= limit)
-            return std::unexpected(TooManyOpenFiles{limit});
-        return {};
-    }
-
-    // 建立 Pipeline：Read → Parse
-    [[nodiscard]] std::expected<std::string, Error> LoadAndParse(const fs::path& p)
-    {
-        return ReadAll(p).and_then(ParseConfig);
-    }
-}
+#include "Demo.h"     // 1~3. 錯誤類型、Visitor helper、demo 管線
+#include "Config.h"         // config::PipelineError（與 demo 的 Error 合併）
+#include "VariantMerge.h"   // 錯誤 variant 攤平合併、放寬與 switch 分派
 
 // ---------------------------
 // 4. 建立 Google 測試 Fixture
@@ -226,7 +133,182 @@ TEST_F(ErrorCasesTest, HappyPath)
     EXPECT_EQ(*r, "GDKKN");
 }
 
-// 編譯指令: g++ -std=gnu++23 Advance.cpp -lgtest_main -lgtest -pthread -o advance_tests
+// G. 讀檔時的單次掃描同時標出兩種哨兵，ParseConfig 直接使用結果
+TEST_F(ErrorCasesTest, SingleScan_Finds_All_Sentinels)
+{
+    auto path = make_file("scan.json", "abc MALFORMED");
+    auto r = demo::ReadAllScanned(path);
+
+    ASSERT_TRUE(r.has_value());
+    EXPECT_FALSE(r->scan.Contains(demo::kTriggerIOError));
+    EXPECT_EQ(r->scan.First(demo::kMalformed), 4u);
+
+    auto parsed = demo::ParseConfig(std::move(*r));
+    ASSERT_FALSE(parsed.has_value());
+    EXPECT_TRUE(std::holds_alternative<BadFormatError>(parsed.error()));
+}
+
+// H. BadFormat 回報 MALFORMED 實際所在行
+TEST_F(ErrorCasesTest, BadFormat_Reports_Real_Line)
+{
+    auto path = make_file("bad_line.json", "line1\nline2\nMALFORMED here\n");
+    auto r = demo::LoadAndParse(path);
+
+    ASSERT_FALSE(r.has_value());
+    std::visit(Overloaded{
+        [&](const BadFormatError& e) { EXPECT_EQ(e.line, 3); },
+        [&](const auto&) { ADD_FAILURE() << "預期 BadFormatError。"; }
+    }, r.error());
+}
+
+// I. 串流：超過 1024 字仍可處理，輸出與整檔轉換一致
+TEST_F(ErrorCasesTest, Stream_Large_Input_Succeeds)
+{
+    const std::string content(5000, 'b');
+    auto path = make_file("stream_ok.json", content);
+
+    std::string out;
+    auto r = demo::StreamLoadAndParse(path, [&](std::string_view chunk) { out.append(chunk); },
+                                      demo::StreamOptions{.chunk_size = 512, .memory_budget = 1024});
+
+    ASSERT_TRUE(r.has_value());
+    EXPECT_EQ(*r, content.size());
+    EXPECT_EQ(out, std::string(5000, 'a'));
+}
+
+// J. 串流：切在區塊邊界上的哨兵仍被偵測，並回報正確行號
+TEST_F(ErrorCasesTest, Stream_Sentinel_Across_Chunks)
+{
+    // "MALFORMED" 起於位移 14，chunk_size 8 會把它切成兩半
+    auto path = make_file("stream_bad.json", "line1\nline2\nabMALFORMED\n");
+    auto r = demo::StreamLoadAndParse(path, [](std::string_view) {},
+                                      demo::StreamOptions{.chunk_size = 8, .memory_budget = 64});
+
+    ASSERT_FALSE(r.has_value());
+    std::visit(Overloaded{
+        [&](const BadFormatError& e) { EXPECT_EQ(e.line, 3); },
+        [&](const auto&) { ADD_FAILURE() << "預期 BadFormatError。"; }
+    }, r.error());
+}
+
+// K. 串流：區塊大小超過記憶體上限 → MemoryError
+TEST_F(ErrorCasesTest, Stream_Chunk_Over_Budget)
+{
+    auto path = make_file("stream_budget.json", "ok");
+    auto r = demo::StreamLoadAndParse(path, [](std::string_view) {},
+                                      demo::StreamOptions{.chunk_size = 4096, .memory_budget = 1024});
+
+    ASSERT_FALSE(r.has_value());
+    EXPECT_TRUE(std::holds_alternative<MemoryError>(r.error()));
+}
+
+// L. 每個可用的 SIMD 實作與純量結果一致（含 0 位元組與各種尾端長度）
+TEST_F(ErrorCasesTest, ByteTransform_Kernels_Match_Scalar)
+{
+    std::string input;
+    for (int i = 0; i < 300; ++i)
+        input.push_back(static_cast<char>((i * 37) % 256));
+
+    for (std::size_t len : {0u, 1u, 15u, 16u, 31u, 33u, 63u, 64u, 65u, 300u})
+    {
+        std::string expected = input.substr(0, len);
+        bytes::OffsetNonZero(bytes::Isa::kScalar, expected, -1);
+
+        for (auto isa : {bytes::Isa::kSse2, bytes::Isa::kAvx2, bytes::Isa::kAvx512, bytes::Isa::kNeon})
+        {
+            if (!bytes::Supported(isa))
+                continue;
+            std::string got = input.substr(0, len);
+            bytes::OffsetNonZero(isa, got, -1);
+            EXPECT_EQ(got, expected) << bytes::ToString(isa) << " len=" << len;
+        }
+
+        // 複製版本：原始輸入不變
+        std::string out(len, '\x7f');
+        bytes::OffsetNonZero(std::string_view(input).substr(0, len), out, -1);
+        EXPECT_EQ(out, expected);
+    }
+}
+
+// M. 快取讀檔：錯誤語意與未快取版本相同，第二次讀取不再讀檔
+TEST_F(ErrorCasesTest, Cached_LoadAndParse_Matches_Uncached)
+{
+    filecache::FileCache cache(demo::Sentinels());
+
+    auto ok = make_file("cached_ok.json", "bbb");
+    auto r1 = demo::LoadAndParse(cache, ok);
+    auto r2 = demo::LoadAndParse(cache, ok);
+    ASSERT_TRUE(r1.has_value());
+    ASSERT_TRUE(r2.has_value());
+    EXPECT_EQ(*r1, "aaa");
+    EXPECT_EQ(*r2, "aaa");
+    EXPECT_EQ(cache.stats().hits, 1u);
+
+    auto io = make_file("cached_io.json", "TRIGGER_IO_ERROR");
+    EXPECT_TRUE(std::holds_alternative<IOError>(demo::LoadAndParse(cache, io).error()));
+    EXPECT_TRUE(std::holds_alternative<FileNotFoundError>(demo::LoadAndParse(cache, "no_such_file.json").error()));
+}
+
+// N. 真正的 EMFILE：開檔數上限用盡時 ReadAll 回報 TooManyOpenFiles（而非 IOError）
+TEST_F(ErrorCasesTest, ReadAll_Maps_EMFILE_To_TooManyOpenFiles)
+{
+    auto path = make_file("emfile.json", "ok");
+
+    ::rlimit saved{};
+    ASSERT_EQ(::getrlimit(RLIMIT_NOFILE, &saved), 0);
+    // 只允許 fd 0 ~ 2：下一次 open 必定 EMFILE
+    ::rlimit tight = saved;
+    tight.rlim_cur = 3;
+    ASSERT_EQ(::setrlimit(RLIMIT_NOFILE, &tight), 0);
+    auto r = demo::ReadAll(path);
+    ::setrlimit(RLIMIT_NOFILE, &saved);
+
+    ASSERT_FALSE(r.has_value());
+    std::visit(Overloaded{
+        [&](const TooManyOpenFiles& e) { EXPECT_EQ(e.limit, 3); },
+        [&](const auto&) { ADD_FAILURE() << "預期 TooManyOpenFiles。"; }
+    }, r.error());
+}
+
+// S. 合併 config::PipelineError 與 demo 的 Error：單層 variant、放寬不需轉換程式、switch 分派
+TEST_F(ErrorCasesTest, MergedErrors_Are_Flat_And_Widen_Without_Nesting)
+{
+    using AnyError = meta::Merge<config::PipelineError, Error>;
+    static_assert(std::variant_size_v<AnyError> == 10);
+    // 巢狀 variant 攤平、重複成員只保留一次，結果相同
+    static_assert(std::is_same_v<meta::Merge<std::variant<config::PipelineError, Error>, IOError>, AnyError>);
+    static_assert(meta::kWidensTo<Error, AnyError> && !meta::kWidensTo<AnyError, Error>);
+
+    // demo 管線的錯誤與 config 的錯誤都直接放進同一個 variant
+    auto demo_error = demo::LoadAndParse(dir / "missing.json");
+    ASSERT_FALSE(demo_error.has_value());
+    const AnyError from_demo = meta::Widen<AnyError>(std::move(demo_error).error());
+    ASSERT_TRUE(std::holds_alternative<FileNotFoundError>(from_demo));
+    EXPECT_EQ(std::get<FileNotFoundError>(from_demo).path, (dir / "missing.json").string());
+
+    const AnyError from_config = meta::Widen<AnyError>(config::PipelineError{config::ValidationError{"f", "v"}});
+    ASSERT_TRUE(std::holds_alternative<config::ValidationError>(from_config));
+    EXPECT_EQ(std::get<config::ValidationError>(from_config).field_name, "f");
+
+    // 巢狀 variant 的值直接落到攤平後的成員
+    const std::variant<config::PipelineError, Error> nested{Error{IOError{"p", "read"}}};
+    const AnyError flat = meta::Widen<AnyError>(nested);
+    ASSERT_TRUE(std::holds_alternative<IOError>(flat));
+    EXPECT_EQ(std::get<IOError>(flat).op, "read");
+
+    // Dispatch 與 std::visit 結果相同
+    const auto name = Overloaded{
+        [](const FileNotFoundError&)       { return std::string_view{"not found"}; },
+        [](const config::ValidationError&) { return std::string_view{"validation"}; },
+        [](const IOError&)                 { return std::string_view{"io"}; },
+        [](const auto&)                    { return std::string_view{"other"}; },
+    };
+    for (const AnyError* e : {&from_demo, &from_config, &flat})
+        EXPECT_EQ(meta::Dispatch(*e, name), std::visit(name, *e));
+    EXPECT_EQ(meta::Dispatch(AnyError{TooManyOpenFiles{8}}, name), "other");
+}
+
+// 編譯指令: g++ -std=gnu++23 Advanced.cpp Scanner.cpp ByteTransform.cpp FileCache.cpp MemoryPolicy.cpp -I. -lgtest_main -lgtest -pthread -o advance_tests
 // 執行指令: ./advance_tests
 // 結果
 /*
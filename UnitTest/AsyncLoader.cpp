@@ -0,0 +1,393 @@
+// 引入對應的宣告標頭
+#include "AsyncLoader.h"
+// io_uring 包裝（CONFIG_HAS_IO_URING）
+#include "IoRing.h"
+// 可在編譯期移除的階段量測
+#include "Metrics.h"
+// std::min / std::max
+#include <algorithm>
+// errno
+#include <cerrno>
+// std::uintptr_t
+#include <cstdint>
+// 退避等待
+#include <chrono>
+// 待開檔的索引佇列
+#include <deque>
+// std::unique_ptr
+#include <memory>
+// 退避等待
+#include <thread>
+// std::move
+#include <utility>
+// POSIX：open / AT_FDCWD
+#include <fcntl.h>
+// POSIX：fstat
+#include <sys/stat.h>
+// POSIX：read / close
+#include <unistd.h>
+
+// 進入命名空間
+namespace config
+{
+	// 僅供本檔使用的工具
+	namespace
+	{
+		// 沒有任何進行中的檔案可等待時，開檔連續遇到 EMFILE 的重試上限
+		constexpr int kMaxIdleOpenRetries = 20;
+
+		// 檔案描述子用盡：視為背壓
+		[[nodiscard]] bool IsFdPressure(int error) noexcept
+		{
+			return error == EMFILE || error == ENFILE;
+		}
+
+		// 沒有進行中的檔案可等待時的退避：1、2、4 … 毫秒（上限 64 毫秒）
+		void Backoff(int attempt)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1 << std::min(attempt, 6)));
+		}
+
+		// 讀入內容之後的管線：與 RunBatch 相同的三個階段（各自包上量測）
+		[[nodiscard]] std::expected<Result, PipelineError> RunPipeline(const std::string& path, std::string content)
+		{
+			const auto load     = metrics::Instrument(metrics::Stage::kLoadConfig,
+			                                          [&](std::string&& c) { return LoadConfigFromBuffer(path, std::move(c)); });
+			const auto validate = metrics::Instrument(metrics::Stage::kValidateData,
+			                                          [](Config&& cfg) { return ValidateData(std::move(cfg)); });
+			const auto process  = metrics::Instrument(metrics::Stage::kProcessData,
+			                                          [](ValidatedData&& vd) { return ProcessData(std::move(vd)); });
+			return load(std::move(content)).and_then(validate).and_then(process);
+		}
+
+		// 一個分片：索引 first, first + stride, … 的路徑，由單一執行緒處理
+		struct Shard
+		{
+			std::span<const std::string>                        paths;
+			std::size_t                                         first  = 0;
+			std::size_t                                         stride = 1;
+			// 此分片同時開著的檔案數上限
+			std::size_t                                         cap    = 1;
+			std::vector<std::expected<Result, PipelineError>>&  results;
+			AsyncLoadStats&                                     stats;
+
+			// 寫入結果格並累計（每格只由此分片寫入）
+			void Record(std::size_t index, std::expected<Result, PipelineError> r)
+			{
+				if (r)
+					++stats.batch.succeeded;
+				else
+					++stats.batch.errors_by_index[r.error().index()];
+				results[index] = std::move(r);
+			}
+
+			// 讀檔失敗：與 LoadConfig 一致，回報 ConfigReadError
+			void Fail(std::size_t index)
+			{
+				Record(index, std::unexpected(ConfigReadError{paths[index]}));
+			}
+		};
+
+		// 阻塞式讀取已開啟的檔案：fstat 預先配置，短讀時接續；失敗回傳 false
+		[[nodiscard]] bool ReadOpened(int fd, std::string& content)
+		{
+			struct stat st{};
+			if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+				return false;
+			content.resize(static_cast<std::size_t>(st.st_size));
+			std::size_t filled = 0;
+			while (filled < content.size())
+			{
+				const ::ssize_t got = ::read(fd, content.data() + filled, content.size() - filled);
+				if (got < 0 && errno == EINTR)
+					continue;
+				if (got < 0)
+					return false;
+				if (got == 0)
+					break;
+				filled += static_cast<std::size_t>(got);
+			}
+			content.resize(filled);
+			return true;
+		}
+
+		// 退回方案：逐檔阻塞讀取（一次只開一個檔），EMFILE 時退避重試
+		void RunBlockingShard(Shard& shard)
+		{
+			shard.stats.peak_in_flight = std::max<std::size_t>(shard.stats.peak_in_flight, 1);
+			for (std::size_t i = shard.first; i < shard.paths.size(); i += shard.stride)
+			{
+				int fd = -1;
+				for (int attempt = 0;; ++attempt)
+				{
+					fd = ::open(shard.paths[i].c_str(), O_RDONLY | O_CLOEXEC);
+					if (fd >= 0 || !IsFdPressure(errno) || attempt >= kMaxIdleOpenRetries)
+						break;
+					++shard.stats.backpressure_events;
+					Backoff(attempt);
+				}
+				if (fd < 0)
+				{
+					shard.Fail(i);
+					continue;
+				}
+
+				std::string content;
+				const bool ok = ReadOpened(fd, content);
+				::close(fd);
+				if (!ok)
+					shard.Fail(i);
+				else
+					shard.Record(i, RunPipeline(shard.paths[i], std::move(content)));
+			}
+		}
+
+#if CONFIG_HAS_IO_URING
+		// io_uring 分片：每個檔案依序 open → read（短讀時續讀）→ close，同時最多 cap 個檔案；
+		// 無法建立 ring 時回傳 false，呼叫端改用 RunBlockingShard
+		[[nodiscard]] bool RunUringShard(Shard& shard)
+		{
+			enum class Phase : std::uint8_t { kOpen, kRead, kClose };
+			struct Slot
+			{
+				std::size_t index  = 0;
+				int         fd     = -1;
+				bool        busy   = false;
+				Phase       phase  = Phase::kOpen;
+				std::string buffer;
+				std::size_t filled = 0;
+			};
+			// 緩衝宣告在 ring 之前：ring 先解構，核心不會再寫入已釋放的緩衝
+			const std::size_t slot_count = std::min<std::size_t>(shard.cap, 4096);
+			std::vector<Slot>        slots(slot_count);
+
+			// 每個檔案同一時間只有一個操作在 ring 上，SQ 容量等於 slot_count 即不會溢出
+			auto ring = ioring::Ring::Create(static_cast<unsigned>(slot_count));
+			if (!ring)
+				return false;
+			++shard.stats.io_uring_shards;
+
+			std::vector<std::size_t> free_slots;
+			free_slots.reserve(slot_count);
+			for (std::size_t s = slot_count; s-- > 0;)
+				free_slots.push_back(s);
+
+			std::deque<std::size_t> pending;
+			for (std::size_t i = shard.first; i < shard.paths.size(); i += shard.stride)
+				pending.push_back(i);
+
+			// 目前允許的並行數：遇到 EMFILE 時降到目前開著的檔案數，每關閉一個檔案加一
+			std::size_t limit       = slot_count;
+			std::size_t active      = 0;
+			int         idle_retries = 0;
+
+			const auto submit_open = [&](std::size_t s) {
+				slots[s].phase = Phase::kOpen;
+				ring->Push([&](io_uring_sqe& sqe) {
+					sqe.opcode     = IORING_OP_OPENAT;
+					sqe.fd         = AT_FDCWD;
+					sqe.addr       = reinterpret_cast<std::uintptr_t>(shard.paths[slots[s].index].c_str());
+					sqe.open_flags = O_RDONLY | O_CLOEXEC;
+					sqe.user_data  = s;
+				});
+			};
+			const auto submit_read = [&](std::size_t s) {
+				Slot& slot = slots[s];
+				slot.phase = Phase::kRead;
+				ring->Push([&](io_uring_sqe& sqe) {
+					sqe.opcode    = IORING_OP_READ;
+					sqe.fd        = slot.fd;
+					sqe.addr      = reinterpret_cast<std::uintptr_t>(slot.buffer.data() + slot.filled);
+					sqe.len       = static_cast<unsigned>(std::min<std::size_t>(slot.buffer.size() - slot.filled, 1u << 30));
+					sqe.off       = slot.filled;
+					sqe.user_data = s;
+				});
+			};
+			const auto submit_close = [&](std::size_t s) {
+				slots[s].phase = Phase::kClose;
+				ring->Push([&](io_uring_sqe& sqe) {
+					sqe.opcode    = IORING_OP_CLOSE;
+					sqe.fd        = slots[s].fd;
+					sqe.user_data = s;
+				});
+			};
+			const auto release = [&](std::size_t s) {
+				slots[s].busy = false;
+				slots[s].fd = -1;
+				slots[s].buffer = {};
+				free_slots.push_back(s);
+				--active;
+			};
+			// 讀完：先送出 close，讓關檔與管線的計算重疊
+			const auto finish_read = [&](std::size_t s) {
+				Slot& slot = slots[s];
+				slot.buffer.resize(slot.filled);
+				std::string content = std::move(slot.buffer);
+				submit_close(s);
+				(void)ring->Submit(0);
+				shard.Record(slot.index, RunPipeline(shard.paths[slot.index], std::move(content)));
+			};
+
+			const auto on_complete = [&](const io_uring_cqe& cqe) {
+				const auto s   = static_cast<std::size_t>(cqe.user_data);
+				Slot&      slot = slots[s];
+				switch (slot.phase)
+				{
+				case Phase::kOpen:
+					if (cqe.res < 0 && IsFdPressure(-cqe.res))
+					{
+						// 背壓：放回佇列前端，等其他檔案關閉後再開
+						++shard.stats.backpressure_events;
+						pending.push_front(slot.index);
+						release(s);
+						limit = std::max<std::size_t>(1, active);
+						if (active == 0 && idle_retries >= kMaxIdleOpenRetries)
+						{
+							pending.pop_front();
+							shard.Fail(slot.index);
+							idle_retries = 0;
+						}
+						else if (active == 0)
+							Backoff(idle_retries++);
+						return;
+					}
+					if (cqe.res < 0)
+					{
+						shard.Fail(slot.index);
+						release(s);
+						return;
+					}
+					idle_retries = 0;
+					slot.fd = cqe.res;
+					{
+						// fstat 不涉及磁碟 I/O，直接同步呼叫以預先配置緩衝
+						struct stat st{};
+						if (::fstat(slot.fd, &st) != 0 || !S_ISREG(st.st_mode))
+						{
+							shard.Fail(slot.index);
+							submit_close(s);
+							return;
+						}
+						slot.buffer.resize(static_cast<std::size_t>(st.st_size));
+						slot.filled = 0;
+					}
+					if (slot.buffer.empty())
+						finish_read(s);
+					else
+						submit_read(s);
+					return;
+
+				case Phase::kRead:
+					if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+					{
+						submit_read(s);
+						return;
+					}
+					if (cqe.res < 0)
+					{
+						shard.Fail(slot.index);
+						submit_close(s);
+						return;
+					}
+					slot.filled += static_cast<std::size_t>(cqe.res);
+					// 短讀：從目前位移續讀；讀到 0 表示檔案在 fstat 之後變短
+					if (cqe.res > 0 && slot.filled < slot.buffer.size())
+						submit_read(s);
+					else
+						finish_read(s);
+					return;
+
+				case Phase::kClose:
+					release(s);
+					limit = std::min(slot_count, limit + 1);
+					return;
+				}
+			};
+
+			for (;;)
+			{
+				while (active < limit && !pending.empty() && !free_slots.empty())
+				{
+					const std::size_t s = free_slots.back();
+					free_slots.pop_back();
+					slots[s].busy  = true;
+					slots[s].index = pending.front();
+					pending.pop_front();
+					submit_open(s);
+					++active;
+				}
+				shard.stats.peak_in_flight = std::max(shard.stats.peak_in_flight, active);
+				if (active == 0)
+					break;
+
+				if (const int error = ring->Submit(1); error < 0 && error != -EBUSY && error != -EAGAIN)
+				{
+					// ring 無法再使用：進行中與尚未開始的檔案一律回報讀檔錯誤
+					// （close 階段的檔案已記錄過結果）
+					for (auto& slot : slots)
+					{
+						if (!slot.busy)
+							continue;
+						if (slot.fd >= 0 && slot.phase != Phase::kClose)
+							::close(slot.fd);
+						if (slot.phase != Phase::kClose)
+							shard.Fail(slot.index);
+					}
+					for (const std::size_t i : pending)
+						shard.Fail(i);
+					return true;
+				}
+				ring->Drain(on_complete);
+			}
+			return true;
+		}
+#endif
+	}
+
+	// 依執行緒切分片；每個分片優先使用 io_uring，否則阻塞式讀取
+	[[nodiscard]] std::vector<std::expected<Result, PipelineError>>
+	LoadBatchAsync(WorkStealingPool& pool, std::span<const std::string> paths,
+	               const AsyncLoadOptions& options, AsyncLoadStats* stats)
+	{
+		std::vector<std::expected<Result, PipelineError>> results(paths.size());
+		const std::size_t max_in_flight = std::max<std::size_t>(1, options.max_in_flight);
+		// 分片數不超過執行緒數、路徑數與並行上限，確保每個分片至少能開一個檔
+		const std::size_t shards = std::min({pool.thread_count(), paths.size(), max_in_flight});
+		if (shards == 0)
+		{
+			if (stats != nullptr)
+				*stats = {};
+			return results;
+		}
+
+		// 每個分片各自的統計（獨占快取線），結束後才合併
+		struct alignas(64) LocalStats { AsyncLoadStats value; };
+		std::vector<LocalStats> local(shards);
+
+		pool.ForEach(shards, [&](std::size_t s, std::size_t)
+		{
+			Shard shard{paths, s, shards, max_in_flight / shards, results, local[s].value};
+#if CONFIG_HAS_IO_URING
+			if (options.use_io_uring && RunUringShard(shard))
+				return;
+#endif
+			RunBlockingShard(shard);
+		});
+
+		if (stats != nullptr)
+		{
+			*stats = {};
+			for (const auto& l : local)
+			{
+				stats->batch.succeeded += l.value.batch.succeeded;
+				for (std::size_t k = 0; k < stats->batch.errors_by_index.size(); ++k)
+					stats->batch.errors_by_index[k] += l.value.batch.errors_by_index[k];
+				stats->io_uring_shards     += l.value.io_uring_shards;
+				stats->backpressure_events += l.value.backpressure_events;
+				stats->peak_in_flight      += l.value.peak_in_flight;
+			}
+		}
+		return results;
+	}
+// 結束命名空間
+}
@@ -1,12 +1,46 @@
 // Basic.cpp
 #include <gtest/gtest.h>
 #include "Config.h"            // 官方Template
+#include "ArenaError.h"        // arena 版本的錯誤型別
+#include "ErrorCode.h"         // 精簡錯誤碼（lean error）
+#include "BatchExecutor.h"     // 批次管線執行器
+#include "AsyncLoader.h"       // 非同步批次讀檔（io_uring）
+#include "IoContext.h"         // 協程管線與事件迴圈
+#include "Pipeline.h"          // 編譯期組合的管線
+#include "HotReload.h"         // 熱重載與快照發佈
+#include "Log.h"               // 可替換的日誌後端
+#include "Metrics.h"           // 階段量測
+#include "ErrorFormat.h"       // 延遲格式化的錯誤訊息
+#include "ErrorReport.h"       // 錯誤取樣與限速回報
+#include "RuleEngine.h"        // 批次驗證規則引擎
+#include "BinaryConfig.h"      // 預先編譯的二進位設定快照
+#include "BufferPool.h"        // 緩衝區物件池
+#include "FaultInjection.h"    // 故障注入
+#include "LoadGenerator.h"     // 負載產生器
+#include "Wire.h"              // 驗證服務的線路格式
+#include "ValidationService.h" // 分散式驗證服務
+#include "MemoryPolicy.h"      // 大頁與 NUMA 配置政策
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
 #include <expected>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <variant>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>   // 背壓測試：暫時調低開檔上限
+#include <sys/mman.h>       // 配置政策測試：釋放匿名映射
+#include <unistd.h>         // 配置政策測試：頁大小
 
 using namespace std;
 using namespace std::string_literals;
@@ -29,6 +63,49 @@ static std::filesystem::path make_file_with(const std::filesystem::path& dir,con
 }
 
 
+// 配置計數：取代所有形式的 operator new / delete（全部經由 malloc / free，配對一致），
+// 只計算 g_count_allocations 為 true 的執行緒（緩衝區重用測試用）
+static thread_local bool        g_count_allocations = false;
+static thread_local std::size_t g_allocations       = 0;
+
+static void* CountedAlloc(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept
+{
+    if (g_count_allocations)
+        ++g_allocations;
+    size = size == 0 ? 1 : size;
+    if (alignment <= alignof(std::max_align_t))
+        return std::malloc(size);
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+static void* CountedAllocOrThrow(std::size_t size, std::size_t alignment = alignof(std::max_align_t))
+{
+    if (void* p = CountedAlloc(size, alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size) { return CountedAllocOrThrow(size); }
+void* operator new[](std::size_t size) { return CountedAllocOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t al) { return CountedAllocOrThrow(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return CountedAllocOrThrow(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return CountedAlloc(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return CountedAlloc(size, static_cast<std::size_t>(al)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+
 // Google 測試 Fixture
 class ErrorCasesTest : public ::testing::Test {
 protected:
@@ -85,8 +162,8 @@ TEST_F(ErrorCasesTest, MalformedContent_Triggers_ConfigParseError)
     {
         [&](const ConfigParseError& e) 
         {
-            // 驗證錯誤內容帶有我們預期的片段與行號（目前實作使用行號 1）
-            EXPECT_EQ(e.line_content, "malformed");
+            // 驗證錯誤內容帶有出錯那一行的原始內容與行號
+            EXPECT_EQ(e.line_content, "this is malformed configuration");
             EXPECT_EQ(e.line_number, 1);
         },
         [&](const auto&) 
@@ -146,7 +223,1426 @@ TEST_F(ErrorCasesTest, TooShortData_Triggers_ProcessingError)
     }, res.error());
 }
 
-// 編譯: g++ -std=gnu++23 Basic.cpp Config.cpp -I. -lgtest_main -lgtest -pthread -o test_basic
+// 情境五：mmap 模式讀取合法檔案 -> 零複製檢視並可接續驗證與處理
+TEST_F(ErrorCasesTest, MappedConfig_HappyPath)
+{
+    auto p = make_file_with(dir, "mapped.cfg", "valid_data_content");
+    auto res = LoadConfigMapped(p.string());
+
+    ASSERT_TRUE(res.has_value()) << "此案例應為 mmap 成功路徑";
+    // 檢視直接指向映射記憶體，內容與檔案相同
+    EXPECT_EQ(res->data, "valid_data_content");
+    EXPECT_EQ(res->data.data(), res->mapping.view().data());
+
+    // 移動後映射位址不變，檢視仍然有效
+    MappedConfig moved = std::move(*res);
+    auto out = ValidateData(moved).and_then([](const ValidatedData& vd) { return ProcessData(vd); });
+    ASSERT_TRUE(out.has_value());
+    EXPECT_EQ(out->final_result_code, static_cast<int>(std::string("Validated: valid_data_content").size()));
+}
+
+// 情境六：mmap 模式的映射失敗仍回傳 ConfigReadError（檔案不存在、目錄）
+TEST_F(ErrorCasesTest, MappedConfig_MapFailure_Triggers_ConfigReadError)
+{
+    for (const auto& path : { dir / "does_not_exist.cfg", dir })
+    {
+        auto res = LoadConfigMapped(path.string());
+        ASSERT_FALSE(res.has_value());
+        std::visit(Overloaded
+        {
+            [&](const ConfigReadError& e) { EXPECT_EQ(e.filename, path.string()); },
+            [&](const auto&) { ADD_FAILURE() << "預期為 ConfigReadError，但收到其他錯誤型別"; }
+        }, res.error());
+    }
+}
+
+// 情境七：mmap 模式下的空檔與 malformed 內容 -> ConfigParseError
+TEST_F(ErrorCasesTest, MappedConfig_EmptyOrMalformed_Triggers_ConfigParseError)
+{
+    for (const auto& content : { "", "this is malformed configuration" })
+    {
+        auto p = make_file_with(dir, "mapped_bad.cfg", content);
+        auto res = LoadConfigMapped(p.string());
+        ASSERT_FALSE(res.has_value());
+        EXPECT_TRUE(std::holds_alternative<ConfigParseError>(res.error()));
+    }
+}
+
+// 情境八：多樣式掃描器單次走訪即回報所有命中（含互相重疊、互為後綴的樣式）
+TEST_F(ErrorCasesTest, Scanner_Reports_All_Hits_With_Offsets)
+{
+    scanner::MultiPatternScanner s({"he", "she", "his", "hers"});
+    auto r = s.Scan("ushers");
+
+    ASSERT_TRUE(r.scanned);
+    // "ushers"：she@1、he@2、hers@2
+    ASSERT_EQ(r.hits.size(), 3u);
+    EXPECT_EQ(r.First(1), 1u);
+    EXPECT_EQ(r.First(0), 2u);
+    EXPECT_EQ(r.First(3), 2u);
+    EXPECT_FALSE(r.Contains(2));
+}
+
+// 情境九：LoadConfig 的掃描結果隨 Config 傳遞，ValidateData 直接取用
+TEST_F(ErrorCasesTest, LoadConfig_Scan_Is_Consumed_By_ValidateData)
+{
+    auto p = make_file_with(dir, "scan.cfg", "key=ok\ninvalid_field=bad");
+    auto cfg = LoadConfig(p.string());
+
+    ASSERT_TRUE(cfg.has_value());
+    ASSERT_TRUE(cfg->scan.scanned);
+    EXPECT_EQ(cfg->scan.First(kInvalidField), 7u);
+    EXPECT_TRUE(std::holds_alternative<ValidationError>(ValidateData(*cfg).error()));
+
+    // 手動建立、未掃描的 Config 仍會被正確驗證（補掃一次）
+    Config manual{"invalid_field"};
+    EXPECT_FALSE(manual.scan.scanned);
+    EXPECT_FALSE(ValidateData(manual).has_value());
+}
+
+// 情境十：多行內容中的 malformed -> ConfigParseError 帶有真實行號與該行內容
+TEST_F(ErrorCasesTest, MalformedContent_Reports_Real_Line)
+{
+    auto p = make_file_with(dir, "multi.cfg", "a=1\r\nb=2\r\nc=malformed value\r\nd=4");
+    auto res = LoadConfig(p.string());
+
+    ASSERT_FALSE(res.has_value());
+    std::visit(Overloaded
+    {
+        [&](const ConfigParseError& e)
+        {
+            EXPECT_EQ(e.line_number, 3);
+            EXPECT_EQ(e.line_content, "c=malformed value");
+        },
+        [&](const auto&) { ADD_FAILURE() << "預期為 ConfigParseError，但收到其他錯誤型別"; }
+    }, res.error());
+
+    // 換行索引可重複用來定位任意位移
+    auto scan = SentinelScanner().Scan("x\ny\nz");
+    EXPECT_EQ(scan.newlines.size(), 2u);
+    EXPECT_EQ(scan.Locate("x\ny\nz", 0).line_number, 1);
+    EXPECT_EQ(scan.Locate("x\ny\nz", 1).line_number, 1);
+    EXPECT_EQ(scan.Locate("x\ny\nz", 4).line_content, "z");
+}
+
+// 情境十一：右值版本的 ValidateData / ProcessData 沿用同一塊緩衝區
+TEST_F(ErrorCasesTest, MoveThrough_Reuses_Config_Buffer)
+{
+    Config cfg{std::string(256, 'a')};
+    const char* buffer = cfg.data.data();
+
+    auto vd = ValidateData(std::move(cfg));
+    ASSERT_TRUE(vd.has_value());
+    // 內容未被複製：ValidatedData 直接接手原本的緩衝區，前綴只是標記
+    EXPECT_EQ(vd->processed_data.data(), buffer);
+    EXPECT_EQ(vd->tag, kValidatedTag);
+    EXPECT_EQ(vd->str(), "Validated: " + std::string(256, 'a'));
+
+    // 結果碼與舊版（串接後字串長度）一致
+    auto res = ProcessData(std::move(*vd));
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res->final_result_code, static_cast<int>(kValidatedTag.size() + 256));
+}
+
+// 情境十二：arena 版本的錯誤 -> 字串配置自每批次 arena，靜態字面值不配置
+TEST_F(ErrorCasesTest, ArenaErrors_Allocate_From_Batch_Arena)
+{
+    arena::ErrorArena errors;
+    auto bad = make_file_with(dir, "arena_bad.cfg", "invalid_field=1");
+
+    auto res = LoadConfig(bad.string(), errors)
+        .and_then([&](Config&& cfg) { return ValidateData(std::move(cfg), errors); });
+    ASSERT_FALSE(res.has_value());
+    ASSERT_TRUE(std::holds_alternative<arena::ValidationError>(res.error()));
+
+    // 錯誤字串的配置器來自 arena
+    const auto& e = std::get<arena::ValidationError>(res.error());
+    EXPECT_EQ(e.field_name, "invalid_field");
+    EXPECT_EQ(e.field_name.get_allocator().resource(), errors.resource());
+
+    // ProcessingError 只存靜態字面值
+    auto perr = ProcessData(ValidatedData{"x"}, errors);
+    ASSERT_FALSE(perr.has_value());
+    EXPECT_EQ(std::get<arena::ProcessingError>(perr.error()).task_name, "Data Processing");
+
+    // 轉回一般錯誤後即可在 arena 重置後繼續使用，variant 索引對應不變
+    PipelineError owned = ToOwned(res.error());
+    errors.Reset();
+    EXPECT_EQ(owned.index(), 2u);
+    EXPECT_EQ(std::get<ValidationError>(owned).field_name, "invalid_field");
+}
+
+// 情境十三：精簡錯誤碼 -> 熱迴圈只拿錯誤碼，需要報告時再轉回完整 PipelineError
+TEST_F(ErrorCasesTest, LeanErrorCode_With_Deferred_Details)
+{
+    // 成功路徑的 expected 不再被兩個 std::string 撐大
+    static_assert(sizeof(std::expected<Result, ErrorCode>) < sizeof(std::expected<Result, PipelineError>));
+
+    auto bad = make_file_with(dir, "lean_bad.cfg", "ok\nmalformed");
+
+    // 不要明細：只得到錯誤種類
+    auto code_only = LoadConfig(bad.string(), kNoDetails);
+    ASSERT_FALSE(code_only.has_value());
+    EXPECT_EQ(code_only.error().kind, ErrorKind::kConfigParse);
+    EXPECT_FALSE(code_only.error().has_detail());
+
+    // 要明細：錯誤碼指向側表，轉換後與一般版本相同
+    ErrorDetails details;
+    auto with_detail = LoadConfig(bad.string(), &details);
+    ASSERT_FALSE(with_detail.has_value());
+    ASSERT_TRUE(with_detail.error().has_detail());
+    auto full = ToPipelineError(with_detail.error(), &details);
+    ASSERT_TRUE(std::holds_alternative<ConfigParseError>(full));
+    EXPECT_EQ(std::get<ConfigParseError>(full).line_number, 2);
+    EXPECT_EQ(KindOf(full), ErrorKind::kConfigParse);
+
+    // 其他階段
+    EXPECT_EQ(ProcessData(ValidatedData{"x"}, kNoDetails).error().kind, ErrorKind::kProcessing);
+    EXPECT_EQ(ToString(ErrorKind::kValidation), "ValidationError");
+}
+
+// 情境十四：批次管線 -> 多執行緒執行，結果依輸入順序回傳，統計依錯誤型別分類
+TEST_F(ErrorCasesTest, RunBatch_Preserves_Input_Order)
+{
+    std::vector<std::string> paths;
+    for (int i = 0; i < 40; ++i)
+    {
+        // 每 4 個一輪：成功、解析錯誤、驗證錯誤、檔案不存在
+        const std::string name = "batch_" + std::to_string(i) + ".cfg";
+        switch (i % 4)
+        {
+            case 0: paths.push_back(make_file_with(dir, name, "valid_data_content").string()); break;
+            case 1: paths.push_back(make_file_with(dir, name, "malformed").string()); break;
+            case 2: paths.push_back(make_file_with(dir, name, "invalid_field").string()); break;
+            default: paths.push_back((dir / name).string()); break;
+        }
+    }
+
+    BatchStats stats;
+    auto results = RunBatch(paths, BatchOptions{4}, &stats);
+
+    ASSERT_EQ(results.size(), paths.size());
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        if (i % 4 == 0)
+            EXPECT_TRUE(results[i].has_value()) << i;
+        else
+            EXPECT_EQ(results[i].error().index(), (i % 4 == 3) ? 0u : i % 4) << i;
+    }
+    EXPECT_EQ(stats.succeeded, 10u);
+    EXPECT_EQ(stats.errors_by_index[0], 10u);
+    EXPECT_EQ(stats.errors_by_index[1], 10u);
+    EXPECT_EQ(stats.errors_by_index[2], 10u);
+
+    // 同一個執行緒池可重複使用於多個批次
+    WorkStealingPool pool(3);
+    EXPECT_EQ(RunBatch(pool, paths).size(), paths.size());
+    EXPECT_TRUE(RunBatch(pool, std::span<const std::string>{}).empty());
+}
+
+// 情境十五：日誌後端可替換；非同步後端由背景執行緒格式化輸出
+TEST_F(ErrorCasesTest, LogSink_Is_Pluggable_And_Async)
+{
+    // 收集紀錄的測試用後端
+    struct CaptureSink : logging::Sink
+    {
+        std::vector<std::string> lines;
+        void Write(logging::Level level, std::string_view message, std::string_view arg) override
+        {
+            lines.push_back(std::string(logging::ToString(level)) + ": " + std::string(message) + std::string(arg));
+        }
+    } capture;
+
+    logging::SetSink(&capture);
+    auto missing = LoadConfig((dir / "missing.cfg").string());
+    logging::SetSink(nullptr);
+
+    ASSERT_FALSE(missing.has_value());
+#if CONFIG_LOG_LEVEL <= 2
+    ASSERT_EQ(capture.lines.size(), 1u);
+    EXPECT_EQ(capture.lines[0], "WARN: LoadConfig failed to open " + (dir / "missing.cfg").string());
+#else
+    EXPECT_TRUE(capture.lines.empty());
+#endif
+
+    // 非同步後端：熱路徑只入列，Flush 後內容才保證寫出
+    std::ostringstream out;
+    {
+        logging::AsyncRingSink async(out, 8);
+        logging::SetSink(&async);
+        logging::Emit(logging::Level::kDebug, "hello ", "world");
+        logging::Emit(logging::Level::kError, "boom");
+        logging::SetSink(nullptr);
+        async.Flush();
+        EXPECT_EQ(async.dropped(), 0u);
+        // 背景執行緒閒置後改為等待（不輪詢）：之後的紀錄由生產端喚醒
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        async.Write(logging::Level::kInfo, "again", "");
+        async.Flush();
+    }
+    EXPECT_EQ(out.str(), "DEBUG: hello world\nERROR: boom\nINFO: again\n");
+}
+
+// 情境十六：SIMD 前置過濾不影響結果（樣式跨越 16 位元組區塊、長輸入的換行索引）
+TEST_F(ErrorCasesTest, Scanner_Prefilter_Matches_Across_Blocks)
+{
+    std::string text;
+    for (int i = 0; i < 100; ++i)
+        text += std::string(static_cast<std::size_t>(i % 17), 'x') + "\n";
+    text.insert(30, "malformed");      // 跨越第 16/32 位元組的區塊邊界
+    text += "invalid_field";
+
+    auto r = SentinelScanner().Scan(text);
+    EXPECT_EQ(r.First(kMalformed), 30u);
+    EXPECT_EQ(r.First(kInvalidField), text.size() - 13);
+    EXPECT_EQ(r.newlines.size(), static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')));
+    EXPECT_TRUE(std::is_sorted(r.newlines.begin(), r.newlines.end()));
+}
+
+// 情境十七：量測層 -> 對數-線性直方圖、依 variant 索引計數；關閉時 Instrument 無任何包裝
+TEST_F(ErrorCasesTest, Metrics_Histogram_And_Error_Counters)
+{
+    // 分格：每個值都落在上界不小於它、且相對誤差不超過 25% 的格子
+    for (std::uint64_t v : {0ull, 3ull, 4ull, 7ull, 100ull, 1000ull, 123456789ull, ~0ull})
+    {
+        const auto upper = metrics::BucketUpperBound(metrics::BucketOf(v));
+        EXPECT_GE(upper, v);
+        EXPECT_LE(upper - v, v / 4 + 1);
+    }
+
+    metrics::Reset();
+    metrics::RecordLatency(metrics::Stage::kLoadConfig, 1000);
+    std::thread([] { metrics::RecordLatency(metrics::Stage::kLoadConfig, 3000); }).join();
+    metrics::RecordError(metrics::Stage::kValidateData, 2);
+
+    // 快照合併所有執行緒（含已結束的執行緒）的分片
+    auto snap = metrics::TakeSnapshot();
+    EXPECT_EQ(snap.latency[0].count, 2u);
+    EXPECT_EQ(snap.latency[0].sum_ns, 4000u);
+    EXPECT_GE(snap.latency[0].Percentile(0.99), 3000u);
+    EXPECT_EQ(snap.errors[1][2], 1u);
+
+    const auto text = metrics::ExportPrometheus(snap);
+    EXPECT_NE(text.find("config_stage_latency_ns_count{stage=\"LoadConfig\"} 2"), std::string::npos);
+    EXPECT_NE(text.find("config_stage_errors_total{stage=\"ValidateData\",alternative=\"2\"} 1"), std::string::npos);
+
+    // Instrument：開啟時記錄，關閉時不記錄
+    metrics::Reset();
+    auto process = metrics::Instrument(metrics::Stage::kProcessData,
+                                       [](const ValidatedData& vd) { return ProcessData(vd); });
+    EXPECT_FALSE(process(ValidatedData{"x"}).has_value());
+    EXPECT_EQ(metrics::TakeSnapshot().errors[2][3], CONFIG_METRICS ? 1u : 0u);
+
+    // 寫入端仍在執行時 Reset：清除前完成的紀錄不會被寫回（進行中的每個寫入端最多多計一筆）
+    constexpr std::uint64_t kWriters = 4;
+    std::atomic<bool>          stop{false};
+    std::atomic<std::uint64_t> done{0};
+    std::vector<std::thread>   writers;
+    for (std::uint64_t i = 0; i < kWriters; ++i)
+        writers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                metrics::RecordLatency(metrics::Stage::kValidateData, 10);
+                done.fetch_add(1, std::memory_order_release);
+            }
+        });
+    for (int round = 0; round < 500; ++round)
+    {
+        const std::uint64_t before = done.load(std::memory_order_acquire);
+        metrics::Reset();
+        const auto counted = metrics::TakeSnapshot().latency[1].count;
+        const std::uint64_t after = done.load(std::memory_order_acquire);
+        ASSERT_LE(counted, after - before + kWriters) << "round " << round;
+    }
+    stop = true;
+    for (auto& writer : writers)
+        writer.join();
+    // 停止後：Reset 之後的紀錄全部計入
+    metrics::Reset();
+    metrics::RecordLatency(metrics::Stage::kValidateData, 10);
+    EXPECT_EQ(metrics::TakeSnapshot().latency[1].count, 1u);
+    metrics::Reset();
+}
+
+// 情境十八：快取讀檔 -> 未變更共用同一份緩衝；改寫後重新讀取；缺檔在 TTL 內不再 stat；超過上限依 LRU 逐出
+TEST_F(ErrorCasesTest, FileCache_Hits_Invalidation_And_Negative_TTL)
+{
+    filecache::FileCache cache(SentinelScanner(), filecache::Options{.max_bytes = 64, .max_entries = 8, .negative_ttl = std::chrono::hours(1)});
+
+    auto p = make_file_with(dir, "cached.cfg", "key=value;");
+    auto first  = LoadConfig(cache, p.string());
+    auto second = cache.Get(p.string());
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(first->data, "key=value;");
+    EXPECT_EQ(cache.stats().misses, 1u);
+    EXPECT_EQ(cache.stats().hits, 1u);
+
+    // 大小改變 -> 鍵不符，重新讀取並重新掃描
+    make_file_with(dir, "cached.cfg", "now malformed");
+    auto changed = LoadConfig(cache, p.string());
+    ASSERT_FALSE(changed.has_value());
+    EXPECT_TRUE(std::holds_alternative<ConfigParseError>(changed.error()));
+    EXPECT_EQ(cache.stats().misses, 2u);
+    // 先前交出的緩衝不受影響
+    EXPECT_EQ((*second)->data, "key=value;");
+
+    // 缺檔：第一次 stat，之後 TTL 內直接回傳；檔案出現後需 Invalidate 才會看到
+    auto missing = (dir / "missing.cfg").string();
+    EXPECT_TRUE(std::holds_alternative<ConfigReadError>(LoadConfig(cache, missing).error()));
+    make_file_with(dir, "missing.cfg", "key=value;");
+    EXPECT_FALSE(LoadConfig(cache, missing).has_value());
+    EXPECT_EQ(cache.stats().negative_hits, 1u);
+    cache.Invalidate(missing);
+    EXPECT_TRUE(LoadConfig(cache, missing).has_value());
+
+    // 位元組上限 64：再放入 60 位元組的檔案會逐出最久未用的項目
+    auto big = make_file_with(dir, "big.cfg", std::string(60, 'k'));
+    ASSERT_TRUE(cache.Get(big.string()).has_value());
+    EXPECT_LE(cache.bytes(), 64u);
+    EXPECT_GE(cache.stats().evictions, 1u);
+
+    // 負面結果計入項目數：大量不同的缺檔路徑不會超過 max_entries
+    filecache::FileCache bounded(SentinelScanner(), filecache::Options{.max_bytes = 64, .max_entries = 4, .negative_ttl = std::chrono::hours(1)});
+    for (int i = 0; i < 100; ++i)
+        EXPECT_FALSE(bounded.Get((dir / ("absent_" + std::to_string(i) + ".cfg")).string()).has_value());
+    EXPECT_EQ(bounded.size(), 4u);
+    EXPECT_EQ(bounded.stats().evictions, 96u);
+
+    // 超過上限時先逐出已過期的負面結果：較早放入的正面結果保留
+    filecache::FileCache expiring(SentinelScanner(), filecache::Options{.max_bytes = 64, .max_entries = 2, .negative_ttl = std::chrono::milliseconds(1)});
+    auto kept = make_file_with(dir, "kept.cfg", "key=value;");
+    ASSERT_TRUE(expiring.Get(kept.string()).has_value());
+    EXPECT_FALSE(expiring.Get((dir / "gone_1.cfg").string()).has_value());
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_FALSE(expiring.Get((dir / "gone_2.cfg").string()).has_value());
+    EXPECT_EQ(expiring.size(), 2u);
+    ASSERT_TRUE(expiring.Get(kept.string()).has_value());
+    EXPECT_EQ(expiring.stats().hits, 1u);
+    EXPECT_EQ(expiring.stats().misses, 1u);
+}
+
+// 情境十九：非同步批次讀檔 -> 結果與 RunBatch 相同（io_uring 與阻塞式退回方案皆然）
+TEST_F(ErrorCasesTest, LoadBatchAsync_Matches_RunBatch)
+{
+    std::vector<std::string> paths;
+    for (int i = 0; i < 40; ++i)
+    {
+        const std::string name = "async_" + std::to_string(i) + ".cfg";
+        switch (i % 4)
+        {
+            case 0: paths.push_back(make_file_with(dir, name, std::string(static_cast<std::size_t>(i + 1) * 100, 'v')).string()); break;
+            case 1: paths.push_back(make_file_with(dir, name, "malformed").string()); break;
+            case 2: paths.push_back(make_file_with(dir, name, "invalid_field").string()); break;
+            default: paths.push_back((dir / name).string()); break;
+        }
+    }
+
+    WorkStealingPool pool(2);
+    const auto expected = RunBatch(pool, paths);
+    for (bool use_io_uring : {true, false})
+    {
+        AsyncLoadStats stats;
+        auto results = LoadBatchAsync(pool, paths, AsyncLoadOptions{.max_in_flight = 8, .use_io_uring = use_io_uring}, &stats);
+
+        ASSERT_EQ(results.size(), paths.size());
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            ASSERT_EQ(results[i].has_value(), expected[i].has_value()) << i;
+            if (results[i])
+                EXPECT_EQ(results[i]->final_result_code, expected[i]->final_result_code) << i;
+            else
+                EXPECT_EQ(results[i].error().index(), expected[i].error().index()) << i;
+        }
+        EXPECT_EQ(stats.batch.succeeded, 10u);
+        EXPECT_LE(stats.peak_in_flight, 8u);
+        if (!use_io_uring)
+        {
+            EXPECT_EQ(stats.io_uring_shards, 0u);
+        }
+    }
+}
+
+// 情境二十：開檔數用盡 -> 延後重試（背壓），整批仍然成功
+TEST_F(ErrorCasesTest, LoadBatchAsync_Treats_EMFILE_As_Backpressure)
+{
+    std::vector<std::string> paths;
+    for (int i = 0; i < 32; ++i)
+        paths.push_back(make_file_with(dir, "bp_" + std::to_string(i) + ".cfg", "valid_data_content").string());
+
+    WorkStealingPool pool(1);
+    // 目前開著的 fd 數 + 3：io_uring 本身一個，只剩兩個給設定檔
+    const auto open_fds = static_cast<rlim_t>(std::distance(std::filesystem::directory_iterator("/proc/self/fd"), {}));
+    ::rlimit saved{};
+    ASSERT_EQ(::getrlimit(RLIMIT_NOFILE, &saved), 0);
+    ::rlimit tight = saved;
+    tight.rlim_cur = open_fds + 3;
+    ASSERT_EQ(::setrlimit(RLIMIT_NOFILE, &tight), 0);
+
+    AsyncLoadStats stats;
+    auto results = LoadBatchAsync(pool, paths, AsyncLoadOptions{.max_in_flight = 16}, &stats);
+    ::setrlimit(RLIMIT_NOFILE, &saved);
+
+    EXPECT_EQ(stats.batch.succeeded, paths.size());
+    EXPECT_GT(stats.backpressure_events, 0u);
+}
+
+// 情境二十一：協程管線 -> 結果與同步管線相同，失敗時在第一個出錯的 co_await 短路
+TEST_F(ErrorCasesTest, Coroutine_Pipeline_Matches_Sync_Pipeline)
+{
+    std::vector<std::string> paths = {
+        make_file_with(dir, "co_ok.cfg", "valid_data_content").string(),
+        make_file_with(dir, "co_bad.cfg", "malformed").string(),
+        make_file_with(dir, "co_invalid.cfg", "invalid_field").string(),
+        make_file_with(dir, "co_short.cfg", "x").string(),
+        (dir / "co_missing.cfg").string(),
+    };
+
+    for (bool use_io_uring : {true, false})
+    {
+        coro::IoContext io(coro::IoContextOptions{.use_io_uring = use_io_uring});
+        if (!use_io_uring)
+        {
+            EXPECT_FALSE(io.uses_io_uring());
+        }
+        for (const auto& path : paths)
+        {
+            const auto expected = LoadConfig(path)
+                .and_then([](Config&& cfg) { return ValidateData(std::move(cfg)); })
+                .and_then([](ValidatedData&& vd) { return ProcessData(std::move(vd)); });
+            auto result = coro::RunToCompletion(io, coro::RunPipelineAsync(io, path));
+            ASSERT_EQ(result.has_value(), expected.has_value()) << path;
+            if (result)
+                EXPECT_EQ(result->final_result_code, expected->final_result_code);
+            else
+                EXPECT_EQ(result.error().index(), expected.error().index()) << path;
+        }
+    }
+}
+
+// 情境二十二：上千條管線同時進行 -> 開檔數受限、框架重複使用
+TEST_F(ErrorCasesTest, Coroutine_Pipelines_Share_One_Event_Loop)
+{
+    std::vector<std::string> paths;
+    for (int i = 0; i < 16; ++i)
+        paths.push_back(make_file_with(dir, "co_" + std::to_string(i) + ".cfg", std::string(static_cast<std::size_t>(i + 1) * 64, 'v')).string());
+
+    const auto before = coro::FrameStats();
+    coro::IoContext io(coro::IoContextOptions{.ring_entries = 64, .max_open_files = 32});
+    std::vector<coro::Task<Result>> tasks;
+    for (int i = 0; i < 2000; ++i)
+    {
+        tasks.push_back(coro::RunPipelineAsync(io, paths[static_cast<std::size_t>(i) % paths.size()]));
+        io.Post(tasks.back().handle());
+    }
+    io.Run();
+
+    for (auto& task : tasks)
+    {
+        ASSERT_TRUE(task.done());
+        EXPECT_TRUE(std::move(task).result().has_value());
+    }
+    EXPECT_LE(io.peak_open_files(), 32u);
+    const auto after = coro::FrameStats();
+    EXPECT_EQ(after.oversized, before.oversized);
+    EXPECT_GE(after.frames - before.frames, 2000u * 3);
+}
+
+// 情境二十三：編譯期組合的管線 -> 錯誤型別為各階段錯誤的聯集，結果與 and_then 串接相同
+TEST_F(ErrorCasesTest, Pipeline_Composes_Stages_With_Error_Union)
+{
+    // 聯集依序合併、去除重複
+    static_assert(std::is_same_v<meta::UnionVariant<meta::TypeList<int, char>, meta::TypeList<char, double>>,
+                                 std::variant<int, char, double>>);
+    static_assert(std::is_same_v<ConfigPipeline::Error, PipelineError>);
+    // 只組合部分階段：錯誤型別只含這些階段的錯誤
+    using Tail = Pipeline<ValidateStage, ProcessStage>;
+    static_assert(std::is_same_v<Tail::Error, std::variant<ValidationError, ProcessingError>>);
+    static_assert(std::is_same_v<Tail::Output<Config>, Result>);
+    // 階段只回傳自己宣告的錯誤；收窄時遇到清單外的錯誤擲出例外
+    static_assert(std::is_same_v<std::invoke_result_t<const ValidateStage&, Config>::error_type, std::variant<ValidationError>>);
+    EXPECT_THROW((void)meta::ConvertVariant<std::variant<ValidationError>>(PipelineError{ConfigReadError{"f"}}), std::bad_variant_access);
+
+    constexpr ConfigPipeline pipeline{};
+    for (const auto& content : {"valid_data_content"s, "malformed"s, "invalid_field"s, "x"s})
+    {
+        const auto path = make_file_with(dir, "pipe.cfg", content).string();
+        const auto expected = LoadConfig(path)
+            .and_then([](Config&& cfg) { return ValidateData(std::move(cfg)); })
+            .and_then([](ValidatedData&& vd) { return ProcessData(std::move(vd)); });
+        const auto result = pipeline(path);
+        ASSERT_EQ(result.has_value(), expected.has_value()) << content;
+        if (result)
+            EXPECT_EQ(result->final_result_code, expected->final_result_code);
+        else
+            EXPECT_EQ(result.error().index(), expected.error().index()) << content;
+    }
+    const auto missing = pipeline((dir / "missing.cfg").string());
+    EXPECT_TRUE(!missing && std::holds_alternative<ConfigReadError>(missing.error()));
+
+    // 部分管線的錯誤轉換到較窄的 variant
+    const auto tail = Tail{}(Config{"invalid_field", SentinelScanner().Scan("invalid_field")});
+    ASSERT_FALSE(tail.has_value());
+    EXPECT_TRUE(std::holds_alternative<ValidationError>(tail.error()));
+    const auto last = Pipeline<ProcessStage>{}(ValidatedData{"x"});
+    static_assert(std::is_same_v<decltype(last)::error_type, std::variant<ProcessingError>>);
+    ASSERT_FALSE(last.has_value());
+    EXPECT_EQ(std::get<ProcessingError>(last.error()).task_name, "Data Processing");
+}
+
+// 情境二十四：key = value 解析 -> 已排序欄位表、語法錯誤帶行號、驗證錯誤指出欄位
+TEST_F(ErrorCasesTest, KeyValue_Table_And_Field_Precise_Errors)
+{
+    auto p = make_file_with(dir, "kv.cfg", "# comment; not a field\nname = demo ; port=8080\r\nverbose\nport = 9090\n\n");
+    auto cfg = LoadConfig(p.string());
+    ASSERT_TRUE(cfg.has_value());
+    const kv::Table& fields = cfg->fields;
+    ASSERT_TRUE(fields.parsed());
+    // 重複的鍵以最後一次為準；欄位依鍵排序
+    ASSERT_EQ(fields.size(), 3u);
+    EXPECT_EQ(fields[0].key, "name");
+    EXPECT_EQ(fields[1].key, "port");
+    EXPECT_EQ(fields[1].line, 4);
+    EXPECT_EQ(fields.Find("port"), "9090");
+    EXPECT_EQ(fields.Find("name"), "demo");
+    EXPECT_EQ(fields.Find("verbose"), "");
+    EXPECT_FALSE(fields.Contains("comment"));
+
+    // 語法錯誤：空的鍵、鍵中有空白 -> ConfigParseError 指向該行
+    auto empty_key = LoadConfig(make_file_with(dir, "kv_bad.cfg", "a=1\n = 2\n").string());
+    ASSERT_FALSE(empty_key.has_value());
+    const auto& parse = std::get<ConfigParseError>(empty_key.error());
+    EXPECT_EQ(parse.line_number, 2);
+    EXPECT_EQ(parse.line_content, " = 2");
+    auto spaced = LoadConfig(make_file_with(dir, "kv_space.cfg", "a=1\nsome key = 2").string());
+    ASSERT_FALSE(spaced.has_value());
+    EXPECT_EQ(std::get<ConfigParseError>(spaced.error()).line_number, 2);
+
+    // 驗證逐欄位進行：回報原文中最早出現的違規欄位與它的值
+    auto bad = LoadConfig(make_file_with(dir, "kv_invalid.cfg", "z=ok\nb=uses invalid_field here\ninvalid_field=1").string())
+        .and_then([](Config&& c) { return ValidateData(std::move(c)); });
+    ASSERT_FALSE(bad.has_value());
+    const auto& invalid = std::get<ValidationError>(bad.error());
+    EXPECT_EQ(invalid.field_name, "b");
+    EXPECT_EQ(invalid.invalid_value, "uses invalid_field here");
+    // 註解中的關鍵字不是欄位，不影響驗證
+    auto commented = LoadConfig(make_file_with(dir, "kv_comment.cfg", "# invalid_field\nkey=value").string())
+        .and_then([](Config&& c) { return ValidateData(std::move(c)); });
+    EXPECT_TRUE(commented.has_value());
+}
+
+// 情境二十五：熱重載 -> 只驗證變更的欄位，失敗時保留舊快照
+TEST_F(ErrorCasesTest, HotReload_Revalidates_Only_Changed_Fields)
+{
+    auto p = make_file_with(dir, "hot.cfg", "a=1\nb=2\nc=3\nd=4");
+    ConfigStore store(p.string());
+    EXPECT_EQ(store.Current(), nullptr);
+
+    auto first = store.Reload();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->revalidated, 4u);
+    EXPECT_EQ(first->version, 1u);
+    const auto v1 = store.Current();
+    ASSERT_NE(v1, nullptr);
+    EXPECT_EQ(v1->config.fields.Find("c"), "3");
+
+    // 內容相同：不發佈新版本
+    auto same = store.Reload();
+    ASSERT_TRUE(same.has_value());
+    EXPECT_TRUE(same->unchanged);
+    EXPECT_EQ(store.Current(), v1);
+
+    // 改一個、加一個、刪一個：只驗證兩個欄位
+    auto next = store.ReloadFromBuffer("a=1\nb=20\nc=3\ne=5");
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->changed, 1u);
+    EXPECT_EQ(next->added, 1u);
+    EXPECT_EQ(next->removed, 1u);
+    EXPECT_EQ(next->revalidated, 2u);
+    EXPECT_EQ(next->version, 2u);
+    EXPECT_EQ(store.Current()->config.fields.Find("b"), "20");
+    // 舊快照在讀取端放開前仍然有效
+    EXPECT_EQ(v1->config.fields.Find("b"), "2");
+
+    // 變更的欄位驗證失敗：指出欄位，快照維持第 2 版
+    auto rejected = store.ReloadFromBuffer("a=1\nb=invalid_field\nc=3\ne=5");
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(std::get<ValidationError>(rejected.error()).field_name, "b");
+    EXPECT_EQ(store.Current()->version, 2u);
+    // 解析錯誤同樣保留舊快照
+    EXPECT_FALSE(store.ReloadFromBuffer("a=1\n=2").has_value());
+    EXPECT_EQ(store.Current()->version, 2u);
+}
+
+// 情境二十六：讀取端在重載期間持續取得完整、版本遞增的快照
+TEST_F(ErrorCasesTest, HotReload_Readers_See_Consistent_Snapshots)
+{
+    ConfigStore store((dir / "hot_live.cfg").string());
+    ASSERT_TRUE(store.ReloadFromBuffer("gen=0\nname=live").has_value());
+
+    std::atomic<bool> stop{false};
+    std::atomic<std::size_t> inconsistent{0};
+    std::thread reader([&] {
+        std::uint64_t last = 0;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            const auto snapshot = store.Current();
+            const auto gen = snapshot->config.fields.Find("gen");
+            // 版本不倒退，且 gen 欄位與版本一致（第 n 版的 gen 為 n - 1）
+            if (snapshot->version < last || !gen || *gen != std::to_string(snapshot->version - 1))
+                ++inconsistent;
+            last = snapshot->version;
+        }
+    });
+    for (int gen = 1; gen <= 200; ++gen)
+        ASSERT_TRUE(store.ReloadFromBuffer("gen=" + std::to_string(gen) + "\nname=live").has_value());
+    stop = true;
+    reader.join();
+
+    EXPECT_EQ(inconsistent.load(), 0u);
+    EXPECT_EQ(store.Current()->version, 201u);
+}
+
+// 情境二十七：錯誤描述子只記位移，報告時寫出的訊息與完整錯誤逐字相同
+TEST_F(ErrorCasesTest, ErrorDescriptor_Formats_Like_Full_Error)
+{
+    static_assert(sizeof(ErrorDescriptor) <= 16);
+    const auto Message = [](const auto&... error) {
+        std::string text;
+        FormatTo(std::back_inserter(text), error...);
+        return text;
+    };
+
+    // 解析錯誤：位移指向出錯的那一行
+    const std::string syntax = "name = demo\nbad key = 1\n";
+    const ErrorSource syntax_source{"buf.cfg", syntax};
+    auto lazy_parse = LoadConfigFromBuffer("buf.cfg", syntax, kDescribe);
+    auto full_parse = LoadConfigFromBuffer("buf.cfg", syntax);
+    ASSERT_FALSE(lazy_parse.has_value());
+    ASSERT_FALSE(full_parse.has_value());
+    EXPECT_EQ(lazy_parse.error().kind, ErrorKind::kConfigParse);
+    EXPECT_EQ(Message(full_parse.error()), "Configuration Parse Error: Malformed content at line 2 (Context: 'bad key = 1')");
+    EXPECT_EQ(Message(lazy_parse.error(), syntax_source), Message(full_parse.error()));
+
+    // 驗證錯誤：報告時才從原文拆出鍵與值
+    auto config = LoadConfigFromBuffer("buf.cfg", std::string("a = 1\nkey = has invalid_field\nflag\n"));
+    ASSERT_TRUE(config.has_value());
+    auto lazy_check = ValidateData(*config, kDescribe);
+    auto full_check = ValidateData(*config);
+    ASSERT_FALSE(lazy_check.has_value());
+    ASSERT_FALSE(full_check.has_value());
+    EXPECT_EQ(lazy_check.error().line, 2u);
+    const ErrorSource config_source{"buf.cfg", config->data};
+    EXPECT_EQ(Message(lazy_check.error(), config_source), Message(full_check.error()));
+    const auto restored = ToPipelineError(lazy_check.error(), config_source);
+    ASSERT_TRUE(std::holds_alternative<ValidationError>(restored));
+    EXPECT_EQ(std::get<ValidationError>(restored).field_name, "key");
+    EXPECT_EQ(std::get<ValidationError>(restored).invalid_value, "has invalid_field");
+
+    // 處理錯誤不需要原文；讀檔錯誤的原文是檔名
+    auto lazy_process = ProcessData(ValidatedData{"x"}, kDescribe);
+    ASSERT_FALSE(lazy_process.has_value());
+    EXPECT_EQ(Message(lazy_process.error(), ErrorSource{}), Message(ProcessData(ValidatedData{"x"}).error()));
+    const ErrorDescriptor read{ErrorKind::kConfigRead, MessageId::kOpenFailed};
+    EXPECT_EQ(Message(read, ErrorSource{"missing.cfg", {}}), Message(PipelineError{ConfigReadError{"missing.cfg"}}));
+}
+
+// 情境二十八：with_context 在失敗時記下階段、檔案與位移，跨越巢狀管線由內而外累積
+TEST_F(ErrorCasesTest, WithContext_Records_Stage_File_And_Offset)
+{
+    static_assert(std::is_trivially_copyable_v<ContextStack<kDefaultContextDepth>>);
+
+    // 成功路徑與原本的管線相同
+    const std::string good = (dir / "ctx_good.cfg").string();
+    const std::string bad  = (dir / "ctx_bad.cfg").string();
+    std::ofstream(good) << "name = demo\nmode = fast\n";
+    std::ofstream(bad)  << "name = demo\nkey = invalid_field\n";
+    const auto traced = ConfigPipeline{}.with_context(7);
+    auto ok = traced(good);
+    ASSERT_TRUE(ok.has_value());
+    EXPECT_EQ(ok->final_result_code, ConfigPipeline{}(good)->final_result_code);
+
+    // 驗證失敗：第 1 段（ValidateStage）、檔案 7、第 2 行欄位的位移 12
+    auto failed = traced(bad);
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_TRUE(std::holds_alternative<ValidationError>(failed.error().error));
+    ASSERT_EQ(failed.error().context.size(), 1u);
+    EXPECT_EQ(failed.error().context[0], (ContextFrame{7, 12, 1}));
+    std::string text;
+    FormatTo(std::back_inserter(text), failed.error());
+    EXPECT_EQ(text, "Data Validation Error: Field 'key' has invalid value 'invalid_field' [stage 1, file 7, offset 12]");
+
+    // 內層管線的脈絡保留，外層再推一層
+    const auto inner = Pipeline<LoadStage, ValidateStage>{}.with_context(7);
+    const auto outer = Pipeline<std::remove_const_t<decltype(inner)>, ProcessStage>(inner, ProcessStage{}).with_context<2>(1);
+    auto nested = outer(bad);
+    ASSERT_FALSE(nested.has_value());
+    ASSERT_EQ(nested.error().context.size(), 2u);
+    EXPECT_EQ(nested.error().context[0], (ContextFrame{7, 12, 1}));
+    EXPECT_EQ(nested.error().context[1], (ContextFrame{1, 12, 0}));
+
+    // 錯誤帶有 offset 時記下位移；超過容量只計數
+    struct ParseStage
+    {
+        using Errors = meta::TypeList<kv::SyntaxError>;
+        auto operator()(std::string_view text) const { return kv::Parse(text); }
+    };
+    auto syntax = Pipeline<ParseStage>{}.with_context<1>(3)(std::string_view("a = 1\nbad key = 2\n"));
+    ASSERT_FALSE(syntax.has_value());
+    EXPECT_EQ(syntax.error().context[0], (ContextFrame{3, 6, 0}));
+    Traced<PipelineError, 1> full{ValidationError{}};
+    full.context.Push({1, 0, 0});
+    full.context.Push({2, 0, 0});
+    EXPECT_EQ(full.context.size(), 1u);
+    EXPECT_EQ(full.context.dropped(), 1u);
+}
+
+// 情境二十九：錯誤風暴時依內容去重、計數，只輸出取樣後的彙整
+TEST_F(ErrorCasesTest, ErrorReporter_Deduplicates_And_Summarizes)
+{
+    using Clock = report::ErrorReporter::Clock;
+    const auto start = Clock::now();
+    report::ErrorReporter reporter(4, 2, start);
+
+    // 同樣的錯誤從多個執行緒回報：只佔一個槽位
+    const PipelineError invalid = ValidationError{"invalid_field", "disallowed field"};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+        workers.emplace_back([&] { for (int i = 0; i < 10000; ++i) reporter.Report(invalid); });
+    for (auto& worker : workers)
+        worker.join();
+    reporter.Report(ConfigReadError{"a.cfg"});
+    reporter.Report(ConfigReadError{"a.cfg"});
+    reporter.Report(ConfigParseError{"malformed", 3});
+    reporter.Report(ProcessingError{"Data Processing", "Input data too short for task"});
+    // 4 個槽位已滿：之後的新錯誤只計數
+    reporter.Report(ConfigReadError{"b.cfg"});
+    EXPECT_EQ(report::HashOf(invalid), report::HashOf(PipelineError{ValidationError{"invalid_field", "disallowed field"}}));
+    EXPECT_NE(report::HashOf(invalid), report::HashOf(PipelineError{ValidationError{"invalid_fiel", "ddisallowed field"}}));
+
+    const auto summary = reporter.TakeSummary(start + std::chrono::seconds(10));
+    ASSERT_EQ(summary.lines.size(), 2u);
+    EXPECT_EQ(summary.lines[0].count, 40000u);
+    EXPECT_EQ(summary.lines[1].count, 2u);
+    EXPECT_EQ(summary.other_kinds, 2u);
+    EXPECT_EQ(summary.other_events, 2u);
+    EXPECT_EQ(summary.dropped, 1u);
+    EXPECT_EQ(summary.total(), 40005u);
+    std::ostringstream out;
+    report::WriteSummary(out, summary);
+    EXPECT_EQ(out.str(), "ValidationError{invalid_field} x 40000 in last 10s\n"
+                         "ConfigReadError{a.cfg} x 2 in last 10s\n"
+                         "(2 more kinds) x 2 in last 10s\n"
+                         "(untracked) x 1 in last 10s\n");
+
+    // 新窗口重新計數：沒有新錯誤時沒有任何一行
+    EXPECT_EQ(reporter.TakeSummary(start + std::chrono::seconds(20)).total(), 0u);
+    reporter.Report(invalid);
+    const auto next = reporter.TakeSummary(start + std::chrono::seconds(21));
+    ASSERT_EQ(next.lines.size(), 1u);
+    EXPECT_EQ(report::LabelOf(next.lines[0].sample), "ValidationError{invalid_field}");
+    EXPECT_EQ(next.window, std::chrono::seconds(1));
+}
+
+// 情境三十：規則集編譯一次，單次走訪回報所有不合規的欄位
+TEST_F(ErrorCasesTest, RuleEngine_Reports_Every_Violation_In_One_Pass)
+{
+    auto program = rules::RuleSet{}
+        .Required("name")
+        .Required("port")
+        .Range("port", 1, 65535)
+        .OneOf("mode", {"fast", "safe"})
+        .Matches("id", "[a-z]+-[0-9]+")
+        .MaxLength("name", 8)
+        .Forbid(std::string(rules::kAnyField), "invalid_field")
+        .Compile();
+    ASSERT_TRUE(program.has_value());
+    EXPECT_EQ(program->key_count(), 4u);
+
+    // 全部通過
+    auto good = kv::Parse("name = demo\nport = 8080\nmode = safe\nid = cfg-42\nextra = ok\n");
+    ASSERT_TRUE(good.has_value());
+    EXPECT_TRUE(program->Evaluate(*good).empty());
+
+    // 每個不合規的欄位各一筆（依鍵排序），包括缺少的必填欄位
+    auto bad = kv::Parse("name = much_too_long\nmode = slow\nid = CFG-42\nextra = has invalid_field\nport = 0\n");
+    ASSERT_TRUE(bad.has_value());
+    const auto errors = program->Evaluate(*bad);
+    std::vector<std::string> names;
+    for (const auto& e : errors)
+        names.push_back(e.field_name);
+    EXPECT_EQ(names, (std::vector<std::string>{"extra", "id", "mode", "name", "port"}));
+    EXPECT_EQ(errors[2].invalid_value, "slow");
+    // 每一筆都指回出錯欄位在原文中的位移
+    std::vector<std::size_t> offsets;
+    for (const auto& e : errors)
+        offsets.push_back(e.offset);
+    EXPECT_EQ(offsets, (std::vector<std::size_t>{45, 33, 21, 0, 71}));
+
+    auto missing = kv::Parse("mode = fast\n");
+    ASSERT_TRUE(missing.has_value());
+    const auto absent = program->Evaluate(*missing);
+    ASSERT_EQ(absent.size(), 2u);
+    EXPECT_EQ(absent[0].field_name, "name");
+    EXPECT_EQ(absent[1].invalid_value, "missing required field");
+    // 缺少的欄位沒有原文位置：記為最後一個欄位的結尾
+    EXPECT_EQ(absent[0].offset, 11u);
+    EXPECT_EQ(absent[1].offset, 11u);
+
+    // 經由 Config：與 ValidateData 的單一規則使用同樣的欄位表
+    auto config = LoadConfigFromBuffer("rules.cfg", std::string("name = demo\nport = 70000\n"));
+    ASSERT_TRUE(config.has_value());
+    auto checked = program->Validate(*config);
+    ASSERT_FALSE(checked.has_value());
+    ASSERT_EQ(checked.error().size(), 1u);
+    EXPECT_EQ(checked.error()[0].field_name, "port");
+    EXPECT_EQ(checked.error()[0].offset, 12u);
+
+    // 未解析的 Config：語法錯誤同樣記錄位移
+    auto syntax = program->Validate(Config{"name = demo\nbad line\n"});
+    ASSERT_FALSE(syntax.has_value());
+    ASSERT_EQ(syntax.error().size(), 1u);
+    EXPECT_EQ(syntax.error()[0].offset, 12u);
+
+    // 規則本身有誤時在編譯期回報
+    auto broken = rules::RuleSet{}.Range("a", 5, 1).Compile();
+    ASSERT_FALSE(broken.has_value());
+    EXPECT_EQ(broken.error().rule, 0u);
+    EXPECT_FALSE(rules::RuleSet{}.Required("a").Matches("b", "(").Compile().has_value());
+}
+
+// 情境三十一：收集模式一次執行回報所有彼此獨立的解析與驗證錯誤；預設管線仍在第一個錯誤停下
+TEST_F(ErrorCasesTest, CollectAll_Pipeline_Reports_Every_Independent_Error)
+{
+    auto p = make_file_with(dir, "many.cfg",
+        "mode = fast\nthis is malformed\nbad key = 1\nname = invalid_field\n= empty\nflag = has invalid_field\n");
+
+    // 預設（FailFast）：只有第一個錯誤
+    auto first = ConfigPipeline{}(p.string());
+    ASSERT_FALSE(first.has_value());
+    ASSERT_TRUE(std::holds_alternative<ConfigParseError>(first.error()));
+    EXPECT_EQ(std::get<ConfigParseError>(first.error()).line_number, 2);
+
+    // CollectAll：malformed 那一行、兩個語法錯誤的欄位、兩個違規欄位
+    auto all = CollectingConfigPipeline{}(p.string());
+    ASSERT_FALSE(all.has_value());
+    const auto& errors = all.error();
+    ASSERT_EQ(errors.size(), 5u);
+    EXPECT_FALSE(errors.is_inline());
+    std::vector<int> parse_lines;
+    std::vector<std::string> fields;
+    for (const auto& e : errors)
+    {
+        if (const auto* parse = std::get_if<ConfigParseError>(&e))
+            parse_lines.push_back(parse->line_number);
+        else if (const auto* invalid = std::get_if<ValidationError>(&e))
+            fields.push_back(invalid->field_name);
+        else
+            ADD_FAILURE() << "預期只有解析與驗證錯誤";
+    }
+    EXPECT_EQ(parse_lines, (std::vector<int>{2, 3, 5}));
+    EXPECT_EQ(fields, (std::vector<std::string>{"name", "flag"}));
+
+    // 沒有錯誤時與預設管線結果相同；讀檔失敗只有一筆
+    auto good = make_file_with(dir, "good.cfg", "alpha = 1\nbeta = 2\n");
+    auto ok = CollectingConfigPipeline{}(good.string());
+    ASSERT_TRUE(ok.has_value());
+    EXPECT_EQ(ok->final_result_code, ConfigPipeline{}(good.string())->final_result_code);
+    auto missing = CollectingConfigPipeline{}((dir / "missing.cfg").string());
+    ASSERT_FALSE(missing.has_value());
+    ASSERT_EQ(missing.error().size(), 1u);
+    EXPECT_TRUE(missing.error().is_inline());
+    EXPECT_TRUE(std::holds_alternative<ConfigReadError>(missing.error()[0]));
+
+    // 只有語法錯誤時，其餘欄位照常驗證並通過：只回報那一筆
+    auto syntax = CollectingConfigPipeline{}(make_file_with(dir, "syntax.cfg", "alpha = 1\nbad key = 2\n").string());
+    ASSERT_FALSE(syntax.has_value());
+    ASSERT_EQ(syntax.error().size(), 1u);
+    EXPECT_EQ(std::get<ConfigParseError>(syntax.error()[0]).line_content, "bad key = 2");
+
+    // 只組合部分階段：錯誤轉成較窄的 variant
+    using Front = BasicPipeline<CollectAll, LoadStage, ValidateStage>;
+    auto front = Front{}(p.string());
+    ASSERT_FALSE(front.has_value());
+    static_assert(std::is_same_v<std::remove_cvref_t<decltype(front.error()[0])>, Front::Error>);
+    EXPECT_EQ(front.error().size(), 5u);
+}
+
+// 情境三十二：預先編譯的二進位快照跳過解析與驗證；過期或損毀時回報原因並退回文字路徑
+TEST_F(ErrorCasesTest, BinaryImage_Skips_Parsing_And_Falls_Back_When_Unusable)
+{
+    auto source = make_file_with(dir, "image.cfg", "name = demo\nport = 8080\n# comment\nmode = fast\n").string();
+    const std::string image_path = binary::ImagePathFor(source);
+    std::filesystem::remove(image_path);
+
+    // 尚未編譯：退回文字路徑，結果相同
+    binary::ImageError fallback;
+    auto text = binary::LoadValidated(source, &fallback);
+    ASSERT_TRUE(text.has_value());
+    EXPECT_EQ(fallback.fault, binary::Fault::kOpen);
+
+    ASSERT_TRUE(binary::CompileImage(source).has_value());
+    auto image = binary::LoadImage(image_path, source);
+    ASSERT_TRUE(image.has_value());
+    ASSERT_EQ(image->size(), 3u);
+    EXPECT_EQ((*image)[0].key, "mode");
+    EXPECT_EQ((*image)[2].line, 2);
+    EXPECT_EQ(image->Find("port"), std::optional<std::string_view>("8080"));
+    EXPECT_FALSE(image->Find("missing").has_value());
+
+    // 快照可用：不經過文字路徑，結果與文字路徑逐位元組相同
+    fallback = {};
+    auto fast = binary::LoadValidated(source, &fallback);
+    ASSERT_TRUE(fast.has_value());
+    EXPECT_TRUE(fallback.path.empty());
+    EXPECT_EQ(fast->str(), text->str());
+    EXPECT_EQ(binary::ImagePipeline{}(source)->final_result_code, ConfigPipeline{}(source)->final_result_code);
+
+    // 損毀：雜湊不符
+    {
+        std::fstream f(image_path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(-1, std::ios::end);
+        f.put('X');
+    }
+    auto corrupt = binary::LoadImage(image_path, source);
+    ASSERT_FALSE(corrupt.has_value());
+    EXPECT_EQ(corrupt.error().fault, binary::Fault::kChecksum);
+    EXPECT_EQ(binary::ToString(corrupt.error().fault), "image checksum mismatch");
+    EXPECT_TRUE(binary::LoadValidated(source).has_value());
+
+    // 過期：來源檔已改寫
+    ASSERT_TRUE(binary::CompileImage(source).has_value());
+    make_file_with(dir, "image.cfg", "name = demo\nport = 9090\nmode = fast\nextra = 1\n");
+    fallback = {};
+    auto updated = binary::LoadValidated(source, &fallback);
+    ASSERT_TRUE(updated.has_value());
+    EXPECT_EQ(fallback.fault, binary::Fault::kStale);
+    EXPECT_NE(updated->processed_data.find("9090"), std::string::npos);
+
+    // 不是快照檔
+    make_file_with(dir, "image.cfg.cfgbin", "name = demo\n");
+    EXPECT_EQ(binary::LoadImage(image_path, source).error().fault, binary::Fault::kBadMagic);
+
+    // 驗證不通過的設定不會寫成快照：錯誤為驗證錯誤
+    auto bad = make_file_with(dir, "invalid_image.cfg", "key = invalid_field\n").string();
+    auto compiled = binary::CompileImage(bad);
+    ASSERT_FALSE(compiled.has_value());
+    EXPECT_TRUE(std::holds_alternative<ValidationError>(compiled.error()));
+    EXPECT_FALSE(std::filesystem::exists(binary::ImagePathFor(bad)));
+}
+
+// 情境三十三：緩衝區重用的管線在穩定狀態下每次執行都取自物件池，不配置記憶體
+TEST_F(ErrorCasesTest, PooledPipeline_Reuses_Buffers_Without_Allocating)
+{
+    using StringPool = pool::Pool<std::string>;
+    using ConfigPool = pool::Pool<Config>;
+
+    std::string text;
+    for (int i = 0; i < 200; ++i)
+        text += "key_" + std::to_string(i) + " = value_" + std::to_string(i) + "\n";
+    const std::string path = make_file_with(dir, "pooled.cfg", text).string();
+    constexpr PooledConfigPipeline pipeline{};
+
+    // 第一次執行建立緩衝區（以及預設日誌後端的行緩衝區）；之後的執行沿用它們的容量
+    auto warm = pipeline(path);
+    ASSERT_TRUE(warm.has_value());
+    EXPECT_EQ(warm->final_result_code, ConfigPipeline{}(path)->final_result_code);
+
+    // 每次執行各取一個內容緩衝區與 Config：全部命中，且整條管線（含預設日誌後端）不配置
+    constexpr std::size_t kRuns = 50;
+    const pool::Stats strings = StringPool::local_stats();
+    const pool::Stats configs = ConfigPool::local_stats();
+    g_allocations       = 0;
+    g_count_allocations = true;
+    for (std::size_t run = 0; run < kRuns; ++run)
+    {
+        auto r = pipeline(path);
+        EXPECT_TRUE(r.has_value());
+    }
+    g_count_allocations = false;
+    EXPECT_EQ(g_allocations, 0u);
+    EXPECT_EQ(StringPool::local_stats().hits - strings.hits, kRuns);
+    EXPECT_EQ(StringPool::local_stats().misses, strings.misses);
+    EXPECT_EQ(ConfigPool::local_stats().hits - configs.hits, kRuns);
+    EXPECT_EQ(ConfigPool::local_stats().misses, configs.misses);
+
+    // 失敗路徑同樣歸還緩衝區（錯誤本身仍會配置），之後的成功執行照樣不配置
+    const std::string bad = make_file_with(dir, "pooled_bad.cfg", text + "extra = invalid_field\n").string();
+    auto failed = pipeline(bad);
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_TRUE(std::holds_alternative<ValidationError>(failed.error()));
+    const pool::Stats after_failure = StringPool::local_stats();
+    g_allocations       = 0;
+    g_count_allocations = true;
+    auto again = pipeline(path);
+    g_count_allocations = false;
+    EXPECT_TRUE(again.has_value());
+    EXPECT_EQ(g_allocations, 0u);
+    EXPECT_EQ(StringPool::local_stats().hits - after_failure.hits, 1u);
+    EXPECT_EQ(StringPool::local_stats().misses, after_failure.misses);
+
+    // 物件池：歸還的物件清空內容、保留容量；每個執行緒的快取有上限
+    std::string buffer = pool::Pool<std::string>::Acquire();
+    buffer.assign(4096, 'x');
+    const std::size_t capacity = buffer.capacity();
+    pool::Pool<std::string>::Release(std::move(buffer));
+    const std::string reused = pool::Pool<std::string>::Acquire();
+    EXPECT_TRUE(reused.empty());
+    EXPECT_GE(reused.capacity(), capacity);
+    for (std::size_t i = 0; i < pool::kLocalCapacity * 3; ++i)
+        pool::Pool<std::string>::Release(std::string(64, 'y'));
+    EXPECT_LE(pool::Pool<std::string>::local_size(), pool::kLocalCapacity);
+
+    // 其他執行緒有自己的快取
+    std::size_t other_local = 1;
+    std::thread([&] { other_local = pool::Pool<std::string>::local_size(); }).join();
+    EXPECT_EQ(other_local, 0u);
+}
+
+// 情境三十四：故障注入 -> 由外部規格設定機率；命中時回傳與真正錯誤同型別、內容為 kInjectedDetail 的錯誤
+TEST_F(ErrorCasesTest, FaultInjection_Plan_And_Injected_Errors)
+{
+    using fault::Stage;
+
+    // 規格文字：階段與種類的名稱即量測層與錯誤碼的名稱
+    auto plan = fault::ParsePlan(" LoadConfig.ConfigReadError=0.25, ValidateData.ValidationError = 1 ,");
+    ASSERT_TRUE(plan.has_value());
+    EXPECT_DOUBLE_EQ(plan->Total(Stage::kLoadConfig), 0.25);
+    EXPECT_DOUBLE_EQ(plan->Total(Stage::kValidateData), 1.0);
+    EXPECT_DOUBLE_EQ(plan->Total(Stage::kProcessData), 0.0);
+    EXPECT_EQ(fault::ParsePlan("Parse.ConfigReadError=0.1").error().reason, "unknown stage");
+    EXPECT_EQ(fault::ParsePlan("LoadConfig.Oops=0.1").error().reason, "unknown error kind");
+    EXPECT_EQ(fault::ParsePlan("LoadConfig.ConfigReadError=1.5").error().reason, "probability must be between 0 and 1");
+    EXPECT_EQ(fault::ParsePlan("LoadConfig.ConfigReadError=0.6,LoadConfig.ConfigParseError=0.6").error().offset, 31u);
+    EXPECT_TRUE(fault::ParsePlan("").has_value());
+
+    // 機率 1 必定命中、0 永不命中；其他機率接近設定值
+    fault::Configure(*plan);
+    int hits = 0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        EXPECT_EQ(fault::Roll(Stage::kValidateData), ErrorKind::kValidation);
+        EXPECT_FALSE(fault::Roll(Stage::kProcessData).has_value());
+        if (const auto kind = fault::Roll(Stage::kLoadConfig))
+        {
+            EXPECT_EQ(*kind, ErrorKind::kConfigRead);
+            ++hits;
+        }
+    }
+    EXPECT_NEAR(hits / 20000.0, 0.25, 0.02);
+
+    // 注入的錯誤與真正的錯誤同型別，內容可辨識
+    const auto injected = fault::MakeError(ErrorKind::kValidation);
+    ASSERT_TRUE(std::holds_alternative<ValidationError>(injected));
+    EXPECT_EQ(std::get<ValidationError>(injected).invalid_value, fault::kInjectedDetail);
+
+    // 包裝後的管線：開啟時 ValidateData 必定失敗且不執行後續階段，關閉時與 ConfigPipeline 相同
+    const std::string path = make_file_with(dir, "faulty.cfg", "valid_data_content").string();
+    fault::Configure(fault::Plan{}.Set(Stage::kValidateData, ErrorKind::kValidation, 1.0));
+    auto r = fault::FaultyConfigPipeline{}(path);
+    if (CONFIG_FAULTS)
+    {
+        ASSERT_FALSE(r.has_value());
+        ASSERT_TRUE(std::holds_alternative<ValidationError>(r.error()));
+        EXPECT_EQ(std::get<ValidationError>(r.error()).invalid_value, fault::kInjectedDetail);
+    }
+    else
+        EXPECT_TRUE(r.has_value());
+
+    // 停止注入後恢復正常
+    fault::Clear();
+    EXPECT_FALSE(fault::Roll(Stage::kValidateData).has_value());
+    EXPECT_TRUE(fault::FaultyConfigPipeline{}(path).has_value());
+}
+
+// 情境三十五：負載產生器 -> 固定速率送出、成功與失敗分開統計延遲
+TEST_F(ErrorCasesTest, LoadGenerator_Paces_Requests_And_Splits_Latency)
+{
+    // 兩個執行緒合計每秒 2000 個請求，跑 100 毫秒：約 200 個；每 4 個請求失敗 1 個
+    std::atomic<int> calls{0};
+    const auto report = load::Run(load::Options{2000, 2, std::chrono::milliseconds(100)},
+                                  [&](std::size_t) { return calls.fetch_add(1) % 4 != 0; });
+    EXPECT_EQ(report.requests, static_cast<std::uint64_t>(calls.load()));
+    EXPECT_GE(report.requests, 180u);
+    EXPECT_LE(report.requests, 202u);
+    EXPECT_EQ(report.latency.count, report.requests);
+    EXPECT_EQ(report.success_latency.count + report.failure_latency.count, report.requests);
+    EXPECT_EQ(report.failures, report.failure_latency.count);
+    EXPECT_NEAR(report.error_ratio(), 0.25, 0.02);
+    EXPECT_GT(report.throughput(), 0.0);
+    EXPECT_LE(report.latency.Percentile(0.5), report.latency.Percentile(0.99));
+
+    // 不限速：每個請求一結束就送下一個
+    const auto closed = load::Run(load::Options{0, 1, std::chrono::milliseconds(10)}, [](std::size_t) { return true; });
+    EXPECT_GT(closed.requests, 1000u);
+    EXPECT_EQ(closed.failures, 0u);
+
+    // 錯誤比例掃描：每個比例一份報表；注入關閉時實際比例皆為 0
+    struct NullSink : logging::Sink
+    {
+        void Write(logging::Level, std::string_view, std::string_view) override {}
+    } null_sink;
+    logging::SetSink(&null_sink);
+    const std::string path = make_file_with(dir, "load.cfg", "valid_data_content").string();
+    const double ratios[] = {0.0, 0.5};
+    const auto reports = load::SweepErrorRatios(load::Options{5000, 2, std::chrono::milliseconds(50)}, path,
+                                                fault::Stage::kLoadConfig, ErrorKind::kConfigRead, ratios);
+    logging::SetSink(nullptr);
+    ASSERT_EQ(reports.size(), 2u);
+    EXPECT_EQ(reports[0].failures, 0u);
+    if (CONFIG_FAULTS)
+        EXPECT_NEAR(reports[1].error_ratio(), 0.5, 0.15);
+    else
+        EXPECT_EQ(reports[1].failures, 0u);
+    EXPECT_FALSE(fault::Roll(fault::Stage::kLoadConfig).has_value());
+
+    std::ostringstream out;
+    load::WriteReports(out, reports);
+    const std::string table = out.str();
+    EXPECT_EQ(std::count(table.begin(), table.end(), '\n'), 3);
+}
+
+// 管線結果的文字形式（錯誤型別沒有 operator==：比較訊息即可涵蓋每個欄位）
+static std::string OutcomeText(const wire::Outcome& outcome)
+{
+    if (outcome)
+        return "ok " + std::to_string(outcome->final_result_code);
+    std::string text = std::to_string(outcome.error().index()) + " ";
+    FormatTo(std::back_inserter(text), outcome.error());
+    return text;
+}
+
+// 情境三十六：線路格式 -> PipelineError 的四個成員與成功結果往返不失真；截斷、未知成員、多餘位元組回報 DecodeError
+TEST_F(ErrorCasesTest, Wire_RoundTrips_Every_Pipeline_Error)
+{
+    const std::vector<wire::Outcome> outcomes{
+        Result{42},
+        std::unexpected(PipelineError{ConfigReadError{"missing.cfg"}}),
+        std::unexpected(PipelineError{ConfigParseError{"key = = value", 7, 40}}),
+        std::unexpected(PipelineError{ValidationError{"port", std::string("70\0000", 4)}}),
+        std::unexpected(PipelineError{ProcessingError{std::string(kProcessingTask), ""}}),
+    };
+    std::string frame;
+    wire::AppendResults(frame, 9, 3, outcomes);
+
+    // 訊框：長度欄位 + 種類 + 內容
+    const auto length = wire::FrameLength(std::string_view(frame).substr(0, wire::kLengthSize));
+    ASSERT_TRUE(length.has_value());
+    EXPECT_EQ(*length + wire::kLengthSize, frame.size());
+    EXPECT_EQ(static_cast<wire::Message>(frame[wire::kLengthSize]), wire::Message::kResults);
+    const std::string_view body = std::string_view(frame).substr(wire::kLengthSize + 1);
+
+    const auto decoded = wire::ParseResults(body);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->id, 9u);
+    EXPECT_EQ(decoded->first, 3u);
+    ASSERT_EQ(decoded->outcomes.size(), outcomes.size());
+    for (std::size_t i = 0; i < outcomes.size(); ++i)
+        EXPECT_EQ(OutcomeText(decoded->outcomes[i]), OutcomeText(outcomes[i])) << "record " << i;
+    EXPECT_EQ(std::get<ConfigParseError>(decoded->outcomes[2].error()).offset, 40u);
+
+    // u32 容不下的位移不截斷成另一個位置
+    std::string distant;
+    const std::vector<wire::Outcome> far{std::unexpected(PipelineError{ValidationError{"port", "0", (std::size_t{1} << 32) + 5}})};
+    wire::AppendResults(distant, 1, 0, far);
+    const auto far_decoded = wire::ParseResults(std::string_view(distant).substr(wire::kLengthSize + 1));
+    ASSERT_TRUE(far_decoded.has_value());
+    EXPECT_EQ(std::get<ValidationError>(far_decoded->outcomes[0].error()).offset, wire::kUnknownOffset);
+
+    // 截斷：任何長度都不會越界，且回報錯誤
+    for (std::size_t cut = 0; cut < body.size(); ++cut)
+        EXPECT_FALSE(wire::ParseResults(body.substr(0, cut)).has_value()) << "cut at " << cut;
+    // 多餘的位元組
+    EXPECT_EQ(wire::ParseResults(std::string(body) + '\0').error().reason, "trailing bytes in message");
+
+    // 未知的成員標記（較新版本新增的錯誤型別）
+    std::string unknown;
+    wire::Writer w(unknown);
+    w.U32(1);
+    w.U32(0);
+    w.U32(1);
+    w.U8(static_cast<std::uint8_t>(1 + std::variant_size_v<PipelineError>));
+    w.U32(0);
+    EXPECT_EQ(wire::ParseResults(unknown).error().reason, "unknown error alternative");
+
+    // 長度超過上限的訊框在讀取內容之前就拒絕
+    std::string huge;
+    wire::Writer(huge).U32(wire::kMaxFrameSize + 1);
+    EXPECT_FALSE(wire::FrameLength(huge).has_value());
+
+    // 批次往返；偽造的筆數不會造成大量預留
+    std::string batch;
+    const std::vector<BufferedConfig> configs{{"a.cfg", "valid_data_content"}, {"b.cfg", "malformed"}};
+    wire::AppendBatch(batch, 5, configs);
+    const auto parsed = wire::ParseBatch(std::string_view(batch).substr(wire::kLengthSize + 1));
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(parsed->configs.size(), 2u);
+    EXPECT_EQ(parsed->configs[1].name, "b.cfg");
+    EXPECT_EQ(parsed->configs[1].content, "malformed");
+    std::string forged;
+    wire::Writer f(forged);
+    f.U32(1);
+    f.U32(0xFFFFFFFFu);
+    EXPECT_FALSE(wire::ParseBatch(forged).has_value());
+}
+
+// 情境三十七：分散式驗證 -> 兩個節點依名稱分片，結果與本機 RunBatch 相同且依輸入順序；佇列深度超過上限時回覆 BusyError；批次依編碼大小切分
+TEST_F(ErrorCasesTest, ShardedService_Matches_Local_Batch_And_Applies_Backpressure)
+{
+    fault::Clear();
+    std::vector<BufferedConfig> configs;
+    for (int i = 0; i < 200; ++i)
+    {
+        static const char* const kContents[] = {"valid_data_content", "malformed content", "valid_data\ninvalid_field", "short"};
+        configs.push_back({"node_" + std::to_string(i) + ".cfg", kContents[i % 4]});
+    }
+
+    auto first  = service::Server::Start(service::ServerOptions{0, 2, 1 << 16, 16});
+    auto second = service::Server::Start(service::ServerOptions{0, 2, 1 << 16, 16});
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    const service::Endpoint nodes[] = {{"127.0.0.1", (*first)->port()}, {"127.0.0.1", (*second)->port()}};
+
+    // 兩個節點都分到項目
+    std::size_t on_first = 0;
+    for (const auto& config : configs)
+        on_first += service::ShardOf(config.name, 2) == 0;
+    EXPECT_GT(on_first, 0u);
+    EXPECT_LT(on_first, configs.size());
+
+    // 小批次：每個節點收到多個批次，每個批次分成多個 kResults 訊框
+    auto remote = service::ValidateSharded(nodes, configs, service::ShardOptions{50, 8});
+    ASSERT_TRUE(remote.has_value());
+    WorkStealingPool pool(2);
+    std::vector<BufferedConfig> copies = configs;
+    const auto local = RunBatch(pool, std::span<BufferedConfig>(copies));
+    ASSERT_EQ(remote->size(), local.size());
+    for (std::size_t i = 0; i < local.size(); ++i)
+        EXPECT_EQ(OutcomeText((*remote)[i]), OutcomeText(local[i])) << configs[i].name;
+    EXPECT_EQ((*first)->queue_depth(), 0u);
+
+    // 背壓：上限 2 筆的節點拒收 3 筆的批次，但同一條連線仍可繼續送
+    auto tight = service::Server::Start(service::ServerOptions{0, 1, 2, 16});
+    ASSERT_TRUE(tight.has_value());
+    auto client = service::Client::Connect({"127.0.0.1", (*tight)->port()});
+    ASSERT_TRUE(client.has_value());
+    const auto busy = client->Validate(std::span<const BufferedConfig>(configs).first(3));
+    ASSERT_FALSE(busy.has_value());
+    const auto* error = std::get_if<service::BusyError>(&busy.error());
+    ASSERT_NE(error, nullptr);
+    EXPECT_EQ(error->queue_depth, 0u);
+    EXPECT_EQ(error->limit, 2u);
+    const auto accepted = client->Validate(std::span<const BufferedConfig>(configs).first(2));
+    ASSERT_TRUE(accepted.has_value());
+    EXPECT_EQ(OutcomeText((*accepted)[0]), OutcomeText(local[0]));
+
+    // 分片客戶端遇到上限較小的節點時自動縮小批次
+    const service::Endpoint single[] = {{"127.0.0.1", (*tight)->port()}};
+    auto shrunk = service::ValidateSharded(single, configs, service::ShardOptions{64, 8});
+    ASSERT_TRUE(shrunk.has_value());
+    EXPECT_EQ(OutcomeText(shrunk->back()), OutcomeText(local.back()));
+
+    // 大型設定：筆數遠低於 max_batch，但合併後超過訊框上限時照編碼大小分成多個批次
+    std::vector<BufferedConfig> large{{"large_a.cfg", std::string(wire::kMaxFrameSize / 2, 'v')},
+                                      {"large_b.cfg", std::string(wire::kMaxFrameSize / 2, 'v')}};
+    const service::Endpoint one[] = {{"127.0.0.1", (*first)->port()}};
+    auto split = service::ValidateSharded(one, large);
+    ASSERT_TRUE(split.has_value());
+    ASSERT_EQ(split->size(), 2u);
+    EXPECT_TRUE((*split)[0].has_value());
+    EXPECT_TRUE((*split)[1].has_value());
+    // 單筆就超過上限：不送出，連線仍可使用
+    large[0].content.resize(wire::kMaxFrameSize);
+    auto direct = service::Client::Connect(one[0]);
+    ASSERT_TRUE(direct.has_value());
+    const auto refused = direct->Validate(std::span<const BufferedConfig>(large).first(1));
+    ASSERT_FALSE(refused.has_value());
+    const auto* oversize = std::get_if<service::NetError>(&refused.error());
+    ASSERT_NE(oversize, nullptr);
+    EXPECT_EQ(oversize->code, EMSGSIZE);
+    EXPECT_TRUE(direct->Validate(std::span<const BufferedConfig>(configs).first(2)).has_value());
+
+    // 沒有節點在聽的連接埠
+    (*tight)->Stop();
+    EXPECT_TRUE(std::holds_alternative<service::NetError>(service::ValidateSharded(single, configs).error()));
+}
+
+// 情境三十八：配置政策 -> 每種大頁與 NUMA 組合的讀檔、mmap 與批次結果都與預設相同；小於門檻的緩衝區不處理
+TEST_F(ErrorCasesTest, MemoryPolicy_Preserves_Results_For_Every_Combination)
+{
+    // 超過一個大頁的設定：一般版與哨兵在最後的解析錯誤版
+    std::string content;
+    for (int i = 0; content.size() < 3 * memory::kHugePageSize; ++i)
+        content += "key_" + std::to_string(i) + " = value\n";
+    const auto good = (dir / "large.cfg").string();
+    const auto bad  = (dir / "large_bad.cfg").string();
+    std::ofstream(good) << content;
+    std::ofstream(bad)  << content << "malformed";
+
+    const auto expected_good = LoadConfig(good).and_then([](Config&& c) { return ValidateData(std::move(c)); })
+                                               .and_then([](ValidatedData&& v) { return ProcessData(std::move(v)); });
+    ASSERT_TRUE(expected_good.has_value());
+    const auto expected_bad = LoadConfig(bad);
+    ASSERT_FALSE(expected_bad.has_value());
+
+    using memory::HugePages;
+    using memory::Placement;
+    for (const auto huge : {HugePages::kNone, HugePages::kTransparent, HugePages::kExplicit})
+    {
+        for (const auto placement : {Placement::kDefault, Placement::kFirstTouch, Placement::kBind})
+        {
+            const memory::Policy policy{huge, placement};
+            SCOPED_TRACE(static_cast<int>(huge) * 3 + static_cast<int>(placement));
+
+            auto loaded = LoadConfig(good, policy);
+            ASSERT_TRUE(loaded.has_value());
+            EXPECT_EQ(loaded->data, content);
+            const auto result = ValidateData(std::move(*loaded)).and_then([](ValidatedData&& v) { return ProcessData(std::move(v)); });
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(result->final_result_code, expected_good->final_result_code);
+
+            const auto parse = LoadConfig(bad, policy);
+            ASSERT_FALSE(parse.has_value());
+            EXPECT_EQ(std::get<ConfigParseError>(parse.error()).line_number,
+                      std::get<ConfigParseError>(expected_bad.error()).line_number);
+
+            // mmap 模式：匿名映射的內容與檔案相同且唯讀語意不變
+            const auto mapped = LoadConfigMapped(good, policy);
+            ASSERT_TRUE(mapped.has_value());
+            EXPECT_EQ(mapped->data, content);
+            EXPECT_TRUE(ValidateData(*mapped).has_value());
+            EXPECT_FALSE(LoadConfigMapped(bad, policy).has_value());
+            EXPECT_TRUE(std::holds_alternative<ConfigReadError>(LoadConfigMapped((dir / "missing.cfg").string(), policy).error()));
+        }
+    }
+
+    // 管線選項：批次結果與預設相同
+    const std::vector<std::string> paths{good, bad, good};
+    const auto pooled  = RunBatch(paths, BatchOptions{2});
+    const auto policed = RunBatch(paths, BatchOptions{2, {HugePages::kTransparent, Placement::kBind}});
+    ASSERT_EQ(policed.size(), pooled.size());
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        ASSERT_EQ(policed[i].has_value(), pooled[i].has_value());
+        if (pooled[i])
+            EXPECT_EQ(policed[i]->final_result_code, pooled[i]->final_result_code);
+        else
+            EXPECT_EQ(policed[i].error().index(), pooled[i].error().index());
+    }
+
+    // 門檻與對齊：小緩衝區、關閉的政策都不做事；匿名映射長度對齊頁（MAP_HUGETLB 時對齊大頁）
+    std::string small(1024, 'x');
+    EXPECT_FALSE(memory::Prepare(small.data(), small.size(), {HugePages::kTransparent}));
+    EXPECT_FALSE(memory::Prepare(content.data(), content.size(), {}));
+    const auto mapping = memory::MapAnonymous(memory::kHugePageSize + 1, {HugePages::kExplicit, Placement::kBind});
+    ASSERT_TRUE(mapping.has_value());
+    EXPECT_GE(mapping->length, memory::kHugePageSize + 1);
+    EXPECT_EQ(mapping->length % (mapping->huge_tlb ? memory::kHugePageSize : static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))), 0u);
+    ::munmap(mapping->address, mapping->length);
+    EXPECT_GE(memory::CurrentNode(), 0);
+}
+
+// 編譯: g++ -std=gnu++23 Basic.cpp Config.cpp Scanner.cpp FileCache.cpp KeyValue.cpp BatchExecutor.cpp AsyncLoader.cpp IoRing.cpp Task.cpp IoContext.cpp HotReload.cpp ErrorReport.cpp RuleEngine.cpp BinaryConfig.cpp FaultInjection.cpp LoadGenerator.cpp Wire.cpp ValidationService.cpp MemoryPolicy.cpp Log.cpp Metrics.cpp -I. -lgtest_main -lgtest -pthread -o test_basic
 // 執行: ./test_basic
 
 // 執行結果如下
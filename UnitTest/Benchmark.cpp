@@ -0,0 +1,558 @@
+// Benchmark.cpp
+// Google Benchmark：量測 expected/variant 管線在不同資料量與錯誤位置下的成本，並以例外版本作為基準
+#include <benchmark/benchmark.h>
+#include "Config.h"            // 官方Template
+#include "Pipeline.h"          // 編譯期組合的管線
+#include "KeyValue.h"          // kv::Parse / kv::Table
+#include "Log.h"               // 日誌後端（量測時換成不輸出的後端）
+#include "ByteTransform.h"     // bytes::OffsetNonZero
+#include "Demo.h"              // demo::LoadAndParse
+#include "MemoryPolicy.h"      // memory::Policy
+#include "ErrorFormat.h"       // config::FormatTo
+#include "ErrorReport.h"       // report::ErrorReporter
+#include "RuleEngine.h"        // rules::RuleSet / rules::Program
+#include "BinaryConfig.h"      // binary::CompileImage / binary::LoadValidated
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    // 量測時不輸出任何日誌（亦可以 -DCONFIG_LOG_LEVEL=4 在編譯期完全移除）
+    struct NullSink : logging::Sink
+    {
+        void Write(logging::Level, std::string_view, std::string_view) override {}
+    };
+
+    // 錯誤位置：0 = 成功；1/2/3 = 第幾個階段失敗
+    enum ErrorAt : std::int64_t { kSuccess = 0, kStage1 = 1, kStage2 = 2, kStage3 = 3 };
+
+    // 測試檔案：依 (資料量, 錯誤位置, 種類) 建立一次後重複使用，程式結束時刪除
+    class Fixtures
+    {
+    public:
+        Fixtures()
+        {
+            dir_ = fs::temp_directory_path() / "cfg_pipeline_bench";
+            fs::create_directories(dir_);
+            logging::SetSink(&null_sink_);
+        }
+        ~Fixtures()
+        {
+            logging::SetSink(nullptr);
+            std::error_code ec;
+            fs::remove_all(dir_, ec);
+        }
+
+        // config 管線的輸入：哨兵放在最後，迫使掃描走完整個檔案
+        const std::string& ConfigFile(std::size_t size, std::int64_t error_at)
+        {
+            const char* tail = error_at == kStage1 ? "\nmalformed" : error_at == kStage2 ? "\ninvalid_field" : "";
+            return Make("cfg", size, error_at, tail);
+        }
+
+        // demo 管線的輸入：stage 1 = ReadAll 失敗（IOError），stage 2 = ParseConfig 失敗（BadFormat）
+        const std::string& DemoFile(std::size_t size, std::int64_t error_at)
+        {
+            const char* tail = error_at == kStage1 ? "TRIGGER_IO_ERROR" : error_at == kStage2 ? "MALFORMED" : "";
+            return Make("demo", size, error_at, tail);
+        }
+
+    private:
+        const std::string& Make(const char* kind, std::size_t size, std::int64_t error_at, std::string_view tail)
+        {
+            const auto key = std::string(kind) + "_" + std::to_string(size) + "_" + std::to_string(error_at);
+            auto it = files_.find(key);
+            if (it != files_.end())
+                return it->second;
+
+            const auto path = (dir_ / (key + ".cfg")).string();
+            std::ofstream ofs(path, std::ios::binary);
+            const std::size_t body = size > tail.size() ? size - tail.size() : 0;
+            const std::string line(63, 'a');
+            for (std::size_t written = 0; written < body; written += 64)
+            {
+                const std::size_t n = std::min<std::size_t>(64, body - written);
+                ofs.write(line.data(), static_cast<std::streamsize>(n - 1));
+                ofs.put('\n');
+            }
+            ofs.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+            return files_.emplace(key, path).first->second;
+        }
+
+        fs::path                           dir_;
+        NullSink                           null_sink_;
+        std::map<std::string, std::string> files_;
+    };
+
+    Fixtures& Files()
+    {
+        static Fixtures instance;
+        return instance;
+    }
+
+    // 例外基準：與 config 管線相同的工作（單次哨兵掃描、kv::Parse、逐欄位驗證），
+    // 只把回傳 std::unexpected 的地方換成 throw
+    struct ReadFailure  { std::string filename; };
+    struct ParseFailure { std::string line_content; int line_number; };
+    struct ValidateFailure { std::string field_name; std::string invalid_value; };
+    struct ProcessFailure  { std::string task_name; std::string details; };
+
+    config::Config LoadConfigOrThrow(const std::string& filename)
+    {
+        std::ifstream file(filename);
+        if (!file.is_open())
+            throw ReadFailure{filename};
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string content = buffer.str();
+        scanner::ScanResult scan = config::SentinelScanner().Scan(content);
+        if (content.empty() || scan.Contains(config::kMalformed))
+        {
+            const auto where = scan.Locate(content, scan.First(config::kMalformed).value_or(0));
+            throw ParseFailure{std::string(where.line_content), where.line_number};
+        }
+        auto fields = kv::Parse(content);
+        if (!fields)
+        {
+            const auto where = scan.Locate(content, fields.error().offset);
+            throw ParseFailure{std::string(where.line_content), where.line_number};
+        }
+        return config::Config{std::move(content), std::move(scan), std::move(*fields)};
+    }
+
+    // 與 ValidateData 相同：有 "invalid_field" 哨兵時才逐欄位檢查，回報最早出現的違規欄位
+    std::string ValidateDataOrThrow(config::Config&& cfg)
+    {
+        if (cfg.scan.Contains(config::kInvalidField))
+        {
+            const kv::Field* bad = nullptr;
+            kv::Field        candidate;
+            for (std::size_t i = 0; i < cfg.fields.size(); ++i)
+            {
+                const kv::Field field = cfg.fields[i];
+                const bool disallowed = field.key == "invalid_field" || field.value.find("invalid_field") != std::string_view::npos;
+                if (disallowed && (bad == nullptr || field.line < bad->line))
+                {
+                    candidate = field;
+                    bad       = &candidate;
+                }
+            }
+            if (bad != nullptr)
+                throw ValidateFailure{std::string(bad->key), std::string(bad->value.empty() ? std::string_view{"disallowed field"} : bad->value)};
+        }
+        return std::move(cfg.data);
+    }
+
+    int ProcessDataOrThrow(std::size_t logical_size)
+    {
+        if (logical_size < 10)
+            throw ProcessFailure{"Data Processing", "Input data too short for task"};
+        return static_cast<int>(logical_size);
+    }
+
+    // 將 state 以位元組數回報，方便比較吞吐量
+    void SetBytes(benchmark::State& state)
+    {
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+    }
+}
+
+// 各階段單獨量測 ----------------------------------------------------------------
+
+static void BM_LoadConfig(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(config::LoadConfig(path));
+    SetBytes(state);
+}
+
+static void BM_ValidateData(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    auto cfg = config::LoadConfig(path);
+    // 只有 stage 2 的輸入會在此失敗；stage 1 的輸入在 LoadConfig 就失敗
+    if (!cfg)
+    {
+        state.SkipWithError("input fails before ValidateData");
+        return;
+    }
+    for (auto _ : state)
+        benchmark::DoNotOptimize(config::ValidateData(*cfg));
+    SetBytes(state);
+}
+
+static void BM_ProcessData(benchmark::State& state)
+{
+    // stage 3：經由正常管線不可能小於 10（前綴 "Validated: " 已有 11 個字），故直接建立過短的資料
+    const auto size = state.range(1) == kStage3 ? std::size_t{1} : static_cast<std::size_t>(state.range(0));
+    const config::ValidatedData data{std::string(size, 'a'), state.range(1) == kStage3 ? std::string_view{} : config::kValidatedTag};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(config::ProcessData(data));
+    SetBytes(state);
+}
+
+// 完整 and_then 管線 ------------------------------------------------------------
+
+static void BM_Pipeline(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    for (auto _ : state)
+    {
+        auto r = config::LoadConfig(path)
+               .and_then([](config::Config&& cfg) { return config::ValidateData(std::move(cfg)); })
+               .and_then([](config::ValidatedData&& vd) { return config::ProcessData(std::move(vd)); });
+        benchmark::DoNotOptimize(r);
+    }
+    SetBytes(state);
+}
+
+// 編譯期組合的管線：同樣的輸入，與 and_then 串接比較
+static void BM_PipelineComposed(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    constexpr config::ConfigPipeline pipeline{};
+    for (auto _ : state)
+    {
+        auto r = pipeline(path);
+        benchmark::DoNotOptimize(r);
+    }
+    SetBytes(state);
+}
+
+// 收集模式：同樣的輸入，一次執行回報所有錯誤
+static void BM_PipelineCollectAll(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    constexpr config::CollectingConfigPipeline pipeline{};
+    for (auto _ : state)
+    {
+        auto r = pipeline(path);
+        benchmark::DoNotOptimize(r);
+    }
+    SetBytes(state);
+}
+
+// 緩衝區重用：同樣三個階段，內容字串、掃描結果與欄位表都從物件池取用
+static void BM_PipelinePooled(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    constexpr config::PooledConfigPipeline pipeline{};
+    for (auto _ : state)
+    {
+        auto r = pipeline(path);
+        benchmark::DoNotOptimize(r);
+    }
+    SetBytes(state);
+}
+
+// 配置政策：0 = 預設、1 = THP、2 = MAP_HUGETLB（沒有預留大頁時退回 THP）、3 = THP + 第一次寫入、4 = THP + 綁定節點
+static memory::Policy BenchPolicy(std::int64_t index)
+{
+    using memory::HugePages;
+    using memory::Placement;
+    const memory::Policy policies[] = {
+        {},
+        {HugePages::kTransparent},
+        {HugePages::kExplicit},
+        {HugePages::kTransparent, Placement::kFirstTouch},
+        {HugePages::kTransparent, Placement::kBind},
+    };
+    return policies[index];
+}
+
+// 大型設定：讀檔緩衝區依配置政策配置後跑完整管線（掃描、解析與驗證都走過整個緩衝區）
+static void BM_PipelineMemoryPolicy(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), kSuccess);
+    const auto policy = BenchPolicy(state.range(1));
+    for (auto _ : state)
+    {
+        auto r = config::LoadConfig(path, policy)
+               .and_then([](config::Config&& cfg) { return config::ValidateData(std::move(cfg)); })
+               .and_then([](config::ValidatedData&& vd) { return config::ProcessData(std::move(vd)); });
+        benchmark::DoNotOptimize(r);
+    }
+    SetBytes(state);
+}
+
+// 同上，mmap 模式：1 為檔案映射加 THP 建議，其餘政策改為讀進匿名映射
+static void BM_MappedMemoryPolicy(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), kSuccess);
+    const auto policy = BenchPolicy(state.range(1));
+    for (auto _ : state)
+    {
+        auto r = config::LoadConfigMapped(path, policy)
+               .and_then([](const config::MappedConfig& cfg) { return config::ValidateData(cfg); });
+        benchmark::DoNotOptimize(r);
+    }
+    SetBytes(state);
+}
+
+// demo 讀檔：ReadAll 依配置政策配置後掃描哨兵
+static void BM_DemoReadAllMemoryPolicy(benchmark::State& state)
+{
+    const auto& path = Files().DemoFile(static_cast<std::size_t>(state.range(0)), kSuccess);
+    const auto policy = BenchPolicy(state.range(1));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(demo::ReadAll(path, policy));
+    SetBytes(state);
+}
+
+// 啟動：文字路徑（讀檔、解析、驗證）與預先編譯的快照（映射、檢查雜湊、複製內容）比較
+static void BM_StartupText(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    for (auto _ : state)
+    {
+        auto r = config::LoadConfig(path).and_then([](config::Config&& cfg) { return config::ValidateData(std::move(cfg)); });
+        benchmark::DoNotOptimize(r);
+    }
+    SetBytes(state);
+}
+
+static void BM_StartupImage(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    if (!binary::CompileImage(path))
+    {
+        state.SkipWithError("cannot compile config image");
+        return;
+    }
+    for (auto _ : state)
+    {
+        auto r = binary::LoadValidated(path);
+        benchmark::DoNotOptimize(r);
+    }
+    SetBytes(state);
+}
+
+// 欄位查詢：已排序的位移表（單一字串池）與 std::map<std::string, std::string> 比較
+static std::string FieldsText(std::size_t count)
+{
+    std::string text;
+    for (std::size_t i = 0; i < count; ++i)
+        text += "key_" + std::to_string(i * 7919 % count) + " = value_" + std::to_string(i) + "\n";
+    return text;
+}
+
+static void BM_FieldLookupTable(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto table = kv::Parse(FieldsText(count)).value();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto key = "key_" + std::to_string(i++ % count);
+        benchmark::DoNotOptimize(table.Find(key));
+    }
+}
+
+static void BM_FieldLookupMap(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto table = kv::Parse(FieldsText(count)).value();
+    std::map<std::string, std::string> map;
+    for (std::size_t k = 0; k < table.size(); ++k)
+        map.emplace(std::string(table[k].key), std::string(table[k].value));
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto key = "key_" + std::to_string(i++ % count);
+        benchmark::DoNotOptimize(map.find(key));
+    }
+}
+
+// 例外基準：同樣的輸入、同樣的失敗位置
+static void BM_PipelineExceptions(benchmark::State& state)
+{
+    const auto& path = Files().ConfigFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    for (auto _ : state)
+    {
+        try
+        {
+            auto data = ValidateDataOrThrow(LoadConfigOrThrow(path));
+            benchmark::DoNotOptimize(ProcessDataOrThrow(config::kValidatedTag.size() + data.size()));
+        }
+        catch (const ReadFailure& e)     { benchmark::DoNotOptimize(e.filename.data()); }
+        catch (const ParseFailure& e)    { benchmark::DoNotOptimize(e.line_number); }
+        catch (const ValidateFailure& e) { benchmark::DoNotOptimize(e.field_name.data()); }
+        catch (const ProcessFailure& e)  { benchmark::DoNotOptimize(e.task_name.data()); }
+    }
+    SetBytes(state);
+}
+
+// demo 管線：超過 1024 位元組的輸入一律在 ParseConfig 以 MemoryError 失敗
+static void BM_DemoLoadAndParse(benchmark::State& state)
+{
+    const auto& path = Files().DemoFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(demo::LoadAndParse(path));
+    SetBytes(state);
+}
+
+// 同上，經由內容快取：未變更的檔案每次只做一次 stat
+static void BM_DemoLoadAndParseCached(benchmark::State& state)
+{
+    const auto& path = Files().DemoFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+    filecache::FileCache cache(demo::Sentinels());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(demo::LoadAndParse(cache, path));
+    SetBytes(state);
+}
+
+// 位元組轉換核心（demo 解析的 c - 1）：純記憶體運算，不含 I/O；isa 為 bytes::Isa 的數值
+static void BM_ByteTransform(benchmark::State& state)
+{
+    const auto isa = static_cast<bytes::Isa>(state.range(1));
+    if (!bytes::Supported(isa))
+    {
+        state.SkipWithError("ISA not supported on this CPU");
+        return;
+    }
+    state.SetLabel(std::string(bytes::ToString(isa)));
+    std::string buffer(static_cast<std::size_t>(state.range(0)), 'b');
+    for (auto _ : state)
+    {
+        bytes::OffsetNonZero(isa, buffer, -1);
+        benchmark::ClobberMemory();
+    }
+    SetBytes(state);
+}
+
+// 規則引擎：256 個欄位、N 條規則（長度上限、禁止子字串，每 8 條一條正規表示式），全部通過
+static rules::RuleSet BenchRules(std::size_t count, std::size_t first, std::size_t last)
+{
+    rules::RuleSet set;
+    for (std::size_t i = first; i < last; ++i)
+    {
+        std::string key = "key_" + std::to_string(i % count);
+        if (i % 8 == 0)
+            set.Matches(std::move(key), "value_[0-9]+");
+        else if (i % 2 == 0)
+            set.MaxLength(std::move(key), 32);
+        else
+            set.Forbid(std::move(key), "invalid_field");
+    }
+    return set;
+}
+
+static constexpr std::size_t kRuleBenchFields = 256;
+
+// 一個 Program、單次走訪
+static void BM_RuleEngine(benchmark::State& state)
+{
+    const auto rule_count = static_cast<std::size_t>(state.range(0));
+    const auto table = kv::Parse(FieldsText(kRuleBenchFields)).value();
+    const auto program = BenchRules(kRuleBenchFields, 0, rule_count).Compile().value();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(program.Evaluate(table));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * rule_count));
+}
+
+// 同樣的規則，每條規則各自一個 Program、各走訪一次欄位表
+static void BM_RulePerPass(benchmark::State& state)
+{
+    const auto rule_count = static_cast<std::size_t>(state.range(0));
+    const auto table = kv::Parse(FieldsText(kRuleBenchFields)).value();
+    std::vector<rules::Program> programs;
+    for (std::size_t i = 0; i < rule_count; ++i)
+        programs.push_back(BenchRules(kRuleBenchFields, i, i + 1).Compile().value());
+    for (auto _ : state)
+        for (const auto& program : programs)
+            benchmark::DoNotOptimize(program.Evaluate(table));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * rule_count));
+}
+
+// 基準：N 次獨立的 ValidateData（每次只檢查單一規則）
+static void BM_ValidateDataPasses(benchmark::State& state)
+{
+    const auto rule_count = static_cast<std::size_t>(state.range(0));
+    // 只為了換上不輸出的日誌後端
+    Files();
+    const auto config = config::LoadConfigFromBuffer("rules.cfg", FieldsText(kRuleBenchFields)).value();
+    for (auto _ : state)
+        for (std::size_t i = 0; i < rule_count; ++i)
+            benchmark::DoNotOptimize(config::ValidateData(config));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * rule_count));
+}
+
+// 錯誤風暴：每次失敗都格式化一行訊息（HandlePipelineResult 的作法，只差沒有寫進 std::cerr）
+static void BM_ReportEachError(benchmark::State& state)
+{
+    const config::PipelineError error = config::ValidationError{"invalid_field", "disallowed field"};
+    std::string line;
+    for (auto _ : state)
+    {
+        line.clear();
+        config::FormatTo(std::back_inserter(line), error);
+        line += '\n';
+        benchmark::DoNotOptimize(line.data());
+    }
+}
+
+// 同上，改由 ErrorReporter 去重計數：每次失敗只有雜湊 + 一次原子加法
+static void BM_ReportSampled(benchmark::State& state)
+{
+    static report::ErrorReporter reporter;
+    const config::PipelineError error = config::ValidationError{"invalid_field", "disallowed field"};
+    for (auto _ : state)
+        reporter.Report(error);
+    if (state.thread_index() == 0)
+        benchmark::DoNotOptimize(reporter.TakeSummary());
+}
+
+// 參數：資料量 1 KB ~ 1 GB（每次 ×16），錯誤位置依各函式可能的失敗階段
+static void SizesWithErrors(benchmark::internal::Benchmark* b, std::initializer_list<std::int64_t> errors)
+{
+    b->ArgNames({"bytes", "error_at"});
+    for (std::int64_t size = 1 << 10; size <= (std::int64_t{1} << 30); size *= 16)
+        for (auto e : errors)
+            b->Args({size, e});
+}
+
+BENCHMARK(BM_LoadConfig)        ->Apply([](auto* b) { SizesWithErrors(b, {kSuccess, kStage1}); });
+BENCHMARK(BM_ValidateData)      ->Apply([](auto* b) { SizesWithErrors(b, {kSuccess, kStage2}); });
+BENCHMARK(BM_ProcessData)       ->Apply([](auto* b) { SizesWithErrors(b, {kSuccess, kStage3}); });
+BENCHMARK(BM_Pipeline)          ->Apply([](auto* b) { SizesWithErrors(b, {kSuccess, kStage1, kStage2}); });
+BENCHMARK(BM_PipelineComposed)  ->Apply([](auto* b) { SizesWithErrors(b, {kSuccess, kStage1, kStage2}); });
+BENCHMARK(BM_PipelineCollectAll)->Apply([](auto* b) { SizesWithErrors(b, {kSuccess, kStage1, kStage2}); });
+BENCHMARK(BM_PipelinePooled)    ->Apply([](auto* b) { SizesWithErrors(b, {kSuccess, kStage1, kStage2}); });
+// 配置政策只對大型內容有意義：4 MB ~ 256 MB
+BENCHMARK(BM_PipelineMemoryPolicy)   ->ArgNames({"bytes", "policy"})
+                                     ->ArgsProduct({benchmark::CreateRange(1 << 22, 1 << 28, 16), benchmark::CreateDenseRange(0, 4, 1)});
+BENCHMARK(BM_MappedMemoryPolicy)     ->ArgNames({"bytes", "policy"})
+                                     ->ArgsProduct({benchmark::CreateRange(1 << 22, 1 << 28, 16), benchmark::CreateDenseRange(0, 4, 1)});
+BENCHMARK(BM_DemoReadAllMemoryPolicy)->ArgNames({"bytes", "policy"})
+                                     ->ArgsProduct({benchmark::CreateRange(1 << 22, 1 << 28, 16), benchmark::CreateDenseRange(0, 4, 1)});
+BENCHMARK(BM_StartupText)       ->Apply([](auto* b) { SizesWithErrors(b, {kSuccess}); });
+BENCHMARK(BM_StartupImage)      ->Apply([](auto* b) { SizesWithErrors(b, {kSuccess}); });
+BENCHMARK(BM_PipelineExceptions)->Apply([](auto* b) { SizesWithErrors(b, {kSuccess, kStage1, kStage2}); });
+BENCHMARK(BM_DemoLoadAndParse)  ->Apply([](auto* b) { SizesWithErrors(b, {kSuccess, kStage1, kStage2}); });
+BENCHMARK(BM_DemoLoadAndParseCached)->Apply([](auto* b) { SizesWithErrors(b, {kSuccess, kStage1, kStage2}); });
+BENCHMARK(BM_FieldLookupTable)  ->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(BM_FieldLookupMap)    ->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(BM_RuleEngine)        ->RangeMultiplier(4)->Range(8, 512);
+BENCHMARK(BM_RulePerPass)       ->RangeMultiplier(4)->Range(8, 512);
+BENCHMARK(BM_ValidateDataPasses)->RangeMultiplier(4)->Range(8, 512);
+BENCHMARK(BM_ReportEachError)   ->ThreadRange(1, 4);
+BENCHMARK(BM_ReportSampled)     ->ThreadRange(1, 4);
+BENCHMARK(BM_ByteTransform)     ->ArgNames({"bytes", "isa"})
+                                ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 26, 16),
+                                               benchmark::CreateDenseRange(0, 4, 1)});
+
+BENCHMARK_MAIN();
+
+// 編譯: g++ -std=gnu++23 -O2 -DNDEBUG Benchmark.cpp Config.cpp KeyValue.cpp Scanner.cpp ByteTransform.cpp FileCache.cpp ErrorReport.cpp RuleEngine.cpp BinaryConfig.cpp MemoryPolicy.cpp Log.cpp -I. -lbenchmark -pthread -o bench
+// 執行: ./bench                                  （完整 1 KB ~ 1 GB，需要數 GB 的暫存空間）
+//       ./bench --benchmark_filter='/bytes:(1024|16384|262144)/'   （只跑小資料量）
@@ -0,0 +1,147 @@
+// Include Guard：避免重複包含
+#ifndef BINARY_CONFIG_H
+// 與上方成對
+#define BINARY_CONFIG_H
+
+// Config / ValidatedData / PipelineError / MappedFile
+#include "Config.h"
+// ProcessStage（ImagePipeline）
+#include "Pipeline.h"
+// std::size_t
+#include <cstddef>
+// 固定寬度整數（檔頭欄位）
+#include <cstdint>
+// std::expected
+#include <expected>
+// std::optional（查詢結果）
+#include <optional>
+// 路徑
+#include <string>
+// 檢視
+#include <string_view>
+// std::is_same_v
+#include <type_traits>
+
+/*
+預先編譯的二進位設定快照：啟動時不再解析文字、不再驗證
+- CompileImage(source)：LoadConfig → ValidateData 通過後，把欄位表寫成 ImagePathFor(source)（原檔名 + ".cfgbin"）
+- 檔案格式（本機位元組序，魔數不符即拒絕）：
+  64 位元組檔頭 | 欄位表（每列 5 個 uint32：鍵與值在字串池中的位移、長度、行號，依鍵排序） | 字串池 | 驗證後的內容
+- 檔頭記錄格式版本、來源檔的大小與修改時間（讀檔之前取得、讀完後確認未變更；判斷是否過期）、各段長度與整段酬載的 64 位元雜湊
+- LoadImage(path, source)：mmap 後只檢查檔頭、來源檔的 stat 與雜湊；欄位表與字串池直接在映射上使用，不複製、不解析
+- 過期或損毀時回傳 ImageError（專屬的錯誤成員，說明原因），LoadValidated 據此退回文字路徑
+- 寫入先寫到暫存檔再 rename，讀取端不會看到寫到一半的快照
+*/
+
+// 開始命名空間
+namespace binary
+{
+	// 檔案格式版本：格式改變時遞增，舊版快照一律視為過期
+	inline constexpr std::uint32_t    kImageVersion = 1;
+	// 快照檔名：來源檔名 + 此後綴
+	inline constexpr std::string_view kImageSuffix  = ".cfgbin";
+
+	// 快照無法使用的原因
+	enum class Fault : std::uint8_t
+	{
+		// 無法開啟或映射
+		kOpen,
+		// 不是快照檔（魔數不符，或位元組序不同）
+		kBadMagic,
+		// 格式版本不同
+		kVersion,
+		// 檔案長度與檔頭不符
+		kTruncated,
+		// 雜湊不符
+		kChecksum,
+		// 欄位表指向字串池之外
+		kCorrupt,
+		// 來源檔已變更（或不存在）
+		kStale,
+		// 寫入失敗
+		kWrite,
+	};
+
+	// 原因的名稱（靜態字面值）
+	[[nodiscard]] std::string_view ToString(Fault fault) noexcept;
+
+	// 快照錯誤
+	struct ImageError
+	{
+		// 快照檔路徑
+		std::string path;
+		// 原因
+		Fault       fault = Fault::kOpen;
+	};
+
+	// 編譯快照可能產生的錯誤：讀檔、解析、驗證，以及寫入快照失敗
+	using CompileErrors = meta::Union<config::LoadErrors, config::ValidateErrors, meta::TypeList<ImageError>>;
+	using CompileError  = meta::AsVariant<CompileErrors>;
+
+	// 已映射的快照：欄位表與字串池直接指向映射記憶體（只能移動）
+	class ConfigImage
+	{
+	public:
+		ConfigImage() noexcept = default;
+
+		// 欄位數
+		[[nodiscard]] std::size_t size() const noexcept { return count_; }
+		[[nodiscard]] bool empty() const noexcept { return count_ == 0; }
+		// 依鍵排序的第 i 個欄位（source_offset / source_size 不保存，為 0）
+		[[nodiscard]] kv::Field operator[](std::size_t i) const noexcept;
+		// 二分搜尋：找到時回傳值
+		[[nodiscard]] std::optional<std::string_view> Find(std::string_view key) const noexcept;
+		// 驗證後的內容
+		[[nodiscard]] std::string_view data() const noexcept { return data_; }
+
+		// 交給 ProcessData 的資料（複製一次內容）
+		[[nodiscard]] config::ValidatedData ToValidated() const;
+
+	private:
+		friend std::expected<ConfigImage, ImageError> LoadImage(const std::string& path, const std::string& source);
+
+		config::MappedFile mapping_;
+		// 欄位表的起點（未必對齊：以 memcpy 讀取）
+		const char*        entries_ = nullptr;
+		std::size_t        count_   = 0;
+		std::string_view   pool_;
+		std::string_view   data_;
+	};
+
+	// 來源檔對應的快照路徑
+	[[nodiscard]] std::string ImagePathFor(const std::string& source);
+
+	// 把已通過驗證的 config 寫成快照；source 為它的來源檔（記錄呼叫當下的大小與修改時間，config 必須是 source 目前的內容）
+	[[nodiscard]] std::expected<void, ImageError> WriteImage(const std::string& path, const config::Config& config, const std::string& source);
+	// 讀取並驗證 source，通過後寫到 ImagePathFor(source)；讀檔期間 source 被改寫時重新讀取，持續變更時回傳 kStale
+	[[nodiscard]] std::expected<void, CompileError> CompileImage(const std::string& source);
+	// 映射快照並檢查檔頭、過期與雜湊
+	[[nodiscard]] std::expected<ConfigImage, ImageError> LoadImage(const std::string& path, const std::string& source);
+
+	// 讀檔＋驗證可能產生的錯誤（快照不可用時退回文字路徑，錯誤與它相同）
+	using ValidatedErrors = meta::Union<config::LoadErrors, config::ValidateErrors>;
+	using ValidatedError  = meta::AsVariant<ValidatedErrors>;
+
+	// 先試 ImagePathFor(source)；快照不可用時退回 LoadConfig → ValidateData（原因寫入 fallback，可為 nullptr）
+	[[nodiscard]] std::expected<config::ValidatedData, config::PipelineError> LoadValidated(const std::string& source, ImageError* fallback = nullptr);
+	// 同上，錯誤只含讀檔與驗證的成員
+	[[nodiscard]] std::expected<config::ValidatedData, ValidatedError> LoadValidated(const std::string& source, config::Exact, ImageError* fallback = nullptr);
+
+	// 讀檔＋驗證階段（取代 LoadStage、ValidateStage）：快照優先，錯誤與文字路徑相同
+	struct ImageStage
+	{
+		using Errors = ValidatedErrors;
+
+		[[nodiscard]] config::StageResult<Errors, config::ValidatedData> operator()(const std::string& source) const
+		{
+			return LoadValidated(source, config::Exact{});
+		}
+	};
+
+	// 快照優先的完整管線
+	using ImagePipeline = config::Pipeline<ImageStage, config::ProcessStage>;
+	static_assert(std::is_same_v<ImagePipeline::Error, config::PipelineError>);
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,139 @@
+// Include Guard：避免重複包含
+#ifndef BUFFER_POOL_H
+// 與上方成對
+#define BUFFER_POOL_H
+
+// std::size_t
+#include <cstddef>
+// 共用倉庫的互斥
+#include <mutex>
+// std::move
+#include <utility>
+// 快取與倉庫
+#include <vector>
+
+/*
+物件池：重複使用 std::string、Config 等物件，保留它們已配置的容量
+- Pool<T>::Acquire() 取得一個物件（內容為空、容量沿用上一次使用），Release(value) 歸還
+- 每個執行緒各有一個最多 kLocalCapacity 個物件的快取，取用與歸還都不加鎖；
+  快取滿了才把一半移到共用倉庫、快取空了才向倉庫拿（此時才鎖一次 mutex）
+- 倉庫最多 kDepotCapacity 個物件，超過的直接釋放：記憶體用量有上限
+- 執行緒結束時它的快取整批歸還倉庫
+- 穩定狀態下（重複讀取大小相近的設定），每次取用都拿到容量足夠的物件，不再配置
+- T 有 clear() 時歸還時自動呼叫；沒有的（例如 Config）由呼叫端先清空
+- local_stats()：本執行緒取用時命中（取自快取或倉庫）與落空（新建）的次數，不加鎖、不用原子操作
+*/
+
+// 開始命名空間
+namespace pool
+{
+	// 每個執行緒快取的物件數
+	inline constexpr std::size_t kLocalCapacity = 4;
+	// 共用倉庫的物件數上限
+	inline constexpr std::size_t kDepotCapacity = 64;
+
+	// 一個執行緒的取用統計
+	struct Stats
+	{
+		// 取得池中既有的物件
+		std::size_t hits   = 0;
+		// 池中沒有物件，新建一個
+		std::size_t misses = 0;
+	};
+
+	// 每種型別一個池（靜態成員）
+	template<typename T>
+	class Pool
+	{
+	public:
+		// 取得一個物件：本執行緒快取 → 共用倉庫 → 新建
+		[[nodiscard]] static T Acquire()
+		{
+			Local& local = LocalCache();
+			if (local.items.empty())
+				Refill(local);
+			if (local.items.empty())
+			{
+				++local.stats.misses;
+				return T{};
+			}
+			++local.stats.hits;
+			T value = std::move(local.items.back());
+			local.items.pop_back();
+			return value;
+		}
+
+		// 歸還物件（清空內容、保留容量）
+		static void Release(T&& value)
+		{
+			if constexpr (requires { value.clear(); })
+				value.clear();
+			Local& local = LocalCache();
+			if (local.items.size() == kLocalCapacity)
+				Spill(local, kLocalCapacity / 2);
+			local.items.push_back(std::move(value));
+		}
+
+		// 目前本執行緒快取的物件數（測試、診斷用）
+		[[nodiscard]] static std::size_t local_size() noexcept { return LocalCache().items.size(); }
+		// 本執行緒到目前為止的取用統計（測試、診斷用）
+		[[nodiscard]] static Stats local_stats() noexcept { return LocalCache().stats; }
+
+	private:
+		// 本執行緒的快取；執行緒結束時全部歸還倉庫
+		struct Local
+		{
+			std::vector<T> items;
+			Stats          stats;
+
+			Local() { items.reserve(kLocalCapacity); }
+			~Local() { Spill(*this, items.size()); }
+		};
+
+		// 共用倉庫
+		struct Depot
+		{
+			std::mutex     mutex;
+			std::vector<T> items;
+		};
+
+		[[nodiscard]] static Local& LocalCache()
+		{
+			thread_local Local local;
+			return local;
+		}
+		[[nodiscard]] static Depot& SharedDepot()
+		{
+			static Depot depot;
+			return depot;
+		}
+
+		// 從倉庫拿最多半個快取的量
+		static void Refill(Local& local)
+		{
+			Depot& depot = SharedDepot();
+			const std::lock_guard lock(depot.mutex);
+			while (!depot.items.empty() && local.items.size() < kLocalCapacity / 2)
+			{
+				local.items.push_back(std::move(depot.items.back()));
+				depot.items.pop_back();
+			}
+		}
+
+		// 把快取尾端的 count 個物件移到倉庫；倉庫滿時直接釋放
+		static void Spill(Local& local, std::size_t count)
+		{
+			Depot& depot = SharedDepot();
+			const std::lock_guard lock(depot.mutex);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (depot.items.size() < kDepotCapacity)
+					depot.items.push_back(std::move(local.items.back()));
+				local.items.pop_back();
+			}
+		}
+	};
+// 結束命名空間
+}
+
+#endif
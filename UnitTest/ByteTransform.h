@@ -0,0 +1,55 @@
+// Include Guard：避免重複包含
+#ifndef BYTE_TRANSFORM_H
+// 與上方成對
+#define BYTE_TRANSFORM_H
+
+// std::size_t
+#include <cstddef>
+// std::int8_t：位移量
+#include <cstdint>
+// std::span：呼叫端擁有的緩衝
+#include <span>
+// std::string_view：唯讀輸入
+#include <string_view>
+
+/*
+位元組轉換核心（SIMD + 執行期分派）
+- 目前提供「非零位元組加上固定位移」：c == 0 ? 0 : c + delta（demo::ParseConfig 的 c - 1 即 delta = -1）
+- 依 CPU 於第一次呼叫時選定一次實作：AVX-512BW → AVX2 → SSE2（x86-64）、NEON（AArch64）、純量
+- 每種實作一次處理 64 / 32 / 16 個位元組且不含分支，大緩衝下受限於記憶體頻寬而非指令
+- 有就地版本（改寫呼叫端的緩衝）與複製版本（in → out，可為同一塊記憶體）
+*/
+
+// 開始命名空間
+namespace bytes
+{
+	// 可用的實作
+	enum class Isa
+	{
+		kScalar,
+		kSse2,
+		kAvx2,
+		kAvx512,
+		kNeon,
+	};
+
+	// 執行期選定的實作（第一次呼叫時偵測，之後固定）
+	[[nodiscard]] Isa ActiveIsa() noexcept;
+	// 此 CPU 與編譯目標是否支援指定實作
+	[[nodiscard]] bool Supported(Isa isa) noexcept;
+	// 實作名稱（供 benchmark / 日誌顯示）
+	[[nodiscard]] std::string_view ToString(Isa isa) noexcept;
+
+	// 就地：buffer 中每個非零位元組加上 delta（以 8 位元環繞）
+	void OffsetNonZero(std::span<char> buffer, std::int8_t delta) noexcept;
+	// 複製：out[i] = in[i] == 0 ? 0 : in[i] + delta；out 至少要有 in.size() 個位元組，可與 in 重疊於同一起點
+	void OffsetNonZero(std::string_view in, std::span<char> out, std::int8_t delta) noexcept;
+	// 指定實作（測試與 benchmark 用）；不支援時退回純量
+	void OffsetNonZero(Isa isa, std::span<char> buffer, std::int8_t delta) noexcept;
+
+	// 就地：非零位元組減一（demo 解析的轉換）
+	inline void DecrementNonZero(std::span<char> buffer) noexcept { OffsetNonZero(buffer, -1); }
+// 結束命名空間
+}
+
+#endif
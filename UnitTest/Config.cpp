@@ -1,86 +1,1131 @@
 // 引入對應的宣告標頭
 #include "Config.h"
+// arena 版本的錯誤型別與階段宣告
+#include "ArenaError.h"
+// 精簡錯誤碼版本的階段宣告
+#include "ErrorCode.h"
+// 物件池（緩衝區重用模式）
+#include "BufferPool.h"
+// 引入 errno / EINTR（read 被信號中斷時重試）
+#include <cerrno>
 // 引入檔案 I/O
 #include <fstream>
-// 引入標準輸出入（除錯訊息）
-#include <iostream>
+// 引入 std::sort（收集模式依行號排列違規欄位）
+#include <algorithm>
+// 引入 std::less_equal（比較描述子原文範圍內的指標）
+#include <functional>
+// 引入可在編譯期移除的除錯日誌
+#include "Log.h"
 // 引入字串串流（整檔讀入）
 #include <sstream>
+// 引入 std::exchange（移動語意轉移所有權）
+#include <utility>
+// POSIX：open / close
+#include <fcntl.h>
+// POSIX：mmap / munmap / madvise
+#include <sys/mman.h>
+// POSIX：fstat 取得檔案大小
+#include <sys/stat.h>
+// POSIX：close
+#include <unistd.h>
 
 // 進入命名空間
 namespace config 
 {
+	// 僅供本檔使用的檢查工具：讓 std::string 與 mmap 兩種讀檔模式共用同一套規則
+	namespace 
+	{
+		// 讀取哨兵命中結果；手動建立、尚未掃描的資料才補掃一次
+		[[nodiscard]] bool HasSentinel(const scanner::ScanResult& scan, std::string_view content, Sentinel id) 
+		{
+			if (scan.scanned) 
+				return scan.Contains(id);
+			return SentinelScanner().Scan(content).Contains(id);
+		}
+
+		// 示範條件：空檔或包含關鍵字 "malformed" 視為解析錯誤
+		[[nodiscard]] bool IsMalformed(std::string_view content, const scanner::ScanResult& scan) 
+		{
+			return content.empty() || HasSentinel(scan, content, kMalformed);
+		}
+
+		// 快速排除：全文都沒有 "invalid_field" 時不需逐欄位檢查
+		[[nodiscard]] bool HasInvalidField(std::string_view content, const scanner::ScanResult& scan) 
+		{
+			return HasSentinel(scan, content, kInvalidField);
+		}
+
+		// 欄位規則：鍵為 "invalid_field"，或值中含有 "invalid_field"，視為驗證失敗
+		[[nodiscard]] bool IsDisallowed(const kv::Field& field) 
+		{
+			constexpr std::string_view kDisallowed = "invalid_field";
+			return field.key == kDisallowed || field.value.find(kDisallowed) != std::string_view::npos;
+		}
+
+		// 驗證錯誤的值：出錯欄位的值；旗標欄位沒有值，改為說明
+		[[nodiscard]] std::string_view InvalidValueOf(const kv::Field& field) 
+		{
+			return field.value.empty() ? std::string_view{"disallowed field"} : field.value;
+		}
+
+		// 錯誤工廠：各階段只描述「發生什麼錯」，由工廠決定錯誤的表示方式
+		// （一般 std::string 版本、arena 版本等共用同一份階段邏輯）
+		// E 為 PipelineError 或某個階段自身的錯誤型別；產生 E 沒有的成員時編譯失敗，不需要執行期收窄
+		template<typename E>
+		struct TypedErrors 
+		{
+			// 此工廠產生的錯誤型別
+			using Error = E;
+
+			[[nodiscard]] Error Read(const std::string& filename) const 
+			{
+				return ConfigReadError{filename};
+			}
+			[[nodiscard]] Error Parse(std::string_view line_content, int line_number, std::size_t offset) const 
+			{
+				return ConfigParseError{std::string(line_content), line_number, offset};
+			}
+			[[nodiscard]] Error Validation(std::string_view field_name, std::string_view invalid_value, std::size_t offset) const 
+			{
+				return ValidationError{std::string(field_name), std::string(invalid_value), offset};
+			}
+			[[nodiscard]] Error InvalidField(const kv::Field& field) const 
+			{
+				return Validation(field.key, InvalidValueOf(field), field.source_offset);
+			}
+			[[nodiscard]] Error Processing(std::string_view task_name, std::string_view details) const 
+			{
+				return ProcessingError{std::string(task_name), std::string(details)};
+			}
+		};
+		using OwnedErrors = TypedErrors<PipelineError>;
+
+		// arena 錯誤工廠：動態字串配置自 arena，靜態字面值只存 string_view
+		struct ArenaErrors 
+		{
+			// 此工廠產生的錯誤型別
+			using Error = arena::PipelineError;
+			// 錯誤字串的記憶體來源
+			std::pmr::memory_resource* resource;
+
+			[[nodiscard]] Error Read(const std::string& filename) const 
+			{
+				return arena::ConfigReadError{std::pmr::string(filename, resource)};
+			}
+			// arena 版本的錯誤不記位移
+			[[nodiscard]] Error Parse(std::string_view line_content, int line_number, std::size_t) const 
+			{
+				return arena::ConfigParseError{std::pmr::string(line_content, resource), line_number};
+			}
+			[[nodiscard]] Error Validation(std::string_view field_name, std::string_view invalid_value, std::size_t) const 
+			{
+				return arena::ValidationError{std::pmr::string(field_name, resource),
+				                              std::pmr::string(invalid_value, resource)};
+			}
+			[[nodiscard]] Error InvalidField(const kv::Field& field) const 
+			{
+				return Validation(field.key, InvalidValueOf(field), field.source_offset);
+			}
+			[[nodiscard]] Error Processing(std::string_view task_name, std::string_view details) const 
+			{
+				return arena::ProcessingError{task_name, details};
+			}
+		};
+
+		// 精簡錯誤工廠：只產生錯誤碼；有側表時才建立完整明細
+		struct LeanErrors 
+		{
+			// 此工廠產生的錯誤型別
+			using Error = ErrorCode;
+			// 明細側表（nullptr 表示不需要明細）
+			ErrorDetails* details;
+
+			[[nodiscard]] Error Read(const std::string& filename) const 
+			{
+				return Make(ErrorKind::kConfigRead, [&] { return OwnedErrors{}.Read(filename); });
+			}
+			[[nodiscard]] Error Parse(std::string_view line_content, int line_number, std::size_t offset) const 
+			{
+				return Make(ErrorKind::kConfigParse, [&] { return OwnedErrors{}.Parse(line_content, line_number, offset); });
+			}
+			[[nodiscard]] Error Validation(std::string_view field_name, std::string_view invalid_value, std::size_t offset) const 
+			{
+				return Make(ErrorKind::kValidation, [&] { return OwnedErrors{}.Validation(field_name, invalid_value, offset); });
+			}
+			[[nodiscard]] Error InvalidField(const kv::Field& field) const 
+			{
+				return Make(ErrorKind::kValidation, [&] { return OwnedErrors{}.InvalidField(field); });
+			}
+			[[nodiscard]] Error Processing(std::string_view task_name, std::string_view details_text) const 
+			{
+				return Make(ErrorKind::kProcessing, [&] { return OwnedErrors{}.Processing(task_name, details_text); });
+			}
+
+		private:
+			// 延遲建立明細：沒有側表時 build 完全不會被呼叫
+			template<typename Build>
+			[[nodiscard]] Error Make(ErrorKind kind, Build&& build) const 
+			{
+				if (details == nullptr) 
+					return ErrorCode{kind};
+				return ErrorCode{kind, details->Record(build())};
+			}
+		};
+
+		// 描述子工廠：只記下位移，不複製任何字串；source 為受檢查的原文
+		struct DescriptorErrors 
+		{
+			// 此工廠產生的錯誤型別
+			using Error = ErrorDescriptor;
+			// 受檢查的原文（位移的基準）
+			std::string_view source;
+
+			[[nodiscard]] Error Read(const std::string&) const 
+			{
+				return {ErrorKind::kConfigRead, MessageId::kOpenFailed};
+			}
+			// 位移由 text 在 source 中的位置得出
+			[[nodiscard]] Error Parse(std::string_view line_content, int line_number, std::size_t) const 
+			{
+				return At(ErrorKind::kConfigParse, MessageId::kMalformedContent, line_content, line_number);
+			}
+			// 唯一的呼叫端是驗證時補解析失敗：field_name 為出錯的那一行，說明改由訊息代碼表示
+			[[nodiscard]] Error Validation(std::string_view field_name, std::string_view, std::size_t) const 
+			{
+				return At(ErrorKind::kValidation, MessageId::kMalformedField, field_name, 0);
+			}
+			[[nodiscard]] Error InvalidField(const kv::Field& field) const 
+			{
+				return {ErrorKind::kValidation, MessageId::kDisallowedField, static_cast<std::uint32_t>(field.line),
+				        static_cast<std::uint32_t>(field.source_offset), static_cast<std::uint32_t>(field.source_size)};
+			}
+			// 處理階段只有「資料太短」一種錯誤
+			[[nodiscard]] Error Processing(std::string_view, std::string_view) const 
+			{
+				return {ErrorKind::kProcessing, MessageId::kDataTooShort};
+			}
+
+		private:
+			// text 指向 source 內部時記下位移；否則（例如空檔的空字串）只留代碼與行號
+			[[nodiscard]] Error At(ErrorKind kind, MessageId message, std::string_view text, int line) const 
+			{
+				Error error{kind, message, static_cast<std::uint32_t>(line)};
+				const auto* base = source.data();
+				if (!text.empty() && std::less_equal<>{}(base, text.data()) && std::less_equal<>{}(text.data() + text.size(), base + source.size())) 
+				{
+					error.offset = static_cast<std::uint32_t>(text.data() - base);
+					error.length = static_cast<std::uint32_t>(text.size());
+				}
+				return error;
+			}
+		};
+
+		// 由單次掃描的換行索引換算出錯誤的行號與該行內容（空檔為第 1 行、內容為空）
+		template<typename Errors>
+		[[nodiscard]] typename Errors::Error MakeParseError(std::string_view content, const scanner::ScanResult& scan, const Errors& errors) 
+		{
+			const auto offset = scan.First(kMalformed).value_or(0);
+			const auto where  = scan.Locate(content, offset);
+			return errors.Parse(where.line_content, where.line_number, offset);
+		}
+
+		// key = value 語法錯誤：行號與該行內容同樣取自換行索引
+		template<typename Errors>
+		[[nodiscard]] typename Errors::Error MakeSyntaxError(std::string_view content, const scanner::ScanResult& scan, const kv::SyntaxError& error, const Errors& errors) 
+		{
+			const auto where = scan.Locate(content, error.offset);
+			return errors.Parse(where.line_content, where.line_number, error.offset);
+		}
+
+		// 驗證規則：逐欄位檢查，回報原文中最早出現的違規欄位（各版本 ValidateData 共用）
+		template<typename Errors>
+		[[nodiscard]] std::expected<void, typename Errors::Error>
+		CheckFields(std::string_view content, const scanner::ScanResult& scan, const kv::Table& fields, const Errors& errors) 
+		{
+			if (HasInvalidField(content, scan)) 
+			{
+				// 手動建立、尚未解析的資料才補解析一次
+				kv::Table parsed;
+				const kv::Table* table = &fields;
+				if (!fields.parsed()) 
+				{
+					auto reparsed = kv::Parse(content);
+					if (!reparsed) 
+					{
+						// 驗證階段只回報驗證錯誤：欄位名稱為出錯的那一行
+						const auto where = SentinelScanner().Scan(content).Locate(content, reparsed.error().offset);
+						return std::unexpected(errors.Validation(where.line_content, reparsed.error().reason, reparsed.error().offset));
+					}
+					parsed = std::move(*reparsed);
+					table  = &parsed;
+				}
+
+				const kv::Field* bad = nullptr;
+				kv::Field        candidate;
+				for (std::size_t i = 0; i < table->size(); ++i) 
+				{
+					const kv::Field field = (*table)[i];
+					if (IsDisallowed(field) && (bad == nullptr || field.line < bad->line)) 
+					{
+						candidate = field;
+						bad       = &candidate;
+					}
+				}
+				if (bad != nullptr) 
+				{
+					// 除錯訊息：驗證不通過
+					CONFIG_LOG(logging::Level::kWarn, "ValidateData detected invalid field: ", bad->key);
+					// 回傳驗證錯誤：出錯的欄位與它的值
+					return std::unexpected(errors.InvalidField(*bad));
+				}
+			}
+
+			// 除錯訊息：驗證通過
+			CONFIG_LOG(logging::Level::kDebug, "Data validated successfully.");
+			return {};
+		}
+
+		// 讀入內容之後的解析檢查：直接讀檔與快取讀檔共用
+		// 檢查直接在呼叫端的內容上進行，成功時才複製（右值 std::string 直接接手）
+		template<typename Errors, typename Content>
+		[[nodiscard]] std::expected<Config, typename Errors::Error> CheckLoadedWith(const std::string& filename, Content&& loaded, scanner::ScanResult scan, const Errors& errors) 
+		{
+			const std::string_view content = loaded;
+			// 示範條件：空檔或包含關鍵字 "malformed" 視為解析錯誤
+			if (IsMalformed(content, scan)) 
+			{
+				// 除錯訊息：指出解析不合法
+				CONFIG_LOG(logging::Level::kWarn, "LoadConfig detected malformed config in ", filename);
+				// 回傳解析錯誤：行號與該行內容取自讀檔時建立的換行索引
+				return std::unexpected(MakeParseError(content, scan, errors));
+			}
+
+			// 解析 key = value 欄位
+			auto fields = kv::Parse(content);
+			if (!fields) 
+			{
+				CONFIG_LOG(logging::Level::kWarn, "LoadConfig detected key/value syntax error in ", filename);
+				return std::unexpected(MakeSyntaxError(content, scan, fields.error(), errors));
+			}
+
+			// 除錯訊息：讀檔、基本檢查皆成功
+			CONFIG_LOG(logging::Level::kDebug, "Config loaded successfully from ", filename);
+			// 回傳成功資料（Config，附上掃描結果與欄位表）
+			return Config{std::string(std::forward<Content>(loaded)), std::move(scan), std::move(*fields)};
+		}
+
+		// 讀設定檔的共用實作
+		template<typename Errors>
+		[[nodiscard]] std::expected<Config, typename Errors::Error> LoadConfigWith(const std::string& filename, const Errors& errors) 
+		{
+			// 嘗試開啟檔案（唯讀）
+			std::ifstream file(filename);
+			// 若檔案開啟失敗，回傳讀檔錯誤
+			if (!file.is_open()) {
+				// 印出除錯訊息（非必要，但有助示範）
+				CONFIG_LOG(logging::Level::kWarn, "LoadConfig failed to open ", filename);
+				// 以 std::unexpected 包裝 ConfigReadError 作為失敗回傳
+				return std::unexpected(errors.Read(filename));
+			}
+
+			// 準備字串串流，將檔案完整讀入
+			std::stringstream buffer;
+			// 將檔案緩衝區寫入字串串流
+			buffer << file.rdbuf();
+			// 取得整份內容
+			std::string content = buffer.str();
+			// 單次掃描所有階段的哨兵關鍵字，結果隨 Config 傳給後續階段
+			scanner::ScanResult scan = SentinelScanner().Scan(content);
+			// 解析檢查與快取版本共用
+			return CheckLoadedWith(filename, std::move(content), std::move(scan), errors);
+		}
+
+		// 驗證資料的共用實作：左值複製一次內容，右值直接接手緩衝區
+		template<typename Errors, typename ConfigRef>
+		[[nodiscard]] std::expected<ValidatedData, typename Errors::Error> ValidateDataWith(ConfigRef&& config, const Errors& errors) 
+		{
+			// 驗證規則（左值、右值與 mmap 版本共用）
+			if (auto checked = CheckFields(config.data, config.scan, config.fields, errors); !checked) 
+				return std::unexpected(std::move(checked.error()));
+
+			// 回傳成功資料：前綴只以標記保存
+			return ValidatedData{std::forward<ConfigRef>(config).data, kValidatedTag};
+		}
+
+		// 收集模式的解析檢查：malformed 那一行與每個語法錯誤各一筆，同一行只回報一次
+		template<typename Content, typename List>
+		[[nodiscard]] std::optional<Config> CollectLoaded(const std::string& filename, Content&& loaded, scanner::ScanResult scan, List& errors) 
+		{
+			const TypedErrors<typename List::value_type> make;
+			const std::string_view content = loaded;
+			int reported_line = 0;
+			if (IsMalformed(content, scan)) 
+			{
+				CONFIG_LOG(logging::Level::kWarn, "LoadConfig detected malformed config in ", filename);
+				errors.push_back(MakeParseError(content, scan, make));
+				reported_line = std::get<ConfigParseError>(errors[errors.size() - 1]).line_number;
+			}
+
+			// 略過出錯的欄位繼續解析：其餘欄位照常交給驗證階段
+			std::vector<kv::SyntaxError> syntax;
+			kv::Table fields = kv::Parse(content, syntax);
+			for (const kv::SyntaxError& error : syntax) 
+			{
+				const auto where = scan.Locate(content, error.offset);
+				if (where.line_number == reported_line) 
+					continue;
+				CONFIG_LOG(logging::Level::kWarn, "LoadConfig detected key/value syntax error in ", filename);
+				errors.push_back(make.Parse(where.line_content, where.line_number, error.offset));
+				reported_line = where.line_number;
+			}
+			return Config{std::string(std::forward<Content>(loaded)), std::move(scan), std::move(fields)};
+		}
+
+		// 收集模式的驗證：回報所有違規欄位（依行號），而不是只有最早的一個
+		template<typename ConfigRef, typename List>
+		[[nodiscard]] std::optional<ValidatedData> CollectValidated(ConfigRef&& config, List& errors) 
+		{
+			const TypedErrors<typename List::value_type> make;
+			const std::size_t before = errors.size();
+			if (HasInvalidField(config.data, config.scan)) 
+			{
+				// 手動建立、尚未解析的資料才補解析一次；語法錯誤同樣以驗證錯誤回報
+				kv::Table parsed;
+				const kv::Table* table = &config.fields;
+				if (!config.fields.parsed()) 
+				{
+					std::vector<kv::SyntaxError> syntax;
+					parsed = kv::Parse(config.data, syntax);
+					if (!syntax.empty()) 
+					{
+						const scanner::ScanResult scan = SentinelScanner().Scan(config.data);
+						for (const kv::SyntaxError& error : syntax) 
+							errors.push_back(make.Validation(scan.Locate(config.data, error.offset).line_content, error.reason, error.offset));
+					}
+					table = &parsed;
+				}
+
+				std::vector<kv::Field> bad;
+				for (std::size_t i = 0; i < table->size(); ++i) 
+				{
+					if (const kv::Field field = (*table)[i]; IsDisallowed(field)) 
+						bad.push_back(field);
+				}
+				std::sort(bad.begin(), bad.end(), [](const kv::Field& a, const kv::Field& b) { return a.line < b.line; });
+				for (const kv::Field& field : bad) 
+				{
+					CONFIG_LOG(logging::Level::kWarn, "ValidateData detected invalid field: ", field.key);
+					errors.push_back(make.InvalidField(field));
+				}
+			}
+			if (errors.size() != before) 
+				return std::nullopt;
+
+			CONFIG_LOG(logging::Level::kDebug, "Data validated successfully.");
+			return ValidatedData{std::forward<ConfigRef>(config).data, kValidatedTag};
+		}
+
+		// 把整個檔案讀進 buffer（沿用容量）：一般檔案以 fstat 取得大小後一次 read，不經過 ifstream 的內部緩衝；
+		// 有配置政策時先預留空間並套用政策，再由 resize 第一次寫入
+		[[nodiscard]] bool ReadInto(const std::string& filename, std::string& buffer, const memory::Policy& policy = {}) 
+		{
+			const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0) 
+				return false;
+			struct stat st{};
+			if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) 
+			{
+				::close(fd);
+				return false;
+			}
+			const auto size = static_cast<std::size_t>(st.st_size);
+			if (policy.applies(size) && buffer.capacity() < size) 
+			{
+				buffer.reserve(size);
+				memory::Prepare(buffer.data(), size, policy);
+			}
+			buffer.resize(size);
+			std::size_t done = 0;
+			while (done < buffer.size()) 
+			{
+				const ssize_t n = ::read(fd, buffer.data() + done, buffer.size() - done);
+				if (n < 0 && errno == EINTR) 
+					continue;
+				if (n < 0) 
+				{
+					::close(fd);
+					return false;
+				}
+				// 檔案在 fstat 之後變短：以實際讀到的為準
+				if (n == 0) 
+					break;
+				done += static_cast<std::size_t>(n);
+			}
+			buffer.resize(done);
+			::close(fd);
+			return true;
+		}
+
+		// 處理資料的共用實作
+		template<typename Errors>
+		[[nodiscard]] std::expected<Result, typename Errors::Error> ProcessDataWith(const ValidatedData& data, const Errors& errors) 
+		{
+			// 示範條件：處理前的資料長度（含前綴）小於 10 視為處理失敗
+			if (data.size() < 10) 
+			{
+				// 除錯訊息：處理失敗，資料太短
+				CONFIG_LOG(logging::Level::kWarn, "ProcessData detected data too short.");
+				// 回傳處理階段錯誤（任務名稱＋說明）
+				return std::unexpected(errors.Processing(kProcessingTask, kDataTooShortDetail));
+			}
+
+			// 除錯訊息：處理成功
+			CONFIG_LOG(logging::Level::kDebug, "Data processed successfully.");
+			// 回傳結果（此處以字串長度當作結果碼）
+			return Result{static_cast<int>(data.size())};
+		}
+
+		// 收集模式的讀檔：PipelineError 與單一階段的清單共用
+		template<typename List>
+		[[nodiscard]] std::optional<Config> CollectFile(const std::string& filename, List& errors) 
+		{
+			// 讀檔失敗：沒有內容可繼續檢查
+			std::ifstream file(filename);
+			if (!file.is_open()) 
+			{
+				CONFIG_LOG(logging::Level::kWarn, "LoadConfig failed to open ", filename);
+				errors.push_back(TypedErrors<typename List::value_type>{}.Read(filename));
+				return std::nullopt;
+			}
+			std::stringstream buffer;
+			buffer << file.rdbuf();
+			std::string content = buffer.str();
+			scanner::ScanResult scan = SentinelScanner().Scan(content);
+			return CollectLoaded(filename, std::move(content), std::move(scan), errors);
+		}
+
+		// 緩衝區重用模式的共用實作：與 CheckLoadedWith 相同的檢查，但掃描結果與欄位表寫入池中物件既有的容量
+		template<typename Errors>
+		[[nodiscard]] std::expected<Config, typename Errors::Error> LoadConfigPooledWith(const std::string& filename, const Errors& errors) 
+		{
+			Config config = pool::Pool<Config>::Acquire();
+			config.data   = pool::Pool<std::string>::Acquire();
+			if (!ReadInto(filename, config.data)) 
+			{
+				CONFIG_LOG(logging::Level::kWarn, "LoadConfig failed to open ", filename);
+				Recycle(std::move(config));
+				return std::unexpected(errors.Read(filename));
+			}
+
+			SentinelScanner().Scan(config.data, config.scan);
+			if (IsMalformed(config.data, config.scan)) 
+			{
+				CONFIG_LOG(logging::Level::kWarn, "LoadConfig detected malformed config in ", filename);
+				auto error = MakeParseError(config.data, config.scan, errors);
+				Recycle(std::move(config));
+				return std::unexpected(std::move(error));
+			}
+			if (auto parsed = kv::ParseInto(config.data, config.fields); !parsed) 
+			{
+				CONFIG_LOG(logging::Level::kWarn, "LoadConfig detected key/value syntax error in ", filename);
+				auto error = MakeSyntaxError(config.data, config.scan, parsed.error(), errors);
+				Recycle(std::move(config));
+				return std::unexpected(std::move(error));
+			}
+			CONFIG_LOG(logging::Level::kDebug, "Config loaded successfully from ", filename);
+			return config;
+		}
+
+		template<typename Errors>
+		[[nodiscard]] std::expected<ValidatedData, typename Errors::Error> ValidateDataPooledWith(Config&& config, const Errors& errors) 
+		{
+			if (auto checked = CheckFields(config.data, config.scan, config.fields, errors); !checked) 
+			{
+				Recycle(std::move(config));
+				return std::unexpected(std::move(checked.error()));
+			}
+			ValidatedData data{std::move(config.data), kValidatedTag};
+			Recycle(std::move(config));
+			return data;
+		}
+
+		template<typename Errors>
+		[[nodiscard]] std::expected<Result, typename Errors::Error> ProcessDataPooledWith(ValidatedData&& data, const Errors& errors) 
+		{
+			auto result = ProcessDataWith(data, errors);
+			Recycle(std::move(data));
+			return result;
+		}
+	}
+
+	// 管線共用的哨兵掃描器：所有階段的關鍵字一次編進同一個自動機
+	const scanner::MultiPatternScanner& SentinelScanner() 
+	{
+		// 函式內靜態物件：執行緒安全的延遲初始化
+		static const scanner::MultiPatternScanner instance({"malformed", "invalid_field"});
+		return instance;
+	}
 
 	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
 	[[nodiscard]] std::expected<Config, PipelineError>	LoadConfig(const std::string& filename) 
 	{
-		// 嘗試開啟檔案（唯讀）
-		std::ifstream file(filename);
-		// 若檔案開啟失敗，回傳讀檔錯誤
-		if (!file.is_open()) {
-			// 印出除錯訊息（非必要，但有助示範）
-			std::cerr << "DEBUG: LoadConfig failed to open " << filename << std::endl;
-			// 以 std::unexpected 包裝 ConfigReadError 作為失敗回傳
+		return LoadConfigWith(filename, OwnedErrors{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, PipelineError>
+	ValidateData(const Config& config) {
+		// 複製一次內容
+		return ValidateDataWith(config, OwnedErrors{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, PipelineError>
+	ValidateData(Config&& config) 
+	{
+		// 直接接手 config.data 的緩衝區，不配置、不複製
+		return ValidateDataWith(std::move(config), OwnedErrors{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Result, PipelineError>
+	ProcessData(const ValidatedData& data) 
+	{
+		return ProcessDataWith(data, OwnedErrors{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Result, PipelineError>
+	ProcessData(ValidatedData&& data) 
+	{
+		// 取得所有權：函式結束時緩衝區隨 consumed 一起釋放，不再經過呼叫端
+		const ValidatedData consumed = std::move(data);
+		return ProcessData(consumed);
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Config, LoadError> LoadConfig(const std::string& filename, Exact) 
+	{
+		return LoadConfigWith(filename, TypedErrors<LoadError>{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, ValidateError> ValidateData(const Config& config, Exact) 
+	{
+		return ValidateDataWith(config, TypedErrors<ValidateError>{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, ValidateError> ValidateData(Config&& config, Exact) 
+	{
+		return ValidateDataWith(std::move(config), TypedErrors<ValidateError>{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Result, ProcessError> ProcessData(const ValidatedData& data, Exact) 
+	{
+		return ProcessDataWith(data, TypedErrors<ProcessError>{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Result, ProcessError> ProcessData(ValidatedData&& data, Exact) 
+	{
+		const ValidatedData consumed = std::move(data);
+		return ProcessData(consumed, Exact{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<void, PipelineError> ValidateField(const kv::Field& field) 
+	{
+		if (IsDisallowed(field)) 
+			return std::unexpected(OwnedErrors{}.InvalidField(field));
+		return {};
+	}
+
+	/*==============================Arena 錯誤版本======================================*/
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Config, arena::PipelineError> LoadConfig(const std::string& filename, arena::ErrorArena& errors) 
+	{
+		return LoadConfigWith(filename, ArenaErrors{errors.resource()});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, arena::PipelineError> ValidateData(const Config& config, arena::ErrorArena& errors) 
+	{
+		return ValidateDataWith(config, ArenaErrors{errors.resource()});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, arena::PipelineError> ValidateData(Config&& config, arena::ErrorArena& errors) 
+	{
+		return ValidateDataWith(std::move(config), ArenaErrors{errors.resource()});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Result, arena::PipelineError> ProcessData(const ValidatedData& data, arena::ErrorArena& errors) 
+	{
+		return ProcessDataWith(data, ArenaErrors{errors.resource()});
+	}
+
+	/*==============================精簡錯誤碼版本======================================*/
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Config, ErrorCode> LoadConfig(const std::string& filename, ErrorDetails* details) 
+	{
+		return LoadConfigWith(filename, LeanErrors{details});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, ErrorCode> ValidateData(const Config& config, ErrorDetails* details) 
+	{
+		return ValidateDataWith(config, LeanErrors{details});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, ErrorCode> ValidateData(Config&& config, ErrorDetails* details) 
+	{
+		return ValidateDataWith(std::move(config), LeanErrors{details});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Result, ErrorCode> ProcessData(const ValidatedData& data, ErrorDetails* details) 
+	{
+		return ProcessDataWith(data, LeanErrors{details});
+	}
+
+	// 轉成完整的 PipelineError：有明細時取用明細，否則依種類建立欄位為空的錯誤
+	[[nodiscard]] PipelineError ToPipelineError(ErrorCode code, const ErrorDetails* details) 
+	{
+		if (details != nullptr && code.has_detail()) 
+			return details->at(code.detail);
+
+		switch (code.kind) 
+		{
+			case ErrorKind::kConfigRead:  return ConfigReadError{};
+			case ErrorKind::kConfigParse: return ConfigParseError{{}, 0};
+			case ErrorKind::kValidation:  return ValidationError{};
+			case ErrorKind::kProcessing:  break;
+		}
+		return ProcessingError{};
+	}
+
+	/*==============================錯誤描述子版本======================================*/
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Config, ErrorDescriptor> LoadConfigFromBuffer(const std::string& filename, std::string_view content, Describe) 
+	{
+		// 檢查直接在呼叫端的內容上進行，描述子的位移相對於 content；成功時才複製一份給 Config
+		scanner::ScanResult scan = SentinelScanner().Scan(content);
+		return CheckLoadedWith(filename, content, std::move(scan), DescriptorErrors{content});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, ErrorDescriptor> ValidateData(const Config& config, Describe) 
+	{
+		return ValidateDataWith(config, DescriptorErrors{config.data});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, ErrorDescriptor> ValidateData(const MappedConfig& config, Describe) 
+	{
+		// 映射在 MappedConfig 存活期間不會變動，正好作為描述子的原文
+		if (auto checked = CheckFields(config.data, config.scan, config.fields, DescriptorErrors{config.data}); !checked) 
+			return std::unexpected(checked.error());
+		return ValidatedData{std::string(config.data), kValidatedTag};
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Result, ErrorDescriptor> ProcessData(const ValidatedData& data, Describe) 
+	{
+		return ProcessDataWith(data, DescriptorErrors{});
+	}
+
+	// 依訊息代碼回原文取字；位移超出 source 時（給錯了原文）該段為空
+	[[nodiscard]] ErrorView Resolve(const ErrorDescriptor& error, const ErrorSource& source) noexcept 
+	{
+		const bool in_range = std::size_t{error.offset} + error.length <= source.content.size();
+		const std::string_view text = in_range ? source.content.substr(error.offset, error.length) : std::string_view{};
+		switch (error.message) 
+		{
+			case MessageId::kOpenFailed:       return {error.kind, source.filename};
+			case MessageId::kMalformedContent: return {error.kind, text, {}, static_cast<int>(error.line)};
+			case MessageId::kDisallowedField: 
+			{
+				// 與驗證時相同的拆法與說明
+				const kv::Field field = kv::SplitField(text);
+				return {error.kind, field.key, InvalidValueOf(field)};
+			}
+			case MessageId::kMalformedField:   return {error.kind, text, "malformed field"};
+			case MessageId::kDataTooShort:     return {error.kind, kProcessingTask, kDataTooShortDetail};
+		}
+		return {error.kind};
+	}
+
+	// 報告時才建立字串
+	[[nodiscard]] PipelineError ToPipelineError(const ErrorDescriptor& error, const ErrorSource& source) 
+	{
+		const ErrorView view = Resolve(error, source);
+		const OwnedErrors owned;
+		switch (view.kind) 
+		{
+			case ErrorKind::kConfigRead:  return owned.Read(std::string(view.subject));
+			case ErrorKind::kConfigParse: return owned.Parse(view.subject, view.line, error.offset);
+			case ErrorKind::kValidation:  return owned.Validation(view.subject, view.detail, error.offset);
+			case ErrorKind::kProcessing:  break;
+		}
+		return owned.Processing(view.subject, view.detail);
+	}
+
+	// 轉回一般（自行擁有字串）的 PipelineError：錯誤要活過 arena 重置時使用
+	[[nodiscard]] PipelineError ToOwned(const arena::PipelineError& error) 
+	{
+		// 直接用 OwnedErrors 依型別重建
+		const OwnedErrors owned;
+		return std::visit(Overloaded{
+			[&](const arena::ConfigReadError& e)  { return owned.Read(std::string(e.filename)); },
+			[&](const arena::ConfigParseError& e) { return owned.Parse(e.line_content, e.line_number, 0); },
+			[&](const arena::ValidationError& e)  { return owned.Validation(e.field_name, e.invalid_value, 0); },
+			[&](const arena::ProcessingError& e)  { return owned.Processing(e.task_name, e.details); },
+		}, error);
+	}
+
+	/*==============================記憶體映射讀檔模式==================================*/
+
+	// 私有建構子：接管 Open 建立好的映射
+	MappedFile::MappedFile(void* address, std::size_t size, std::size_t length) noexcept
+		: address_(address), size_(size), length_(length) 
+	{
+	}
+
+	// 移動建構：接手來源的映射，並把來源清成空映射
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: address_(std::exchange(other.address_, nullptr)),
+		  size_(std::exchange(other.size_, 0)),
+		  length_(std::exchange(other.length_, 0)) 
+	{
+	}
+
+	// 移動指派：先釋放自己的映射，再接手來源的映射
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept 
+	{
+		if (this != &other) 
+		{
+			Release();
+			address_ = std::exchange(other.address_, nullptr);
+			size_    = std::exchange(other.size_, 0);
+			length_  = std::exchange(other.length_, 0);
+		}
+		return *this;
+	}
+
+	// 解構：釋放映射
+	MappedFile::~MappedFile() 
+	{
+		Release();
+	}
+
+	// 釋放映射（空映射時不做事）
+	void MappedFile::Release() noexcept 
+	{
+		if (address_ != nullptr) 
+		{
+			::munmap(address_, length_);
+			address_ = nullptr;
+			size_    = 0;
+			length_  = 0;
+		}
+	}
+
+	// 以字串檢視存取映射內容
+	std::string_view MappedFile::view() const noexcept 
+	{
+		// 空映射回傳空檢視
+		if (address_ == nullptr) 
+			return {};
+		return {static_cast<const char*>(address_), size_};
+	}
+
+	// 以唯讀方式映射整個檔案
+	std::expected<MappedFile, PipelineError> MappedFile::Open(const std::string& filename) 
+	{
+		return Open(filename, memory::Policy{});
+	}
+
+	// 依政策映射：預設為檔案映射；要求明確大頁或節點放置時，改為在呼叫端執行緒讀進匿名映射
+	std::expected<MappedFile, PipelineError> MappedFile::Open(const std::string& filename, const memory::Policy& policy) 
+	{
+		// 唯讀開檔；CLOEXEC 避免 fd 洩漏到子行程
+		const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+		// 開檔失敗：與 LoadConfig 一致，回傳讀檔錯誤
+		if (fd < 0) 
+			return std::unexpected(ConfigReadError{filename});
+
+		// 取得檔案大小；非一般檔案（例如目錄）同樣視為讀檔錯誤
+		struct stat st{};
+		if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) 
+		{
+			::close(fd);
 			return std::unexpected(ConfigReadError{filename});
 		}
 
-		// 準備字串串流，將檔案完整讀入
-		std::stringstream buffer;
-		// 將檔案緩衝區寫入字串串流
-		buffer << file.rdbuf();
-		// 取得整份內容
-		std::string content = buffer.str();
+		// 空檔案無法 mmap（長度 0 會回傳 EINVAL），直接回傳空映射，交由解析檢查處理
+		const auto size = static_cast<std::size_t>(st.st_size);
+		if (size == 0) 
+		{
+			::close(fd);
+			return MappedFile{};
+		}
 
-		// 示範條件：空檔或包含關鍵字 "malformed" 視為解析錯誤
-		if (content.empty() || content.find("malformed") != std::string::npos) 
+		// 頁快取的頁面由第一次讀進快取的行程決定，無法改用 MAP_HUGETLB 或搬到呼叫端的節點：
+		// 這兩種要求改為複製一次到匿名映射（在呼叫端執行緒寫入，頁面即落在它的節點）
+		if (policy.applies(size) && 
+		    (policy.huge_pages == memory::HugePages::kExplicit || policy.placement != memory::Placement::kDefault)) 
+		{
+			auto mapping = memory::MapAnonymous(size, policy);
+			if (!mapping) 
+			{
+				::close(fd);
+				return std::unexpected(ConfigReadError{filename});
+			}
+			MappedFile owned{mapping->address, size, mapping->length};
+			std::size_t done = 0;
+			while (done < size) 
+			{
+				const ssize_t n = ::pread(fd, static_cast<char*>(mapping->address) + done, size - done, static_cast<off_t>(done));
+				if (n < 0 && errno == EINTR) 
+					continue;
+				if (n < 0) 
+				{
+					::close(fd);
+					return std::unexpected(ConfigReadError{filename});
+				}
+				// 檔案在 fstat 之後變短：以實際讀到的為準
+				if (n == 0) 
+					break;
+				done += static_cast<std::size_t>(n);
+			}
+			::close(fd);
+			owned.size_ = done;
+			// 與檔案映射相同：內容唯讀
+			::mprotect(mapping->address, mapping->length, PROT_READ);
+			return owned;
+		}
+
+		// 建立唯讀私有映射；映射建立後即可關閉 fd，映射仍保持有效
+		void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		// 映射失敗：回傳讀檔錯誤
+		if (address == MAP_FAILED) 
+			return std::unexpected(ConfigReadError{filename});
+
+		// 提示核心將以循序方式讀取，加大預讀
+		::madvise(address, size, MADV_SEQUENTIAL);
+		// 透明大頁：檔案映射只在核心支援唯讀檔案 THP 時生效，其餘情況為無害的提示
+		if (policy.applies(size) && policy.huge_pages != memory::HugePages::kNone) 
+			::madvise(address, size, MADV_HUGEPAGE);
+		return MappedFile{address, size, size};
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<MappedConfig, PipelineError> LoadConfigMapped(const std::string& filename) 
+	{
+		return LoadConfigMapped(filename, memory::Policy{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<MappedConfig, PipelineError> LoadConfigMapped(const std::string& filename, const memory::Policy& policy) 
+	{
+		// 建立映射；失敗時已是 ConfigReadError
+		auto mapping = MappedFile::Open(filename, policy);
+		if (!mapping) 
+		{
+			// 印出除錯訊息（非必要，但有助示範）
+			CONFIG_LOG(logging::Level::kWarn, "LoadConfigMapped failed to map ", filename);
+			return std::unexpected(std::move(mapping.error()));
+		}
+
+		// 直接在映射記憶體上做解析檢查，不複製內容
+		const std::string_view content = mapping->view();
+		// 單次掃描所有階段的哨兵關鍵字
+		scanner::ScanResult scan = SentinelScanner().Scan(content);
+		if (IsMalformed(content, scan)) 
 		{
 			// 除錯訊息：指出解析不合法
-			std::cerr << "DEBUG: LoadConfig detected malformed config in " << filename << std::endl;
-			// 回傳解析錯誤（行號固定示範為 1）
-			return std::unexpected(ConfigParseError{"malformed", 1});
+			CONFIG_LOG(logging::Level::kWarn, "LoadConfigMapped detected malformed config in ", filename);
+			// 回傳解析錯誤：行號與該行內容取自讀檔時建立的換行索引
+			return std::unexpected(MakeParseError(content, scan, OwnedErrors{}));
 		}
 
-		// 除錯訊息：讀檔、基本檢查皆成功
-		std::cout << "DEBUG: Config loaded successfully from " << filename << std::endl;
-		// 回傳成功資料（Config）
-		return Config{content};
+		// 解析 key = value 欄位（複製到獨立的字串池）
+		auto fields = kv::Parse(content);
+		if (!fields) 
+		{
+			CONFIG_LOG(logging::Level::kWarn, "LoadConfigMapped detected key/value syntax error in ", filename);
+			return std::unexpected(MakeSyntaxError(content, scan, fields.error(), OwnedErrors{}));
+		}
+
+		// 除錯訊息：映射、基本檢查皆成功
+		CONFIG_LOG(logging::Level::kDebug, "Config mapped successfully from ", filename);
+		// 回傳成功資料：handle、檢視與欄位表一起交給呼叫端
+		return MappedConfig{std::move(*mapping), content, std::move(scan), std::move(*fields)};
 	}
 
 	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
 	[[nodiscard]] std::expected<ValidatedData, PipelineError>
-	ValidateData(const Config& config) {
-		// 示範條件：若包含 "invalid_field" 視為驗證失敗
-		if (config.data.find("invalid_field") != std::string::npos) 
+	ValidateData(const MappedConfig& config) 
+	{
+		// 驗證規則與 std::string 版本相同
+		if (auto checked = CheckFields(config.data, config.scan, config.fields, OwnedErrors{}); !checked) 
+			return std::unexpected(std::move(checked.error()));
+
+		// 唯一一次複製：由映射內容組出已驗證資料
+		return ValidatedData{std::string(config.data), kValidatedTag};
+	}
+
+	/*==============================快取讀檔模式========================================*/
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Config, PipelineError> LoadConfig(filecache::FileCache& cache, const std::string& filename) 
+	{
+		// 未變更的檔案只做一次 stat；不存在的檔案在 TTL 內連 stat 都省略
+		auto entry = cache.Get(filename);
+		if (!entry) 
 		{
-			// 除錯訊息：驗證不通過
-			std::cerr << "DEBUG: ValidateData detected invalid field." << std::endl;
-			// 回傳驗證錯誤與欄位資訊
-			return std::unexpected(ValidationError{"invalid_field", "contains disallowed value"});
+			// 印出除錯訊息（非必要，但有助示範）
+			CONFIG_LOG(logging::Level::kWarn, "LoadConfig (cached) failed to read ", filename);
+			return std::unexpected(ConfigReadError{filename});
 		}
 
-		// 除錯訊息：驗證通過
-		std::cout << "DEBUG: Data validated successfully." << std::endl;
-		// 回傳成功資料（附上前綴表示已驗證）
-		return ValidatedData{"Validated: " + config.data};
+		// 快取內容為共享唯讀；Config 擁有自己的緩衝，複製一次內容與掃描結果（不需系統呼叫）
+		return CheckLoadedWith(filename, (*entry)->data, (*entry)->scan, OwnedErrors{});
 	}
 
 	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
-	[[nodiscard]] std::expected<Result, PipelineError>
-	ProcessData(const ValidatedData& data) 
+	[[nodiscard]] std::expected<Config, PipelineError> LoadConfigFromBuffer(const std::string& filename, std::string content) 
+	{
+		// 與 LoadConfig 相同：單次掃描後做解析檢查
+		scanner::ScanResult scan = SentinelScanner().Scan(content);
+		return CheckLoadedWith(filename, std::move(content), std::move(scan), OwnedErrors{});
+	}
+
+	/*==============================收集所有錯誤模式====================================*/
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::optional<Config> LoadConfig(const std::string& filename, ErrorList& errors) 
+	{
+		return CollectFile(filename, errors);
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::optional<Config> LoadConfigFromBuffer(const std::string& filename, std::string content, ErrorList& errors) 
+	{
+		scanner::ScanResult scan = SentinelScanner().Scan(content);
+		return CollectLoaded(filename, std::move(content), std::move(scan), errors);
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::optional<ValidatedData> ValidateData(const Config& config, ErrorList& errors) 
 	{
-		// 示範條件：處理前的資料長度小於 10 視為處理失敗
-		if (data.processed_data.length() < 10) 
+		return CollectValidated(config, errors);
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::optional<ValidatedData> ValidateData(Config&& config, ErrorList& errors) 
+	{
+		return CollectValidated(std::move(config), errors);
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::optional<Config> LoadConfig(const std::string& filename, LoadErrorList& errors) 
+	{
+		return CollectFile(filename, errors);
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::optional<ValidatedData> ValidateData(const Config& config, ValidateErrorList& errors) 
+	{
+		return CollectValidated(config, errors);
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::optional<ValidatedData> ValidateData(Config&& config, ValidateErrorList& errors) 
+	{
+		return CollectValidated(std::move(config), errors);
+	}
+
+	/*==============================配置政策模式========================================*/
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Config, PipelineError> LoadConfig(const std::string& filename, const memory::Policy& policy) 
+	{
+		// 新配置的緩衝區：不取自物件池（池中的緩衝區可能由其他節點上的執行緒第一次寫入）
+		std::string content;
+		if (!ReadInto(filename, content, policy)) 
 		{
-			// 除錯訊息：處理失敗，資料太短
-			std::cerr << "DEBUG: ProcessData detected data too short." << std::endl;
-			// 回傳處理階段錯誤（任務名稱＋說明）
-			return std::unexpected(ProcessingError{"Data Processing", "Input data too short for task"});
+			CONFIG_LOG(logging::Level::kWarn, "LoadConfig failed to open ", filename);
+			return std::unexpected(OwnedErrors{}.Read(filename));
 		}
+		scanner::ScanResult scan = SentinelScanner().Scan(content);
+		return CheckLoadedWith(filename, std::move(content), std::move(scan), OwnedErrors{});
+	}
+
+	/*==============================緩衝區重用模式======================================*/
+
+	// 內容緩衝區與 Config 的其餘部分分開放：ValidateDataPooled 把內容交給 ValidatedData 之後，兩者各自歸還
+	void Recycle(Config&& config) 
+	{
+		// 已被移走（只剩短字串內建容量）的緩衝區不歸還：否則池中堆滿沒有容量的空字串
+		if (config.data.capacity() > std::string{}.capacity()) 
+			pool::Pool<std::string>::Release(std::move(config.data));
+		config.data = std::string{};
+		config.scan.hits.clear();
+		config.scan.newlines.clear();
+		config.scan.scanned = false;
+		config.fields.clear();
+		pool::Pool<Config>::Release(std::move(config));
+	}
 
-		// 除錯訊息：處理成功
-		std::cout << "DEBUG: Data processed successfully." << std::endl;
-		// 回傳結果（此處以字串長度當作結果碼）
-		return Result{static_cast<int>(data.processed_data.length())};
+	void Recycle(ValidatedData&& data) 
+	{
+		if (data.processed_data.capacity() > std::string{}.capacity()) 
+			pool::Pool<std::string>::Release(std::move(data.processed_data));
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Config, PipelineError> LoadConfigPooled(const std::string& filename) 
+	{
+		return LoadConfigPooledWith(filename, OwnedErrors{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, PipelineError> ValidateDataPooled(Config&& config) 
+	{
+		return ValidateDataPooledWith(std::move(config), OwnedErrors{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Result, PipelineError> ProcessDataPooled(ValidatedData&& data) 
+	{
+		return ProcessDataPooledWith(std::move(data), OwnedErrors{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Config, LoadError> LoadConfigPooled(const std::string& filename, Exact) 
+	{
+		return LoadConfigPooledWith(filename, TypedErrors<LoadError>{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<ValidatedData, ValidateError> ValidateDataPooled(Config&& config, Exact) 
+	{
+		return ValidateDataPooledWith(std::move(config), TypedErrors<ValidateError>{});
+	}
+
+	// 加上 [[nodiscard]]：提醒呼叫端不可忽略回傳結果
+	[[nodiscard]] std::expected<Result, ProcessError> ProcessDataPooled(ValidatedData&& data, Exact) 
+	{
+		return ProcessDataPooledWith(std::move(data), TypedErrors<ProcessError>{});
 	}
 
 // 結束命名空間
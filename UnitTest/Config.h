@@ -11,15 +11,36 @@
 #include <iostream>
 // 字串串流，方便把整個檔案讀進字串
 #include <sstream>
+// std::optional：收集模式的階段結果
+#include <optional>
 // std::string 型別
 #include <string>
+// std::string_view：不擁有記憶體的字串檢視（mmap 模式使用）
+#include <string_view>
 // std::variant / std::visit 等列舉型別聯合
 #include <variant>
+// 單次多樣式掃描器（哨兵關鍵字檢查）
+#include "Scanner.h"
+// 檔案內容快取（快取讀檔模式）
+#include "FileCache.h"
+// 編譯期型別清單（各階段錯誤集合的聯集）
+#include "TypeList.h"
+// key = value 欄位表（字串池 + 已排序位移表）
+#include "KeyValue.h"
+// 小型向量（收集模式的錯誤清單）
+#include "SmallVector.h"
+// 大型內容的大頁與 NUMA 配置政策
+#include "MemoryPolicy.h"
 
 /*
 PART I - 定義錯誤類型
 PART II - 定義錯誤變數
 PART III - 宣告 LoadConfig & ValidateData & ProcessData & handle_pipeline_result
+PART IV - 記憶體映射（mmap）讀檔模式
+PART V - 快取讀檔模式
+PART VI - 收集所有錯誤模式
+PART VII - 緩衝區重用模式
+PART VIII - 配置政策模式
 */
 
 // 開始命名空間：將相關結構與函式封裝
@@ -41,6 +62,8 @@ namespace config
 		std::string line_content;
 		// 出錯的行號（以 1 起算）
 		int line_number;
+		// 出錯位置在原文中的位移（位元組；with_context 記入 ContextFrame）
+		std::size_t offset = 0;
 	};
 
 	// 定義「驗證資料錯誤」的錯誤型別，指出錯誤欄位與其不合法值
@@ -50,6 +73,8 @@ namespace config
 		std::string field_name;
 		// 不合法的值或說明
 		std::string invalid_value;
+		// 出錯欄位在原文中的位移（位元組；with_context 記入 ContextFrame）
+		std::size_t offset = 0;
 	};
 
 	// 定義「處理階段錯誤」的錯誤型別，描述任務名稱與細節
@@ -63,11 +88,23 @@ namespace config
 
 	/*==============================2. 定義錯誤變數=====================================*/
 
-	// 將所有錯誤型別聚合成單一 variant，供整條管線的 std::expected 使用
-	using PipelineError = std::variant<ConfigReadError,
-									   ConfigParseError,
-									   ValidationError,
-									   ProcessingError>;
+	// LoadConfig 可能產生的錯誤：讀檔失敗、解析失敗
+	using LoadErrors     = meta::TypeList<ConfigReadError, ConfigParseError>;
+	// ValidateData 可能產生的錯誤
+	using ValidateErrors = meta::TypeList<ValidationError>;
+	// ProcessData 可能產生的錯誤
+	using ProcessErrors  = meta::TypeList<ProcessingError>;
+
+	// 將所有階段的錯誤型別聚合成單一 variant（編譯期合併、去除重複），供整條管線的 std::expected 使用
+	// 順序即各階段清單的順序：ConfigReadError, ConfigParseError, ValidationError, ProcessingError
+	using PipelineError = meta::UnionVariant<LoadErrors, ValidateErrors, ProcessErrors>;
+
+	// 各階段只含自身錯誤的 variant：標上 Exact 的版本回傳這些型別，需要 PipelineError 時以 meta::Widen 放寬
+	using LoadError     = meta::AsVariant<LoadErrors>;
+	using ValidateError = meta::AsVariant<ValidateErrors>;
+	using ProcessError  = meta::AsVariant<ProcessErrors>;
+	// 標籤：選擇回傳該階段自身錯誤型別的版本（Pipeline 的階段使用，不必在執行期收窄）
+	struct Exact {};
 
 	// 建立一個泛型小工具 Overloaded：把多個 Lambda 的 operator() 聚合，方便 std::visit 使用
 	template<typename... Ts>
@@ -82,13 +119,27 @@ namespace config
 	{
 		// 讀入的純文字設定內容
 		std::string data;
+		// LoadConfig 讀檔時的單次哨兵掃描結果，後續階段直接取用，不再重掃
+		scanner::ScanResult scan{};
+		// LoadConfig 解析出的 key = value 欄位（手動建立的 Config 未解析，ValidateData 時補做）
+		kv::Table fields{};
 	};
 
+	// 已驗證資料的標記字樣：靜態字面值，以中繼資料保存，不與內容串接
+	inline constexpr std::string_view kValidatedTag = "Validated: ";
+
 	// 定義「驗證過的資料」結構，作為 ValidateData 的成功結果
 	struct ValidatedData 
 	{
-		// 為了示範，透過前綴字樣標示已驗證
-		std::string processed_data;
+		// 驗證後的內容（右值版本的 ValidateData 會直接沿用 Config::data 的緩衝區）
+		std::string      processed_data;
+		// 為了示範，透過前綴字樣標示已驗證；只存檢視，不再做 "Validated: " + data 的串接配置
+		std::string_view tag{};
+
+		// 邏輯長度：前綴 + 內容（等同舊版串接後字串的長度）
+		[[nodiscard]] std::size_t size() const noexcept { return tag.size() + processed_data.size(); }
+		// 需要完整字串時才實際串接（例如輸出給使用者）
+		[[nodiscard]] std::string str() const { return std::string(tag) + processed_data; }
 	};
 
 	// 定義「最終處理結果」結構，作為 ProcessData 的成功結果
@@ -98,19 +149,148 @@ namespace config
 		int final_result_code;
 	};
 
+	// 管線使用的哨兵關鍵字編號（即 SentinelScanner 中的樣式索引）
+	enum Sentinel : std::size_t 
+	{
+		// "malformed"：LoadConfig 的解析錯誤
+		kMalformed    = 0,
+		// "invalid_field"：ValidateData 的驗證錯誤
+		kInvalidField = 1,
+	};
+
+	// 取得管線共用的哨兵掃描器（首次呼叫時建立，之後唯讀共用）
+	[[nodiscard]] const scanner::MultiPatternScanner& SentinelScanner();
+
 	/*=== 3. 宣告 LoadConfig & ValidateData & ProcessData & handle_pipeline_result ====*/
 
 	// 函式原型宣告：讀設定檔（成功 Config、失敗 PipelineError）
 	[[nodiscard]] std::expected<Config,        PipelineError> LoadConfig   (const std::string& filename);
 	// 函式原型宣告：驗證資料（成功 ValidatedData、失敗 PipelineError）
 	[[nodiscard]] std::expected<ValidatedData, PipelineError> ValidateData (const Config& config);
+	// 函式原型宣告：驗證資料（右值版本：直接接手 config.data 的緩衝區，不複製內容）
+	[[nodiscard]] std::expected<ValidatedData, PipelineError> ValidateData (Config&& config);
 	// 函式原型宣告：處理資料（成功 Result、失敗 PipelineError）
 	[[nodiscard]] std::expected<Result,        PipelineError> ProcessData  (const ValidatedData& data);
-// 結束命名空間
-}
+	// 函式原型宣告：處理資料（右值版本：處理完即釋放緩衝區，不留給呼叫端）
+	[[nodiscard]] std::expected<Result,        PipelineError> ProcessData  (ValidatedData&& data);
+	// 函式原型宣告：同上四個函式，錯誤只含該階段自身的成員
+	[[nodiscard]] std::expected<Config,        LoadError>     LoadConfig   (const std::string& filename, Exact);
+	[[nodiscard]] std::expected<ValidatedData, ValidateError> ValidateData (const Config& config, Exact);
+	[[nodiscard]] std::expected<ValidatedData, ValidateError> ValidateData (Config&& config, Exact);
+	[[nodiscard]] std::expected<Result,        ProcessError>  ProcessData  (const ValidatedData& data, Exact);
+	[[nodiscard]] std::expected<Result,        ProcessError>  ProcessData  (ValidatedData&& data, Exact);
+	// 函式原型宣告：單一欄位的驗證規則（ValidateData 對每個欄位套用；增量重載只對變更的欄位套用）
+	[[nodiscard]] std::expected<void,          PipelineError> ValidateField(const kv::Field& field);
+
+	/*==============================4. 記憶體映射讀檔模式================================*/
+
+	// 唯讀記憶體映射的 RAII 持有者：只能移動、不可複製，解構時自動 munmap
+	class MappedFile 
+	{
+	public:
+		// 預設為空映射（例如空檔案）
+		MappedFile() noexcept = default;
+		// 以唯讀方式映射整個檔案；開檔、fstat 或 mmap 失敗皆回傳 ConfigReadError
+		[[nodiscard]] static std::expected<MappedFile, PipelineError> Open(const std::string& filename);
+		// 依配置政策：要求明確大頁或節點放置時改為在呼叫端執行緒讀進匿名映射（同樣唯讀）
+		[[nodiscard]] static std::expected<MappedFile, PipelineError> Open(const std::string& filename, const memory::Policy& policy);
+
+		// 禁止複製：同一段映射只能有一個擁有者
+		MappedFile(const MappedFile&)            = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		// 允許移動：轉移映射所有權，來源變為空映射
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		// 解構：釋放映射
+		~MappedFile();
 
+		// 以字串檢視存取映射內容（生命週期與本物件相同）
+		[[nodiscard]] std::string_view view() const noexcept;
 
+	private:
+		// 僅供 Open 使用：接管一段已建立的映射（length 為 munmap 的長度，不小於 size）
+		MappedFile(void* address, std::size_t size, std::size_t length) noexcept;
+		// 釋放目前持有的映射
+		void Release() noexcept;
 
+		// 映射起始位址（空映射為 nullptr）
+		void*       address_ = nullptr;
+		// 內容長度（位元組）
+		std::size_t size_    = 0;
+		// 映射長度（匿名映射向上取整到頁或大頁）
+		std::size_t length_  = 0;
+	};
+
+	// 定義「映射設定」資料結構：零複製版本的 Config，data 直接指向映射記憶體
+	struct MappedConfig 
+	{
+		// 擁有映射的 RAII handle；移動 MappedConfig 不會改變映射位址，data 仍然有效
+		MappedFile       mapping;
+		// 指向映射內容的檢視
+		std::string_view data;
+		// 讀檔時的單次哨兵掃描結果
+		scanner::ScanResult scan{};
+		// 解析出的 key = value 欄位（字串池獨立於映射）
+		kv::Table fields{};
+	};
+
+	// 函式原型宣告：以 mmap 讀設定檔（成功 MappedConfig、失敗 PipelineError）
+	[[nodiscard]] std::expected<MappedConfig,  PipelineError> LoadConfigMapped(const std::string& filename);
+	// 函式原型宣告：同上，映射依配置政策建立
+	[[nodiscard]] std::expected<MappedConfig,  PipelineError> LoadConfigMapped(const std::string& filename, const memory::Policy& policy);
+	// 函式原型宣告：驗證映射資料（成功 ValidatedData、失敗 PipelineError）
+	[[nodiscard]] std::expected<ValidatedData, PipelineError> ValidateData    (const MappedConfig& config);
+
+	/*==============================5. 快取讀檔模式======================================*/
+
+	// 函式原型宣告：經由 cache 讀設定檔（cache 應以 SentinelScanner() 建立）；失敗一律為 ConfigReadError
+	[[nodiscard]] std::expected<Config,        PipelineError> LoadConfig      (filecache::FileCache& cache, const std::string& filename);
+	// 函式原型宣告：內容已由呼叫端讀入（例如非同步讀檔）時，只做掃描與解析檢查
+	[[nodiscard]] std::expected<Config,        PipelineError> LoadConfigFromBuffer(const std::string& filename, std::string content);
 
+	/*==============================6. 收集所有錯誤模式==================================*/
+
+	// 收集模式的錯誤清單：前 kInlineErrors 筆放在物件內部，不配置
+	inline constexpr std::size_t kInlineErrors = 4;
+	using ErrorList = util::SmallVector<PipelineError, kInlineErrors>;
+	// 函式原型宣告：讀設定檔但不在第一個錯誤停下：malformed 那一行與每個語法錯誤的欄位各附加一筆 ConfigParseError，
+	// 略過出錯的欄位後仍回傳 Config；只有讀檔失敗（沒有內容可檢查）時回傳 nullopt
+	[[nodiscard]] std::optional<Config>        LoadConfig          (const std::string& filename, ErrorList& errors);
+	// 函式原型宣告：同上，內容已由呼叫端讀入
+	[[nodiscard]] std::optional<Config>        LoadConfigFromBuffer(const std::string& filename, std::string content, ErrorList& errors);
+	// 函式原型宣告：檢查所有欄位，每個違規欄位附加一筆 ValidationError（依行號）；有任何一筆時回傳 nullopt
+	[[nodiscard]] std::optional<ValidatedData> ValidateData        (const Config& config, ErrorList& errors);
+	// 函式原型宣告：同上（右值版本：通過時直接接手 config.data 的緩衝區）
+	[[nodiscard]] std::optional<ValidatedData> ValidateData        (Config&& config, ErrorList& errors);
+	// 只收集該階段自身錯誤的清單：Pipeline 只組合部分階段時直接把每一筆放寬成它的 Error
+	using LoadErrorList     = util::SmallVector<LoadError, kInlineErrors>;
+	using ValidateErrorList = util::SmallVector<ValidateError, kInlineErrors>;
+	// 函式原型宣告：同上三個函式，收集到只含該階段錯誤的清單
+	[[nodiscard]] std::optional<Config>        LoadConfig          (const std::string& filename, LoadErrorList& errors);
+	[[nodiscard]] std::optional<ValidatedData> ValidateData        (const Config& config, ValidateErrorList& errors);
+	[[nodiscard]] std::optional<ValidatedData> ValidateData        (Config&& config, ValidateErrorList& errors);
+
+	/*==============================7. 緩衝區重用模式====================================*/
+
+	// 函式原型宣告：讀設定檔，內容緩衝區、掃描結果與欄位表都取自物件池（沿用容量，不配置）
+	[[nodiscard]] std::expected<Config,        PipelineError> LoadConfigPooled  (const std::string& filename);
+	// 函式原型宣告：驗證資料；內容緩衝區交給 ValidatedData，其餘部分（失敗時整個 config）歸還物件池
+	[[nodiscard]] std::expected<ValidatedData, PipelineError> ValidateDataPooled(Config&& config);
+	// 函式原型宣告：處理資料，完成後把緩衝區歸還物件池
+	[[nodiscard]] std::expected<Result,        PipelineError> ProcessDataPooled (ValidatedData&& data);
+	// 函式原型宣告：同上三個函式，錯誤只含該階段自身的成員
+	[[nodiscard]] std::expected<Config,        LoadError>     LoadConfigPooled  (const std::string& filename, Exact);
+	[[nodiscard]] std::expected<ValidatedData, ValidateError> ValidateDataPooled(Config&& config, Exact);
+	[[nodiscard]] std::expected<Result,        ProcessError>  ProcessDataPooled (ValidatedData&& data, Exact);
+	// 函式原型宣告：把不再使用的 Config / ValidatedData 歸還物件池
+	void Recycle(Config&& config);
+	void Recycle(ValidatedData&& data);
+
+	/*==============================8. 配置政策模式======================================*/
+
+	// 函式原型宣告：讀設定檔，內容緩衝區依配置政策在呼叫端執行緒新配置（大頁、NUMA 放置）；檢查與 LoadConfig 相同
+	[[nodiscard]] std::expected<Config,        PipelineError> LoadConfig        (const std::string& filename, const memory::Policy& policy);
+// 結束命名空間
+}
 
 #endif
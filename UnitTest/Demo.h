@@ -0,0 +1,312 @@
+// Demo.h
+// Advanced.cpp 的“被測”對象：錯誤類型、Visitor helper 與 demo 管線（Read → Parse）
+// 獨立成標頭，讓 GoogleTest 與 Benchmark 共用同一份實作
+#ifndef DEMO_H
+#define DEMO_H
+
+#include <cerrno>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include <fcntl.h>          // open
+#include <sys/resource.h>   // getrlimit：EMFILE 時回報開檔上限
+#include <sys/stat.h>       // fstat
+#include <unistd.h>         // read / close
+
+#include "ByteTransform.h"   // SIMD 位元組轉換（解析時的 c - 1）
+#include "FileCache.h"   // (路徑, mtime, 大小) 內容快取
+#include "MemoryPolicy.h"   // 大型內容的大頁與 NUMA 配置政策
+#include "Scanner.h"   // 單次多樣式掃描（TRIGGER_IO_ERROR / MALFORMED）
+
+// 1. 定義 錯誤類型 & 錯誤回傳內容
+
+struct FileNotFoundError   { std::string path; };
+struct PermissionError     { std::string path; };
+struct IOError             { std::string path; std::string op; };
+struct BadFormatError      { std::string reason; int line; };
+struct MemoryError         { std::string reason; };
+struct TooManyOpenFiles    { int limit; };
+
+
+// 2. 串接 錯誤類型
+using Error = std::variant<
+  FileNotFoundError, PermissionError, IOError,
+  BadFormatError, MemoryError, TooManyOpenFiles
+>;
+
+// 建立 Visitor helper
+template<class... Ts>
+struct Overloaded : Ts... { using Ts::operator()...; };
+template<class... Ts>
+Overloaded(Ts...) -> Overloaded<Ts...>;
+
+
+// 3. 建立“被測”對象
+namespace demo
+{
+    // 縮寫
+    namespace fs = std::filesystem;
+
+    // 哨兵關鍵字編號（即 Sentinels() 中的樣式索引）
+    enum Sentinel : std::size_t { kTriggerIOError = 0, kMalformed = 1 };
+
+    // ReadAll 與 ParseConfig 共用的掃描器：兩個階段的哨兵一次掃完
+    [[nodiscard]] inline const scanner::MultiPatternScanner& Sentinels()
+    {
+        static const scanner::MultiPatternScanner instance({"TRIGGER_IO_ERROR", "MALFORMED"});
+        return instance;
+    }
+
+    // 讀檔結果 + 讀檔當下的單次掃描結果，交給 ParseConfig 直接取用
+    struct ScannedContent
+    {
+        std::string         content;
+        scanner::ScanResult scan;
+    };
+
+    // 開檔失敗的 errno → 錯誤類型（EMFILE / ENFILE 回報目前的開檔上限）
+    [[nodiscard]] inline Error OpenErrorFrom(int error, const fs::path& p)
+    {
+        switch (error)
+        {
+        case ENOENT:
+        case ENOTDIR:
+            return FileNotFoundError{p.string()};
+        case EACCES:
+        case EPERM:
+            return PermissionError{p.string()};
+        case EMFILE:
+        case ENFILE:
+        {
+            ::rlimit limit{};
+            ::getrlimit(RLIMIT_NOFILE, &limit);
+            return TooManyOpenFiles{static_cast<int>(limit.rlim_cur)};
+        }
+        default:
+            return IOError{p.string(), "open"};
+        }
+    }
+
+    // 開檔後自動關閉的 fd
+    struct FileDescriptor
+    {
+        int fd = -1;
+        ~FileDescriptor() { if (fd >= 0) ::close(fd); }
+    };
+
+    // 讀滿 size 個位元組或讀到 EOF（處理短讀與 EINTR）；got 為實際讀到的位元組數，read 失敗時回傳 false
+    [[nodiscard]] inline bool ReadFull(int fd, char* out, std::size_t size, std::size_t& got)
+    {
+        got = 0;
+        while (got < size)
+        {
+            const ::ssize_t n = ::read(fd, out + got, size - got);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n < 0)
+                return false;
+            if (n == 0)
+                break;
+            got += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    // 功能: 讀取所有檔案，並在讀入後對所有哨兵做一次掃描
+    // 只做一次 open（不先 exists，避免 TOCTOU 與多一次 stat），錯誤由 errno 判斷；
+    // fstat 一次預先配置緩衝，一次 read 讀完
+    // 若檔名含 "PERM_DENIED" 則 PermissionError（模擬）；
+    // 若檔案內容含 "TRIGGER_IO_ERROR" → IOError（模擬）
+    // policy：大型內容的緩衝區先套用配置政策（大頁、綁定節點），再第一次寫入
+    [[nodiscard]] inline std::expected<ScannedContent, Error> ReadAllScanned(const fs::path& p, const memory::Policy& policy = {})
+    {
+        // 嘗試開檔：不存在、權限不足、開檔數用盡都從 errno 得知
+        const FileDescriptor file{::open(p.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (file.fd < 0)
+            return std::unexpected(OpenErrorFrom(errno, p));
+
+        // 檔名帶有 PERM_DENIED → 模擬權限被拒
+        if (p.filename().string().find("PERM_DENIED") != std::string::npos)
+            return std::unexpected(PermissionError{p.string()});
+
+        // 依檔案大小一次配置；非一般檔案（例如目錄）視為讀取錯誤
+        struct stat st{};
+        if (::fstat(file.fd, &st) != 0 || !S_ISREG(st.st_mode))
+            return std::unexpected(IOError{p.string(), "read"});
+
+        // 讀取內容：依 fstat 的大小一次 read（短讀時才接續）；內容為 fstat 當下的大小
+        const auto size = static_cast<std::size_t>(st.st_size);
+        std::string content;
+        if (policy.applies(size))
+        {
+            content.reserve(size);
+            memory::Prepare(content.data(), size, policy);
+        }
+        content.resize(size);
+        std::size_t got = 0;
+        if (!ReadFull(file.fd, content.data(), content.size(), got))
+            return std::unexpected(IOError{p.string(), "read"});
+        content.resize(got);
+
+        // 單次掃描：同時找出 TRIGGER_IO_ERROR 與 MALFORMED
+        auto scan = Sentinels().Scan(content);
+
+        // 內容含 TRIGGER_IO_ERROR → 模擬讀取錯誤
+        if (scan.Contains(kTriggerIOError))
+            return std::unexpected(IOError{p.string(), "read (simulated)"});
+
+        return ScannedContent{std::move(content), std::move(scan)};
+    }
+
+    // 功能: 讀取所有檔案（只需要內容的呼叫端）
+    [[nodiscard]] inline std::expected<std::string, Error> ReadAll(const fs::path& p, const memory::Policy& policy = {})
+    {
+        return ReadAllScanned(p, policy).transform([](ScannedContent&& s) { return std::move(s.content); });
+    }
+
+    // 功能: 解析檔案（沿用讀檔時的掃描結果，不再重掃）
+    // 內容含 "MALFORMED" → BadFormatError
+    // 若字數超過 1024 → MemoryError（模擬 out-of-memory）
+    [[nodiscard]] inline std::expected<std::string, Error> ParseConfig(ScannedContent scanned)
+    {
+        // 行號取自讀檔時同一趟掃描建立的換行索引
+        if (const auto at = scanned.scan.First(kMalformed))
+            return std::unexpected(BadFormatError{"MALFORMED token",
+                                                  scanned.scan.Locate(scanned.content, *at).line_number});
+
+        std::string& content = scanned.content;
+        if (content.size() > 1024)
+            return std::unexpected(MemoryError{"simulated out-of-memory"});
+
+        // 模擬解析（做一點點轉換：非零位元組減一，以 SIMD 就地處理）
+        bytes::DecrementNonZero(content);
+
+        return std::move(content);
+    }
+
+    // 功能: 解析檔案（未經掃描的內容：在此補掃一次）
+    [[nodiscard]] inline std::expected<std::string, Error> ParseConfig(std::string content)
+    {
+        auto scan = Sentinels().Scan(content);
+        return ParseConfig(ScannedContent{std::move(content), std::move(scan)});
+    }
+
+    // 模擬「同時開太多檔案」（ReadAll 遇到真正的 EMFILE 時同樣回報 TooManyOpenFiles）
+    [[nodiscard]] inline std::expected<void, Error> SimulateOpenMany(int count, int limit = 1024)
+    {
+        if (count >= limit)
+            return std::unexpected(TooManyOpenFiles{limit});
+        return {};
+    }
+
+    // 建立 Pipeline：Read → Parse
+    [[nodiscard]] inline std::expected<std::string, Error> LoadAndParse(const fs::path& p)
+    {
+        return ReadAllScanned(p).and_then([](ScannedContent&& s) { return ParseConfig(std::move(s)); });
+    }
+
+    // 功能: 經由快取讀檔（cache 應以 Sentinels() 建立），回傳共享唯讀內容
+    // 錯誤語意與 ReadAllScanned 相同；未變更的檔案只做一次 stat，不存在的檔案在 TTL 內不再 stat
+    [[nodiscard]] inline std::expected<filecache::EntryPtr, Error> ReadAllCached(filecache::FileCache& cache, const fs::path& p)
+    {
+        auto entry = cache.Get(p.string());
+        if (!entry)
+        {
+            switch (entry.error())
+            {
+            case filecache::Failure::kNotFound:         return std::unexpected(FileNotFoundError{p.string()});
+            case filecache::Failure::kPermissionDenied: return std::unexpected(PermissionError{p.string()});
+            case filecache::Failure::kTooManyOpenFiles: return std::unexpected(OpenErrorFrom(EMFILE, p));
+            case filecache::Failure::kOpenFailed:       return std::unexpected(IOError{p.string(), "open"});
+            default:                                    return std::unexpected(IOError{p.string(), "read"});
+            }
+        }
+
+        // 檔名帶有 PERM_DENIED → 模擬權限被拒
+        if (p.filename().string().find("PERM_DENIED") != std::string::npos)
+            return std::unexpected(PermissionError{p.string()});
+
+        // 內容含 TRIGGER_IO_ERROR → 模擬讀取錯誤（沿用快取中的掃描結果）
+        if ((*entry)->scan.Contains(kTriggerIOError))
+            return std::unexpected(IOError{p.string(), "read (simulated)"});
+
+        return std::move(*entry);
+    }
+
+    // 建立 Pipeline：Read（快取）→ Parse；解析會改寫內容，因此複製一份快取內容
+    [[nodiscard]] inline std::expected<std::string, Error> LoadAndParse(filecache::FileCache& cache, const fs::path& p)
+    {
+        return ReadAllCached(cache, p).and_then([](const filecache::EntryPtr& e) {
+            return ParseConfig(ScannedContent{e->data, e->scan});
+        });
+    }
+
+    // 串流模式的參數
+    struct StreamOptions
+    {
+        // 每次讀入的區塊大小（位元組）
+        std::size_t chunk_size    = 64 * 1024;
+        // 記憶體上限：區塊緩衝不得超過此值
+        std::size_t memory_budget = 1 << 20;
+    };
+
+    // 功能: 以固定大小的區塊串流 Read → Parse，記憶體用量與檔案大小無關
+    // 錯誤語意與 LoadAndParse 相同，差別在於：
+    //   - 依串流順序 fail-fast：先遇到的哨兵先回報（切在區塊邊界上的哨兵仍會被偵測）
+    //   - 不套用 1024 字的 MemoryError；改為 chunk_size 超過 memory_budget 時回報 MemoryError
+    //   - 錯誤發生前已轉換的區塊已交給 sink，呼叫端需自行捨棄部分輸出
+    // sink 以 std::string_view 接收每個轉換後的區塊（只在呼叫期間有效）；成功時回傳總位元組數
+    template<typename Sink>
+    [[nodiscard]] std::expected<std::size_t, Error> StreamLoadAndParse(const fs::path& p, Sink&& sink,
+                                                                       const StreamOptions& options = {})
+    {
+        // 嘗試開檔：與 ReadAllScanned 相同，只做一次 open，錯誤由 errno 判斷
+        const FileDescriptor file{::open(p.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (file.fd < 0)
+            return std::unexpected(OpenErrorFrom(errno, p));
+
+        // 檔名帶有 PERM_DENIED → 模擬權限被拒
+        if (p.filename().string().find("PERM_DENIED") != std::string::npos)
+            return std::unexpected(PermissionError{p.string()});
+
+        // 區塊緩衝必須放得進記憶體上限
+        if (options.chunk_size == 0 || options.chunk_size > options.memory_budget)
+            return std::unexpected(MemoryError{"chunk size exceeds memory budget"});
+
+        // 單一緩衝重複使用：整趟只配置一次
+        std::string buffer(options.chunk_size, '\0');
+        scanner::StreamState stream;
+
+        for (;;)
+        {
+            std::size_t got = 0;
+            if (!ReadFull(file.fd, buffer.data(), buffer.size(), got))
+                return std::unexpected(IOError{p.string(), "read"});
+            if (got == 0)
+                break;
+
+            const std::string_view chunk(buffer.data(), got);
+            const auto scan = Sentinels().Feed(stream, chunk);
+
+            // 同一區塊內兩種哨兵都出現時，以位置較前者為準（與串流順序一致）
+            const auto io  = scan.First(kTriggerIOError);
+            const auto bad = scan.First(kMalformed);
+            if (io && (!bad || *io <= *bad))
+                return std::unexpected(IOError{p.string(), "read (simulated)"});
+            if (bad)
+                return std::unexpected(BadFormatError{"MALFORMED token", stream.LineOf(scan, *bad)});
+
+            // 模擬解析（與 ParseConfig 相同的轉換），就地改寫後交給 sink
+            bytes::DecrementNonZero(std::span<char>(buffer.data(), got));
+            sink(std::string_view(buffer.data(), got));
+        }
+
+        return stream.offset;
+    }
+}
+
+#endif
@@ -0,0 +1,144 @@
+// Include Guard：避免重複包含
+#ifndef ERROR_CONTEXT_H
+// 與上方成對
+#define ERROR_CONTEXT_H
+
+// 錯誤 variant 之間的轉換、Dispatch
+#include "VariantMerge.h"
+// 固定容量的堆疊
+#include <array>
+// std::size_t
+#include <cstddef>
+// 固定寬度整數
+#include <cstdint>
+// std::remove_cvref_t / std::is_trivially_copyable_v
+#include <type_traits>
+// std::forward
+#include <utility>
+
+/*
+錯誤的來源脈絡：固定容量、不配置的 context 堆疊
+- 每一層（frame）只記「階段編號 + 檔案編號 + 位元組位移」12 個位元組，不組任何字串
+- ContextStack<N> 內嵌在錯誤裡（std::array），最多 N 層；超過時保留最內層（最早推入）的 N 層，其餘只計數
+- Traced<E, N>：錯誤本體 + 堆疊；錯誤跨過一層管線時再推一層即可得到完整的來源路徑
+- 位移取自錯誤本身的 offset 成員（例如 ErrorDescriptor、kv::SyntaxError）；沒有時為 0
+*/
+
+// 開始命名空間
+namespace config
+{
+	// 預設的堆疊容量
+	inline constexpr std::size_t kDefaultContextDepth = 4;
+
+	// 一層來源脈絡
+	struct ContextFrame
+	{
+		// 檔案編號（由呼叫端指定，例如批次中的索引）
+		std::uint32_t file   = 0;
+		// 錯誤在原文中的位元組位移
+		std::uint32_t offset = 0;
+		// 產生錯誤的階段在管線中的位置（以 0 起算）
+		std::uint16_t stage  = 0;
+
+		friend constexpr bool operator==(const ContextFrame&, const ContextFrame&) = default;
+	};
+
+	static_assert(std::is_trivially_copyable_v<ContextFrame>);
+	static_assert(sizeof(ContextFrame) <= 12);
+
+	// 固定容量的 context 堆疊：索引 0 為最內層（最早推入）
+	template<std::size_t N>
+	class ContextStack
+	{
+		static_assert(N > 0 && N <= 255, "ContextStack capacity must fit in one byte");
+
+	public:
+		// 推入一層；已滿時丟棄並計數
+		constexpr void Push(const ContextFrame& frame) noexcept
+		{
+			if (size_ < N)
+				frames_[size_++] = frame;
+			else
+				++dropped_;
+		}
+
+		// 接上另一個（容量可不同的）堆疊：依序推入，丟棄數累加
+		template<std::size_t M>
+		constexpr void Append(const ContextStack<M>& other) noexcept
+		{
+			for (const ContextFrame& frame : other)
+				Push(frame);
+			dropped_ += other.dropped();
+		}
+
+		[[nodiscard]] static constexpr std::size_t capacity() noexcept { return N; }
+		[[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+		// 因容量不足而丟棄的層數
+		[[nodiscard]] constexpr std::uint32_t dropped() const noexcept { return dropped_; }
+
+		[[nodiscard]] constexpr const ContextFrame& operator[](std::size_t i) const noexcept { return frames_[i]; }
+		[[nodiscard]] constexpr const ContextFrame* begin() const noexcept { return frames_.data(); }
+		[[nodiscard]] constexpr const ContextFrame* end() const noexcept { return frames_.data() + size_; }
+
+	private:
+		std::array<ContextFrame, N> frames_{};
+		std::uint8_t                size_    = 0;
+		std::uint32_t               dropped_ = 0;
+	};
+
+	// 帶有來源脈絡的錯誤
+	template<typename E, std::size_t N = kDefaultContextDepth>
+	struct Traced
+	{
+		using error_type = E;
+
+		// 錯誤本體
+		E               error;
+		// 來源脈絡
+		ContextStack<N> context{};
+	};
+
+	// 是否為 Traced
+	template<typename T>
+	inline constexpr bool kIsTraced = false;
+	template<typename E, std::size_t N>
+	inline constexpr bool kIsTraced<Traced<E, N>> = true;
+
+	// 錯誤在原文中的位移：有 offset 成員時取用，variant 取目前的成員，否則為 0
+	template<typename E>
+	[[nodiscard]] constexpr std::uint32_t OffsetOf(const E& error) noexcept
+	{
+		if constexpr (meta::kIsVariant<E>)
+			return meta::Dispatch(error, [](const auto& alternative) { return OffsetOf(alternative); });
+		else if constexpr (requires { error.offset; })
+			return static_cast<std::uint32_t>(error.offset);
+		else
+			return 0;
+	}
+
+	// 附加一層脈絡並把錯誤本體放進 To（編譯期檢查 To 涵蓋所有成員）；error 已是 Traced 時沿用它的堆疊
+	template<typename To, std::size_t N, typename E>
+	[[nodiscard]] constexpr Traced<To, N> AddContext(E&& error, std::uint16_t stage, std::uint32_t file)
+	{
+		using Source = std::remove_cvref_t<E>;
+		if constexpr (kIsTraced<Source>)
+		{
+			const ContextFrame frame{file, OffsetOf(error.error), stage};
+			Traced<To, N> traced{meta::Widen<To>(std::forward<E>(error).error)};
+			traced.context.Append(error.context);
+			traced.context.Push(frame);
+			return traced;
+		}
+		else
+		{
+			const ContextFrame frame{file, OffsetOf(error), stage};
+			Traced<To, N> traced{meta::Widen<To>(std::forward<E>(error))};
+			traced.context.Push(frame);
+			return traced;
+		}
+	}
+// 結束命名空間
+}
+
+#endif
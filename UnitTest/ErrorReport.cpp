@@ -0,0 +1,189 @@
+// 引入對應的宣告標頭
+#include "ErrorReport.h"
+// ViewOf / ToString(ErrorKind) / KindOf
+#include "ErrorFormat.h"
+// std::sort / std::max
+#include <algorithm>
+// std::bit_ceil
+#include <bit>
+
+// 進入命名空間
+namespace report
+{
+	// 僅供本檔使用
+	namespace
+	{
+		// FNV-1a 的常數
+		constexpr std::uint64_t kFnvOffset = 14695981039346656037ull;
+		constexpr std::uint64_t kFnvPrime  = 1099511628211ull;
+
+		// 把一段位元組混入雜湊
+		void Mix(std::uint64_t& hash, std::string_view bytes) noexcept
+		{
+			for (const char c : bytes)
+			{
+				hash ^= static_cast<unsigned char>(c);
+				hash *= kFnvPrime;
+			}
+		}
+
+		// 窗口長度：一秒以上以秒表示，否則以毫秒表示
+		void WriteWindow(std::ostream& out, std::chrono::nanoseconds window)
+		{
+			const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(window).count();
+			if (seconds >= 1)
+				out << seconds << 's';
+			else
+				out << std::chrono::duration_cast<std::chrono::milliseconds>(window).count() << "ms";
+		}
+	}
+
+	// 欄位之間以 0xff 分隔（UTF-8 文字中不會出現），避免 "ab" + "c" 與 "a" + "bc" 相同
+	std::uint64_t HashOf(const config::PipelineError& error) noexcept
+	{
+		const config::ErrorView view = config::ViewOf(error);
+		std::uint64_t hash = kFnvOffset;
+		const char kind = static_cast<char>(view.kind);
+		const char separator = static_cast<char>(0xff);
+		Mix(hash, {&kind, 1});
+		Mix(hash, view.subject);
+		Mix(hash, {&separator, 1});
+		Mix(hash, view.detail);
+		Mix(hash, {reinterpret_cast<const char*>(&view.line), sizeof(view.line)});
+		return hash == 0 ? 1 : hash;
+	}
+
+	// 解析錯誤以行號區分（整行內容可能很長），其他取主要欄位
+	std::string LabelOf(const config::PipelineError& error)
+	{
+		const config::ErrorView view = config::ViewOf(error);
+		std::string label(config::ToString(view.kind));
+		label += '{';
+		if (view.kind == config::ErrorKind::kConfigParse)
+			label.append("line ").append(std::to_string(view.line));
+		else
+			label.append(view.subject);
+		label += '}';
+		return label;
+	}
+
+	// 所有行、合併的與無法歸類的
+	std::uint64_t Summary::total() const noexcept
+	{
+		std::uint64_t sum = other_events + dropped;
+		for (const SummaryLine& line : lines)
+			sum += line.count;
+		return sum;
+	}
+
+	// 槽位數取 2 的冪次，探測以遮罩取代取餘
+	ErrorReporter::ErrorReporter(std::size_t capacity, std::size_t max_lines, Clock::time_point start)
+		: slots_(std::make_unique<Slot[]>(std::bit_ceil(std::max<std::size_t>(capacity, 1)))),
+		  mask_(std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1),
+		  max_lines_(max_lines),
+		  window_start_(start)
+	{
+	}
+
+	// 線性探測：同雜湊的槽位只加計數；空槽位以 CAS 宣告，宣告者保存樣本
+	void ErrorReporter::Report(const config::PipelineError& error)
+	{
+		const std::uint64_t hash = HashOf(error);
+		std::size_t index = hash & mask_;
+		for (std::size_t probe = 0; probe <= mask_; ++probe, index = (index + 1) & mask_)
+		{
+			Slot& slot = slots_[index];
+			std::uint64_t current = slot.hash.load(std::memory_order_acquire);
+			if (current == 0)
+			{
+				if (slot.hash.compare_exchange_strong(current, hash, std::memory_order_acq_rel, std::memory_order_acquire))
+				{
+					slot.sample.emplace(error);
+					slot.ready.store(true, std::memory_order_release);
+					slot.count.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				// 被其他執行緒搶先：current 已是對方的雜湊，下面照常比對
+			}
+			if (current == hash)
+			{
+				slot.count.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+		}
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// 樣本尚未寫好的槽位這次略過，它的計數留到下一個窗口
+	Summary ErrorReporter::TakeSummary(Clock::time_point now)
+	{
+		const std::lock_guard lock(summary_mutex_);
+		Summary summary;
+		summary.window = std::chrono::duration_cast<std::chrono::nanoseconds>(now - window_start_);
+		window_start_  = now;
+
+		for (std::size_t i = 0; i <= mask_; ++i)
+		{
+			Slot& slot = slots_[i];
+			if (!slot.ready.load(std::memory_order_acquire))
+				continue;
+			if (const std::uint64_t count = slot.count.exchange(0, std::memory_order_relaxed); count != 0)
+				summary.lines.push_back({*slot.sample, count});
+		}
+
+		std::sort(summary.lines.begin(), summary.lines.end(),
+		          [](const SummaryLine& a, const SummaryLine& b) { return a.count > b.count; });
+		if (summary.lines.size() > max_lines_)
+		{
+			const auto first_hidden = summary.lines.begin() + static_cast<std::ptrdiff_t>(max_lines_);
+			for (auto it = first_hidden; it != summary.lines.end(); ++it)
+			{
+				++summary.other_kinds;
+				summary.other_events += it->count;
+			}
+			summary.lines.erase(first_hidden, summary.lines.end());
+		}
+		summary.dropped = dropped_.exchange(0, std::memory_order_relaxed);
+		return summary;
+	}
+
+	// 呼叫端保證此時沒有 Report
+	void ErrorReporter::Reset(Clock::time_point now)
+	{
+		const std::lock_guard lock(summary_mutex_);
+		for (std::size_t i = 0; i <= mask_; ++i)
+		{
+			Slot& slot = slots_[i];
+			slot.hash.store(0, std::memory_order_relaxed);
+			slot.ready.store(false, std::memory_order_relaxed);
+			slot.sample.reset();
+			slot.count.store(0, std::memory_order_relaxed);
+		}
+		dropped_.store(0, std::memory_order_relaxed);
+		window_start_ = now;
+	}
+
+	// 每種錯誤一行
+	void WriteSummary(std::ostream& out, const Summary& summary)
+	{
+		for (const SummaryLine& line : summary.lines)
+		{
+			out << LabelOf(line.sample) << " x " << line.count << " in last ";
+			WriteWindow(out, summary.window);
+			out << '\n';
+		}
+		if (summary.other_kinds != 0)
+		{
+			out << "(" << summary.other_kinds << " more kinds) x " << summary.other_events << " in last ";
+			WriteWindow(out, summary.window);
+			out << '\n';
+		}
+		if (summary.dropped != 0)
+		{
+			out << "(untracked) x " << summary.dropped << " in last ";
+			WriteWindow(out, summary.window);
+			out << '\n';
+		}
+	}
+// 結束命名空間
+}
@@ -0,0 +1,122 @@
+// Include Guard：避免重複包含
+#ifndef ERROR_REPORT_H
+// 與上方成對
+#define ERROR_REPORT_H
+
+// PipelineError
+#include "Config.h"
+// 計數器
+#include <atomic>
+// 時間窗口
+#include <chrono>
+// std::size_t
+#include <cstddef>
+// 固定寬度整數（雜湊、計數）
+#include <cstdint>
+// 槽位陣列
+#include <memory>
+// 彙整端互斥
+#include <mutex>
+// 只在第一次出現時保存的樣本
+#include <optional>
+// 輸出目標
+#include <ostream>
+// 標籤
+#include <string>
+// 彙整結果
+#include <vector>
+
+/*
+錯誤取樣與限速回報：錯誤風暴時不再每次失敗寫一行 std::cerr
+- Report(error)：以錯誤內容的 64 位元雜湊找到對應槽位（開放定址、無鎖），之後同樣的錯誤只做一次原子加法；
+  只有某個錯誤第一次出現時才複製一份樣本
+- TakeSummary()：取出並歸零每個槽位本窗口的計數，依次數排序，只保留前 max_lines 種，其餘合併為一行
+- WriteSummary()：例如 "ValidationError{invalid_field} x 48213 in last 10s"
+- 槽位滿了之後的新錯誤只計數（tracked 之外的 dropped），不阻塞、不配置
+- 雜湊相同的不同錯誤會併在同一行（64 位元雜湊，實務上可忽略）
+- Report 可在任何執行緒呼叫；TakeSummary / Reset 由單一彙整端呼叫（例如每 10 秒一次的背景執行緒）
+*/
+
+// 開始命名空間
+namespace report
+{
+	// 錯誤內容的雜湊（FNV-1a：種類、主要欄位、細節、行號）；0 保留給空槽位，不會回傳
+	[[nodiscard]] std::uint64_t HashOf(const config::PipelineError& error) noexcept;
+	// 彙整標籤：錯誤種類 + 最能區分的欄位，例如 "ValidationError{invalid_field}"、"ConfigParseError{line 3}"
+	[[nodiscard]] std::string LabelOf(const config::PipelineError& error);
+
+	// 彙整結果的一行
+	struct SummaryLine
+	{
+		// 這種錯誤的樣本（第一次出現時保存）
+		config::PipelineError sample;
+		// 本窗口內的次數
+		std::uint64_t         count = 0;
+	};
+
+	// 一個窗口的彙整
+	struct Summary
+	{
+		// 次數最多的前 max_lines 種，依次數遞減
+		std::vector<SummaryLine>  lines;
+		// 被合併掉的種類數與次數
+		std::size_t               other_kinds  = 0;
+		std::uint64_t             other_events = 0;
+		// 槽位已滿、無法歸類的錯誤數
+		std::uint64_t             dropped      = 0;
+		// 窗口長度（與上一次彙整的間隔）
+		std::chrono::nanoseconds  window{0};
+
+		// 本窗口的錯誤總數
+		[[nodiscard]] std::uint64_t total() const noexcept;
+	};
+
+	// 依錯誤內容去重、計數的回報器
+	class ErrorReporter
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// capacity：可區分的錯誤種類上限（取 2 的冪次）；max_lines：每次彙整輸出的行數上限
+		explicit ErrorReporter(std::size_t capacity = 1024, std::size_t max_lines = 8, Clock::time_point start = Clock::now());
+
+		// 不可複製：槽位屬於這個回報器
+		ErrorReporter(const ErrorReporter&)            = delete;
+		ErrorReporter& operator=(const ErrorReporter&) = delete;
+
+		// 記錄一次錯誤；重複的錯誤只做一次原子加法
+		void Report(const config::PipelineError& error);
+
+		// 取出本窗口的彙整並開始新窗口
+		[[nodiscard]] Summary TakeSummary(Clock::time_point now = Clock::now());
+		// 清除所有槽位（不可與 Report 同時呼叫）
+		void Reset(Clock::time_point now = Clock::now());
+
+		// 可區分的錯誤種類上限
+		[[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+	private:
+		// 一種錯誤：雜湊宣告槽位，樣本寫好後才設定 ready；計數與樣本分屬不同快取線
+		struct alignas(64) Slot
+		{
+			std::atomic<std::uint64_t>           hash{0};
+			std::atomic<bool>                    ready{false};
+			std::optional<config::PipelineError> sample;
+			alignas(64) std::atomic<std::uint64_t> count{0};
+		};
+
+		std::unique_ptr<Slot[]>    slots_;
+		std::size_t                mask_      = 0;
+		std::size_t                max_lines_ = 0;
+		std::atomic<std::uint64_t> dropped_{0};
+		// 彙整端狀態
+		std::mutex                 summary_mutex_;
+		Clock::time_point          window_start_;
+	};
+
+	// 寫出彙整：每種錯誤一行，其後是合併的種類與無法歸類的錯誤
+	void WriteSummary(std::ostream& out, const Summary& summary);
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,138 @@
+// Include Guard：避免重複包含
+#ifndef FAULT_INJECTION_H
+// 與上方成對
+#define FAULT_INJECTION_H
+
+// ErrorKind（錯誤種類與名稱）、PipelineError
+#include "ErrorCode.h"
+// metrics::Stage（管線階段與名稱）
+#include "Metrics.h"
+// Pipeline 與標準階段（FaultyConfigPipeline）
+#include "Pipeline.h"
+// 機率表
+#include <array>
+// std::expected
+#include <expected>
+// std::optional（擲骰結果）
+#include <optional>
+// 規格文字
+#include <string_view>
+// std::is_same_v
+#include <type_traits>
+// std::forward
+#include <utility>
+
+/*
+故障注入（可在編譯期移除）：不靠檔名或內容中的哨兵字串，由外部設定在指定階段產生指定錯誤
+- Plan：每個階段 × 每種錯誤（ErrorKind）一個機率；同一階段各種錯誤的機率相加不得超過 1
+- 設定方式：程式呼叫 Configure(plan)，或環境變數 CONFIG_FAULT_PLAN（例如 "LoadConfig.ConfigReadError=0.01,ValidateData.ValidationError=0.05"）
+- Inject(stage, fn)：先擲骰，命中時直接回傳注入的錯誤、不呼叫 fn；否則呼叫 fn（與 metrics::Instrument 可任意巢狀）
+- 擲骰只用目前執行緒的 xorshift 亂數與 relaxed 原子讀取，不加鎖；機率全為 0 的階段只多一次載入
+- CONFIG_FAULTS 為 0（預設）時 Inject 直接回傳原本的函式，不加任何程式碼；Plan / Roll 仍可直接使用（測試用）
+- 注入的錯誤內容固定為 kInjectedDetail，可與真正的錯誤區分
+- FaultyConfigPipeline：三個標準階段各自包上 Faulty，負載產生器（LoadGenerator.h）以它量測錯誤比例對延遲的影響
+*/
+
+// 預設關閉；以 -DCONFIG_FAULTS=1 開啟
+#ifndef CONFIG_FAULTS
+#define CONFIG_FAULTS 0
+#endif
+
+// 開始命名空間
+namespace fault
+{
+	// 沿用量測層的階段定義
+	using metrics::Stage;
+	using metrics::kStageCount;
+
+	// 錯誤種類數（ErrorKind 即 PipelineError 的 variant 索引）
+	inline constexpr std::size_t kKindCount = std::variant_size_v<config::PipelineError>;
+	// 注入錯誤的說明文字
+	inline constexpr std::string_view kInjectedDetail = "injected fault";
+	// 讀取設定的環境變數
+	inline constexpr const char* kPlanVariable = "CONFIG_FAULT_PLAN";
+
+	// 一組注入機率
+	struct Plan
+	{
+		std::array<std::array<double, kKindCount>, kStageCount> probability{};
+
+		// 設定某階段產生某種錯誤的機率（0 ~ 1）
+		Plan& Set(Stage stage, config::ErrorKind kind, double p) noexcept
+		{
+			probability[static_cast<std::size_t>(stage)][static_cast<std::size_t>(kind)] = p;
+			return *this;
+		}
+		// 某階段注入任何錯誤的機率
+		[[nodiscard]] double Total(Stage stage) const noexcept;
+	};
+
+	// 規格文字的錯誤：位置與原因（原因為靜態字面值）
+	struct PlanError
+	{
+		std::size_t      offset = 0;
+		std::string_view reason;
+	};
+
+	// 解析 "Stage.Kind=機率" 以 ',' 分隔的規格；空字串為全 0 的 Plan
+	[[nodiscard]] std::expected<Plan, PlanError> ParsePlan(std::string_view spec);
+
+	// 套用 plan（所有執行緒立即生效；與擲骰同時進行時，該次擲骰可能看到新舊機率混合）
+	void Configure(const Plan& plan) noexcept;
+	// 停止注入
+	void Clear() noexcept;
+	// 解析並套用 CONFIG_FAULT_PLAN；未設定時回傳空的 Plan 且不改變目前設定
+	[[nodiscard]] std::expected<Plan, PlanError> ConfigureFromEnvironment();
+
+	// 擲骰：命中時回傳該階段要注入的錯誤種類
+	[[nodiscard]] std::optional<config::ErrorKind> Roll(Stage stage) noexcept;
+	// 依種類建立注入的錯誤（檔名、行內容、不合法值或細節為 kInjectedDetail）
+	[[nodiscard]] config::PipelineError MakeError(config::ErrorKind kind);
+
+	// 包裝一個回傳 std::expected<T, PipelineError> 的階段：命中時以注入的錯誤取代呼叫
+	// CONFIG_FAULTS 為 0 時直接回傳原函式，呼叫端不需任何 #if
+	template<typename Fn>
+	[[nodiscard]] constexpr auto Inject([[maybe_unused]] Stage stage, Fn&& fn)
+	{
+#if CONFIG_FAULTS
+		return [stage, fn = std::forward<Fn>(fn)](auto&&... args) -> decltype(fn(std::forward<decltype(args)>(args)...))
+		{
+			if (const auto kind = Roll(stage))
+				return std::unexpected(MakeError(*kind));
+			return fn(std::forward<decltype(args)>(args)...);
+		};
+#else
+		return std::forward<Fn>(fn);
+#endif
+	}
+
+	// Pipeline 階段的包裝：Faulty<Stage::kLoadConfig, config::LoadStage>
+	// 任何階段都可能被注入任何種類，因此錯誤清單為 PipelineError 的全部成員
+	template<Stage S, typename Inner>
+	struct Faulty : Inner
+	{
+		using Errors = meta::Union<config::LoadErrors, config::ValidateErrors, config::ProcessErrors>;
+
+		template<typename In>
+		[[nodiscard]] auto operator()(In&& input) const
+		{
+			using Output = typename std::invoke_result_t<const Inner&, In>::value_type;
+			// 內層階段只回傳自己的錯誤：先放寬成 PipelineError，注入的錯誤才能取代它
+			const auto widened = [this](auto&& value) -> config::StageResult<Errors, Output> {
+				return static_cast<const Inner&>(*this)(std::forward<decltype(value)>(value)).transform_error([](auto&& error) {
+					return meta::Widen<config::PipelineError>(std::forward<decltype(error)>(error));
+				});
+			};
+			return Inject(S, widened)(std::forward<In>(input));
+		}
+	};
+
+	// 每個階段都可注入的完整管線（CONFIG_FAULTS 為 0 時與 ConfigPipeline 相同）
+	using FaultyConfigPipeline = config::Pipeline<Faulty<Stage::kLoadConfig,   config::LoadStage>,
+	                                              Faulty<Stage::kValidateData, config::ValidateStage>,
+	                                              Faulty<Stage::kProcessData,  config::ProcessStage>>;
+	static_assert(std::is_same_v<FaultyConfigPipeline::Error, config::PipelineError>);
+// 結束命名空間
+}
+
+#endif
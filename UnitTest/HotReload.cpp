@@ -0,0 +1,106 @@
+// 引入對應的宣告標頭
+#include "HotReload.h"
+// 可在編譯期移除的除錯日誌
+#include "Log.h"
+// std::move
+#include <utility>
+
+// 進入命名空間
+namespace config
+{
+	// 記錄檔名
+	ConfigStore::ConfigStore(std::string filename)
+		: filename_(std::move(filename))
+	{
+	}
+
+	// 完整讀檔（含掃描與解析檢查）後交給 Apply
+	std::expected<ReloadStats, PipelineError> ConfigStore::Reload()
+	{
+		const std::lock_guard lock(reload_mutex_);
+		auto config = LoadConfig(filename_);
+		if (!config)
+			return std::unexpected(std::move(config.error()));
+		return Apply(std::move(*config));
+	}
+
+	// 內容由呼叫端提供：掃描與解析檢查與 LoadConfig 相同
+	std::expected<ReloadStats, PipelineError> ConfigStore::ReloadFromBuffer(std::string content)
+	{
+		const std::lock_guard lock(reload_mutex_);
+		auto config = LoadConfigFromBuffer(filename_, std::move(content));
+		if (!config)
+			return std::unexpected(std::move(config.error()));
+		return Apply(std::move(*config));
+	}
+
+	// 原子載入
+	std::shared_ptr<const Snapshot> ConfigStore::Current() const noexcept
+	{
+		return current_.load(std::memory_order_acquire);
+	}
+
+	// 比對、只驗證差異、發佈
+	std::expected<ReloadStats, PipelineError> ConfigStore::Apply(Config config)
+	{
+		// 寫入端只有自己（持有 reload_mutex_），這裡讀到的就是最新的快照
+		const auto previous = current_.load(std::memory_order_acquire);
+		ReloadStats stats;
+		if (previous && previous->config.data == config.data)
+		{
+			stats.unchanged = true;
+			stats.version   = previous->version;
+			return stats;
+		}
+
+		// 兩份欄位表都依鍵排序：合併走訪，新增與變更的欄位才驗證
+		const kv::Table& now = config.fields;
+		static const kv::Table kEmpty;
+		const kv::Table& before = previous ? previous->config.fields : kEmpty;
+		std::size_t i = 0;
+		std::size_t j = 0;
+		while (i < now.size() || j < before.size())
+		{
+			const int order = i == now.size()      ? 1
+			                : j == before.size()   ? -1
+			                : now[i].key.compare(before[j].key);
+			if (order > 0)
+			{
+				++stats.removed;
+				++j;
+				continue;
+			}
+			const kv::Field field = now[i++];
+			if (order < 0)
+				++stats.added;
+			else if (field.value != before[j++].value)
+				++stats.changed;
+			else
+				continue;
+
+			++stats.revalidated;
+			if (auto checked = ValidateField(field); !checked)
+			{
+				CONFIG_LOG(logging::Level::kWarn, "Reload rejected invalid field: ", field.key);
+				return std::unexpected(std::move(checked.error()));
+			}
+		}
+
+		// ProcessData 只借用內容：交給 ValidatedData 處理完再拿回來，不複製
+		ValidatedData validated{std::move(config.data), kValidatedTag};
+		auto result = ProcessData(validated);
+		config.data = std::move(validated.processed_data);
+		if (!result)
+			return std::unexpected(std::move(result.error()));
+
+		auto next = std::make_shared<Snapshot>();
+		next->config  = std::move(config);
+		next->result  = *result;
+		next->version = previous ? previous->version + 1 : 1;
+		stats.version = next->version;
+		current_.store(std::move(next), std::memory_order_release);
+		CONFIG_LOG(logging::Level::kDebug, "Config reloaded: ", filename_);
+		return stats;
+	}
+// 結束命名空間
+}
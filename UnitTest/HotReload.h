@@ -0,0 +1,95 @@
+// Include Guard：避免重複包含
+#ifndef HOT_RELOAD_H
+// 與上方成對
+#define HOT_RELOAD_H
+
+// Config / Result / PipelineError / ValidateField
+#include "Config.h"
+// 快照指標的原子替換
+#include <atomic>
+// 固定寬度整數（版本號）
+#include <cstdint>
+// std::expected
+#include <expected>
+// std::shared_ptr
+#include <memory>
+// 寫入端互斥
+#include <mutex>
+// std::string
+#include <string>
+
+/*
+設定檔熱重載：增量驗證 + 無鎖發佈
+- 每次重載仍需完整讀檔、掃描與解析（需要新的欄位表才能比對），但驗證只對「與上一份快照不同」的欄位執行：
+  兩份欄位表都依鍵排序，一次合併走訪即可找出新增、移除與值變更的鍵
+- 上一份快照的所有欄位都已通過驗證，未變更的欄位不需重驗；移除的欄位不影響驗證
+- 內容與上一份快照完全相同時不做任何事，也不發佈新版本
+- 快照為不可變的 shared_ptr<const Snapshot>，以 std::atomic<std::shared_ptr> 替換；
+  讀取端只做一次原子載入，不會等待正在進行的重載，拿到的快照在讀完之前都不會被釋放
+- 重載失敗（讀檔、解析或驗證錯誤）時保留舊快照並回傳錯誤
+- 同一時間只有一個重載在進行（寫入端以 mutex 排隊，讀取端不使用它）
+*/
+
+// 開始命名空間
+namespace config
+{
+	// 一份已通過整條管線的設定
+	struct Snapshot
+	{
+		// 內容、掃描結果與欄位表（下一次重載用來比對）
+		Config        config;
+		// ProcessData 的結果
+		Result        result{};
+		// 版本號：第一次成功載入為 1，之後每次發佈加一
+		std::uint64_t version = 0;
+	};
+
+	// 一次重載做了什麼
+	struct ReloadStats
+	{
+		// 與上一份快照比較的鍵數
+		std::size_t   added       = 0;
+		std::size_t   removed     = 0;
+		std::size_t   changed     = 0;
+		// 實際執行驗證的欄位數（新增 + 變更；第一次載入為全部欄位）
+		std::size_t   revalidated = 0;
+		// 內容完全相同：沒有發佈新版本
+		bool          unchanged   = false;
+		// 目前的版本號（unchanged 時為舊版本）
+		std::uint64_t version     = 0;
+	};
+
+	// 可熱重載的設定
+	class ConfigStore
+	{
+	public:
+		// 只記錄檔名；第一次 Reload 才讀檔
+		explicit ConfigStore(std::string filename);
+
+		// 不可複製：快照與寫入端狀態只有一份
+		ConfigStore(const ConfigStore&)            = delete;
+		ConfigStore& operator=(const ConfigStore&) = delete;
+
+		// 重新讀檔並增量驗證；成功時發佈新快照
+		[[nodiscard]] std::expected<ReloadStats, PipelineError> Reload();
+		// 內容已由呼叫端取得（例如檔案監看或網路推送）時直接套用
+		[[nodiscard]] std::expected<ReloadStats, PipelineError> ReloadFromBuffer(std::string content);
+
+		// 目前的快照（尚未成功載入過時為 nullptr）；可在任何執行緒呼叫，不會等待重載
+		[[nodiscard]] std::shared_ptr<const Snapshot> Current() const noexcept;
+
+		// 檔名
+		[[nodiscard]] const std::string& filename() const noexcept { return filename_; }
+
+	private:
+		// 以已解析的 Config 與目前快照比對、驗證、發佈（呼叫端持有 reload_mutex_）
+		[[nodiscard]] std::expected<ReloadStats, PipelineError> Apply(Config config);
+
+		std::string                                    filename_;
+		std::atomic<std::shared_ptr<const Snapshot>>   current_;
+		std::mutex                                     reload_mutex_;
+	};
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,303 @@
+// 引入對應的宣告標頭
+#include "IoContext.h"
+// std::min / std::max
+#include <algorithm>
+// errno
+#include <cerrno>
+// std::uintptr_t
+#include <cstdint>
+// std::move
+#include <utility>
+// POSIX：open
+#include <fcntl.h>
+// POSIX：fstat
+#include <sys/stat.h>
+// POSIX：pread / close
+#include <unistd.h>
+
+// 進入命名空間
+namespace coro
+{
+	// 僅供本檔使用的工具
+	namespace
+	{
+		// 檔案描述子用盡：視為背壓
+		[[nodiscard]] bool IsFdPressure(int error) noexcept
+		{
+			return error == EMFILE || error == ENFILE;
+		}
+	}
+
+	// io_uring 不可用時當場執行，不暫停
+	bool IoOperation::await_ready()
+	{
+#if CONFIG_HAS_IO_URING
+		if (io->ring_)
+			return false;
+#endif
+		result = IoContext::RunBlocking(*this);
+		return true;
+	}
+
+	// 排入待送佇列，由 Run 放進 SQ
+	void IoOperation::await_suspend(std::coroutine_handle<> self)
+	{
+		waiter = self;
+		io->backlog_.push_back(this);
+	}
+
+	// 未達上限：當場取得名額
+	bool FileSlot::await_ready() const noexcept
+	{
+		if (io->open_files_ >= io->file_limit_)
+			return false;
+		++io->open_files_;
+		io->peak_open_ = std::max(io->peak_open_, io->open_files_);
+		return true;
+	}
+
+	// 已達上限：等 ReleaseFile 把名額轉交過來
+	void FileSlot::await_suspend(std::coroutine_handle<> self)
+	{
+		io->file_waiters_.push_back(self);
+	}
+
+	// 建立 ring；失敗時所有操作改為同步執行
+	IoContext::IoContext(IoContextOptions options)
+		: options_(options), file_limit_(std::max<std::size_t>(1, options.max_open_files))
+	{
+#if CONFIG_HAS_IO_URING
+		if (options_.use_io_uring)
+			ring_ = ioring::Ring::Create(std::max(1u, options_.ring_entries));
+#endif
+	}
+
+	// 解構：ring 隨之關閉
+	IoContext::~IoContext() = default;
+
+	// 排入就緒佇列
+	void IoContext::Post(std::coroutine_handle<> handle)
+	{
+		ready_.push_back(handle);
+	}
+
+	// 事件迴圈：先恢復所有就緒的協程，再送出 I/O 並等待至少一個完成
+	void IoContext::Run()
+	{
+		for (;;)
+		{
+			while (!ready_.empty())
+			{
+				const auto handle = ready_.front();
+				ready_.pop_front();
+				handle.resume();
+			}
+#if CONFIG_HAS_IO_URING
+			if (ring_)
+			{
+				Flush();
+				if (in_ring_ == 0)
+				{
+					if (ready_.empty())
+						return;
+					continue;
+				}
+				// ring 無法再使用：尚未完成的 Task 由 RunToCompletion 回報
+				if (const int error = ring_->Submit(1); error < 0 && error != -EBUSY && error != -EAGAIN)
+					return;
+				ring_->Drain([&](const io_uring_cqe& cqe) {
+					auto* op   = reinterpret_cast<IoOperation*>(static_cast<std::uintptr_t>(cqe.user_data));
+					op->result = cqe.res;
+					--in_ring_;
+					ready_.push_back(op->waiter);
+				});
+				continue;
+			}
+#endif
+			return;
+		}
+	}
+
+	// 開檔
+	IoOperation IoContext::Open(const char* path) noexcept
+	{
+		IoOperation op;
+		op.io   = this;
+		op.kind = IoOperation::Kind::kOpen;
+		op.path = path;
+		return op;
+	}
+
+	// 讀取
+	IoOperation IoContext::Read(int fd, char* buffer, unsigned length, std::uint64_t offset) noexcept
+	{
+		IoOperation op;
+		op.io     = this;
+		op.kind   = IoOperation::Kind::kRead;
+		op.fd     = fd;
+		op.buffer = buffer;
+		op.length = length;
+		op.offset = offset;
+		return op;
+	}
+
+	// 關檔
+	IoOperation IoContext::Close(int fd) noexcept
+	{
+		IoOperation op;
+		op.io   = this;
+		op.kind = IoOperation::Kind::kClose;
+		op.fd   = fd;
+		return op;
+	}
+
+	// 歸還名額：上限逐步恢復（每次關檔加一），有等待者就直接轉交
+	void IoContext::ReleaseFile()
+	{
+		--open_files_;
+		file_limit_ = std::min(std::max<std::size_t>(1, options_.max_open_files), file_limit_ + 1);
+		while (open_files_ < file_limit_ && !file_waiters_.empty())
+		{
+			++open_files_;
+			peak_open_ = std::max(peak_open_, open_files_);
+			Post(file_waiters_.front());
+			file_waiters_.pop_front();
+		}
+	}
+
+	// 背壓：上限降到目前開著的檔案數
+	bool IoContext::ThrottleFiles() noexcept
+	{
+		++backpressure_;
+		if (open_files_ == 0)
+			return false;
+		file_limit_ = open_files_;
+		return true;
+	}
+
+	// 是否使用 io_uring
+	bool IoContext::uses_io_uring() const noexcept
+	{
+#if CONFIG_HAS_IO_URING
+		return ring_ != nullptr;
+#else
+		return false;
+#endif
+	}
+
+	// 同步版本：結果格式與 io_uring 相同（成功為回傳值，失敗為 -errno）
+	int IoContext::RunBlocking(const IoOperation& op) noexcept
+	{
+		long result = -1;
+		switch (op.kind)
+		{
+		case IoOperation::Kind::kOpen:  result = ::open(op.path, O_RDONLY | O_CLOEXEC); break;
+		case IoOperation::Kind::kRead:  result = ::pread(op.fd, op.buffer, op.length, static_cast<off_t>(op.offset)); break;
+		case IoOperation::Kind::kClose: result = ::close(op.fd); break;
+		}
+		return result < 0 ? -errno : static_cast<int>(result);
+	}
+
+	// 放入 SQ：同時在核心中的操作數不超過 SQ 容量（CQ 為其兩倍，不會溢出）
+	void IoContext::Flush()
+	{
+#if CONFIG_HAS_IO_URING
+		while (!backlog_.empty() && in_ring_ < ring_->sq_entries())
+		{
+			IoOperation* op = backlog_.front();
+			backlog_.pop_front();
+			ring_->Push([&](io_uring_sqe& sqe) {
+				switch (op->kind)
+				{
+				case IoOperation::Kind::kOpen:
+					sqe.opcode     = IORING_OP_OPENAT;
+					sqe.fd         = AT_FDCWD;
+					sqe.addr       = reinterpret_cast<std::uintptr_t>(op->path);
+					sqe.open_flags = O_RDONLY | O_CLOEXEC;
+					break;
+				case IoOperation::Kind::kRead:
+					sqe.opcode = IORING_OP_READ;
+					sqe.fd     = op->fd;
+					sqe.addr   = reinterpret_cast<std::uintptr_t>(op->buffer);
+					sqe.len    = op->length;
+					sqe.off    = op->offset;
+					break;
+				case IoOperation::Kind::kClose:
+					sqe.opcode = IORING_OP_CLOSE;
+					sqe.fd     = op->fd;
+					break;
+				}
+				sqe.user_data = reinterpret_cast<std::uintptr_t>(op);
+			});
+			++in_ring_;
+		}
+#endif
+	}
+
+	// 讀取整個檔案
+	Task<std::string> ReadFileAsync(IoContext& io, std::string path)
+	{
+		// 取得名額後開檔；EMFILE / ENFILE 時降低上限並等其他檔案關閉
+		int fd = -1;
+		for (;;)
+		{
+			co_await io.AcquireFile();
+			fd = co_await io.Open(path.c_str());
+			if (fd >= 0)
+				break;
+			io.ReleaseFile();
+			if (!IsFdPressure(-fd) || !io.ThrottleFiles())
+				co_return std::unexpected(config::ConfigReadError{path});
+		}
+
+		// fstat 不涉及磁碟 I/O，直接同步呼叫以預先配置緩衝
+		std::string content;
+		bool ok = false;
+		struct stat st{};
+		if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+		{
+			ok = true;
+			content.resize(static_cast<std::size_t>(st.st_size));
+			std::size_t filled = 0;
+			while (filled < content.size())
+			{
+				const auto length = static_cast<unsigned>(std::min<std::size_t>(content.size() - filled, 1u << 30));
+				const int got = co_await io.Read(fd, content.data() + filled, length, filled);
+				if (got == -EINTR || got == -EAGAIN)
+					continue;
+				if (got < 0)
+				{
+					ok = false;
+					break;
+				}
+				// 讀到 0：檔案在 fstat 之後變短
+				if (got == 0)
+					break;
+				filled += static_cast<std::size_t>(got);
+			}
+			content.resize(filled);
+		}
+
+		(void)co_await io.Close(fd);
+		io.ReleaseFile();
+		if (!ok)
+			co_return std::unexpected(config::ConfigReadError{path});
+		co_return std::move(content);
+	}
+
+	// 非同步 LoadConfig
+	Task<config::Config> LoadConfigAsync(IoContext& io, std::string path)
+	{
+		std::string content = co_await ReadFileAsync(io, path);
+		co_return config::LoadConfigFromBuffer(path, std::move(content));
+	}
+
+	// 整條管線：每個 co_await 失敗時都直接短路到最外層
+	Task<config::Result> RunPipelineAsync(IoContext& io, std::string path)
+	{
+		config::Config        cfg       = co_await LoadConfigAsync(io, std::move(path));
+		config::ValidatedData validated = co_await config::ValidateData(std::move(cfg));
+		co_return config::ProcessData(std::move(validated));
+	}
+// 結束命名空間
+}
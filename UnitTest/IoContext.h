@@ -0,0 +1,160 @@
+// Include Guard：避免重複包含
+#ifndef IO_CONTEXT_H
+// 與上方成對
+#define IO_CONTEXT_H
+
+// Task<T>
+#include "Task.h"
+// io_uring 包裝（CONFIG_HAS_IO_URING）
+#include "IoRing.h"
+// std::coroutine_handle
+#include <coroutine>
+// 固定寬度整數
+#include <cstdint>
+// 就緒佇列、待送操作
+#include <deque>
+// std::unique_ptr
+#include <memory>
+// std::string
+#include <string>
+
+/*
+單執行緒事件迴圈：讓上千條協程管線在同一個執行緒上同時進行 I/O
+- Open / Read / Close 是可 co_await 的非同步系統呼叫，經由 io_uring 送出；協程在等待時暫停，不阻塞執行緒
+- 無法建立 io_uring（或 use_io_uring 為 false）時，這些操作改為當場同步執行，不暫停
+- 同時開著的檔案數不超過 max_open_files；遇到 EMFILE / ENFILE 時把上限降到目前開著的檔案數，
+  等其他檔案關閉後再開（背壓），只有沒有任何檔案開著時才視為讀檔失敗
+- IoContext 與其上的所有協程必須在同一執行緒使用
+*/
+
+// 開始命名空間
+namespace coro
+{
+	// 事件迴圈選項
+	struct IoContextOptions
+	{
+		// io_uring SQ 容量；同時在核心中的操作數不超過此值，其餘排隊
+		unsigned    ring_entries   = 256;
+		// 同時開著的檔案數上限
+		std::size_t max_open_files = 1024;
+		// 是否嘗試 io_uring
+		bool        use_io_uring   = true;
+	};
+
+	class IoContext;
+
+	// 一次非同步系統呼叫；co_await 的結果為系統呼叫的回傳值，失敗時為 -errno
+	struct IoOperation
+	{
+		enum class Kind : std::uint8_t { kOpen, kRead, kClose };
+
+		IoContext*              io     = nullptr;
+		Kind                    kind   = Kind::kOpen;
+		int                     fd     = -1;
+		const char*             path   = nullptr;
+		char*                   buffer = nullptr;
+		unsigned                length = 0;
+		std::uint64_t           offset = 0;
+		int                     result = 0;
+		std::coroutine_handle<> waiter;
+
+		[[nodiscard]] bool await_ready();
+		void await_suspend(std::coroutine_handle<> self);
+		[[nodiscard]] int await_resume() const noexcept { return result; }
+	};
+
+	// 取得一個開檔名額；已達上限時暫停到有檔案關閉
+	struct FileSlot
+	{
+		IoContext* io = nullptr;
+
+		[[nodiscard]] bool await_ready() const noexcept;
+		void await_suspend(std::coroutine_handle<> self);
+		void await_resume() const noexcept {}
+	};
+
+	// 事件迴圈
+	class IoContext
+	{
+	public:
+		explicit IoContext(IoContextOptions options = {});
+		~IoContext();
+
+		// 不可複製：操作與協程都持有 this
+		IoContext(const IoContext&)            = delete;
+		IoContext& operator=(const IoContext&) = delete;
+
+		// 排入就緒佇列（例如啟動最外層 Task）
+		void Post(std::coroutine_handle<> handle);
+		// 執行到沒有任何就緒的協程、也沒有進行中的 I/O 為止
+		void Run();
+
+		// 非同步開檔（唯讀）；path 必須在操作完成前保持有效
+		[[nodiscard]] IoOperation Open(const char* path) noexcept;
+		// 非同步讀取 length 個位元組到 buffer（從 offset 開始）
+		[[nodiscard]] IoOperation Read(int fd, char* buffer, unsigned length, std::uint64_t offset) noexcept;
+		// 非同步關檔
+		[[nodiscard]] IoOperation Close(int fd) noexcept;
+
+		// 取得 / 歸還開檔名額
+		[[nodiscard]] FileSlot AcquireFile() noexcept { return FileSlot{this}; }
+		void ReleaseFile();
+		// 遇到 EMFILE / ENFILE：把上限降到目前開著的檔案數；沒有任何檔案開著（無人可等）時回傳 false
+		[[nodiscard]] bool ThrottleFiles() noexcept;
+
+		// 是否使用 io_uring
+		[[nodiscard]] bool uses_io_uring() const noexcept;
+		// 同時開著的檔案數峰值
+		[[nodiscard]] std::size_t peak_open_files() const noexcept { return peak_open_; }
+		// 因 EMFILE / ENFILE 而降低上限的次數
+		[[nodiscard]] std::size_t backpressure_events() const noexcept { return backpressure_; }
+
+	private:
+		friend struct IoOperation;
+		friend struct FileSlot;
+
+		// io_uring 不可用時當場執行
+		[[nodiscard]] static int RunBlocking(const IoOperation& op) noexcept;
+		// 把待送操作放進 SQ（不超過容量）
+		void Flush();
+
+		IoContextOptions                     options_;
+#if CONFIG_HAS_IO_URING
+		std::unique_ptr<ioring::Ring>        ring_;
+#endif
+		// 已恢復條件、等待執行的協程
+		std::deque<std::coroutine_handle<>>  ready_;
+		// 尚未放入 SQ 的操作
+		std::deque<IoOperation*>             backlog_;
+		// 已送入核心、尚未完成的操作數
+		std::size_t                          in_ring_      = 0;
+		// 開檔名額
+		std::size_t                          open_files_   = 0;
+		std::size_t                          file_limit_   = 0;
+		std::deque<std::coroutine_handle<>>  file_waiters_;
+		std::size_t                          peak_open_    = 0;
+		std::size_t                          backpressure_ = 0;
+	};
+
+	// 讀取整個檔案：開檔名額 → open → fstat → read（短讀時續讀）→ close；失敗為 ConfigReadError
+	// （協程參數以值傳入：協程暫停期間呼叫端的暫存物件可能已經消失）
+	[[nodiscard]] Task<std::string>         ReadFileAsync(IoContext& io, std::string path);
+	// 非同步 LoadConfig：讀檔不阻塞執行緒，讀完後做與 LoadConfig 相同的掃描與解析檢查
+	[[nodiscard]] Task<config::Config>      LoadConfigAsync(IoContext& io, std::string path);
+	// 整條管線：co_await LoadConfigAsync → ValidateData → ProcessData，任何一步失敗即短路
+	[[nodiscard]] Task<config::Result>      RunPipelineAsync(IoContext& io, std::string path);
+
+	// 啟動 task 並執行事件迴圈直到完成，回傳結果
+	template<typename T>
+	[[nodiscard]] std::expected<T, PipelineError> RunToCompletion(IoContext& io, Task<T> task)
+	{
+		io.Post(task.handle());
+		io.Run();
+		if (!task.done())
+			return std::unexpected(config::ProcessingError{"IoContext", "event loop stopped before the task finished"});
+		return std::move(task).result();
+	}
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,98 @@
+// 引入對應的宣告標頭
+#include "IoRing.h"
+
+#if CONFIG_HAS_IO_URING
+// std::max
+#include <algorithm>
+// errno
+#include <cerrno>
+// POSIX：mmap / munmap
+#include <sys/mman.h>
+// syscall 編號
+#include <sys/syscall.h>
+// POSIX：syscall / close
+#include <unistd.h>
+
+// 進入命名空間
+namespace ioring
+{
+	// io_uring_setup + 映射 SQ / CQ / SQE 陣列
+	std::unique_ptr<Ring> Ring::Create(unsigned entries)
+	{
+		io_uring_params params{};
+		const int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+		if (fd < 0)
+			return nullptr;
+
+		std::unique_ptr<Ring> ring(new Ring);
+		ring->fd_         = fd;
+		ring->sq_entries_ = params.sq_entries;
+		ring->sq_size_    = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		ring->cq_size_    = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		// 新核心可把 SQ 與 CQ 映射在同一段
+		const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (single)
+			ring->sq_size_ = ring->cq_size_ = std::max(ring->sq_size_, ring->cq_size_);
+
+		ring->sq_ptr_ = ::mmap(nullptr, ring->sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+		if (ring->sq_ptr_ == MAP_FAILED)
+		{
+			ring->sq_ptr_ = nullptr;
+			return nullptr;
+		}
+		ring->cq_ptr_ = single ? ring->sq_ptr_
+		                       : ::mmap(nullptr, ring->cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+		if (ring->cq_ptr_ == MAP_FAILED)
+		{
+			ring->cq_ptr_ = nullptr;
+			return nullptr;
+		}
+		ring->sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+		void* sqes = ::mmap(nullptr, ring->sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+		if (sqes == MAP_FAILED)
+			return nullptr;
+		ring->sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+		auto* sq = static_cast<char*>(ring->sq_ptr_);
+		auto* cq = static_cast<char*>(ring->cq_ptr_);
+		ring->sq_tail_  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		ring->sq_mask_  = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		ring->sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+		ring->cq_head_  = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		ring->cq_tail_  = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		ring->cq_mask_  = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		ring->cqes_     = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+		return ring;
+	}
+
+	// 解除映射並關閉 ring（核心會取消尚未完成的操作）
+	Ring::~Ring()
+	{
+		if (sqes_ != nullptr)
+			::munmap(sqes_, sqes_size_);
+		if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_)
+			::munmap(cq_ptr_, cq_size_);
+		if (sq_ptr_ != nullptr)
+			::munmap(sq_ptr_, sq_size_);
+		if (fd_ >= 0)
+			::close(fd_);
+	}
+
+	// io_uring_enter：EINTR 時重試
+	int Ring::Submit(unsigned wait)
+	{
+		for (;;)
+		{
+			const long submitted = ::syscall(__NR_io_uring_enter, fd_, pending_, wait, wait > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+			if (submitted >= 0)
+			{
+				pending_ -= static_cast<unsigned>(submitted);
+				return 0;
+			}
+			if (errno != EINTR)
+				return -errno;
+		}
+	}
+// 結束命名空間
+}
+#endif
@@ -0,0 +1,100 @@
+// Include Guard：避免重複包含
+#ifndef IO_RING_H
+// 與上方成對
+#define IO_RING_H
+
+// std::atomic_ref：與核心共用的 ring 索引
+#include <atomic>
+// std::size_t
+#include <cstddef>
+// std::unique_ptr
+#include <memory>
+
+/*
+最小的 io_uring 包裝（直接使用系統呼叫，不需要 liburing）
+- Create 建立並映射 SQ / CQ；核心不支援或被禁止時回傳 nullptr，呼叫端應退回阻塞式 I/O
+- Push 放入一個 SQE，Submit 送出並等待完成，Drain 取出所有 CQE
+- 非 Linux 或缺少 <linux/io_uring.h> 時 CONFIG_HAS_IO_URING 為 0，Ring 不存在
+- 單一執行緒使用：Push / Submit / Drain 必須在同一執行緒呼叫
+*/
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define CONFIG_HAS_IO_URING 1
+// io_uring_sqe / io_uring_cqe
+#include <linux/io_uring.h>
+#else
+#define CONFIG_HAS_IO_URING 0
+#endif
+
+#if CONFIG_HAS_IO_URING
+// 開始命名空間
+namespace ioring
+{
+	// 一個 io_uring 實例
+	class Ring
+	{
+	public:
+		// 建立 entries 個 SQ 項目的 ring；失敗回傳 nullptr
+		[[nodiscard]] static std::unique_ptr<Ring> Create(unsigned entries);
+		// 解除映射並關閉 ring
+		~Ring();
+
+		Ring(const Ring&)            = delete;
+		Ring& operator=(const Ring&) = delete;
+
+		// SQ 項目數（核心可能向上取整為 2 的冪次）
+		[[nodiscard]] unsigned sq_entries() const noexcept { return sq_entries_; }
+
+		// 放入一個 SQE：fill 填好內容後才發布 tail（release），核心才看得到；呼叫端需確保 SQ 尚有空位
+		template<typename Fill>
+		void Push(Fill&& fill)
+		{
+			const unsigned tail  = *sq_tail_;
+			const unsigned index = tail & sq_mask_;
+			sqes_[index] = io_uring_sqe{};
+			fill(sqes_[index]);
+			sq_array_[index] = index;
+			std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+			++pending_;
+		}
+
+		// 送出所有待送 SQE，並等待至少 wait 個完成；失敗回傳 -errno
+		int Submit(unsigned wait);
+
+		// 取出目前所有 CQE（acquire 讀 tail，處理完再 release 寫回 head）
+		template<typename Fn>
+		void Drain(Fn&& fn)
+		{
+			unsigned head = *cq_head_;
+			const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+			for (; head != tail; ++head)
+				fn(cqes_[head & cq_mask_]);
+			std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+		}
+
+	private:
+		Ring() = default;
+
+		int           fd_         = -1;
+		unsigned      sq_entries_ = 0;
+		void*         sq_ptr_     = nullptr;
+		std::size_t   sq_size_    = 0;
+		void*         cq_ptr_     = nullptr;
+		std::size_t   cq_size_    = 0;
+		io_uring_sqe* sqes_       = nullptr;
+		std::size_t   sqes_size_  = 0;
+		unsigned*     sq_tail_    = nullptr;
+		unsigned      sq_mask_    = 0;
+		unsigned*     sq_array_   = nullptr;
+		unsigned*     cq_head_    = nullptr;
+		unsigned*     cq_tail_    = nullptr;
+		unsigned      cq_mask_    = 0;
+		io_uring_cqe* cqes_       = nullptr;
+		// 已放入、尚未送出的 SQE 數
+		unsigned      pending_    = 0;
+	};
+// 結束命名空間
+}
+#endif
+
+#endif
@@ -0,0 +1,128 @@
+// Include Guard：避免重複包含
+#ifndef KEY_VALUE_H
+// 與上方成對
+#define KEY_VALUE_H
+
+// std::size_t
+#include <cstddef>
+// 固定寬度整數（位移與長度）
+#include <cstdint>
+// std::expected / std::unexpected
+#include <expected>
+// std::optional（查詢結果）
+#include <optional>
+// 字串池
+#include <string>
+// 不擁有記憶體的檢視
+#include <string_view>
+// 已排序的欄位表
+#include <vector>
+
+/*
+key = value 設定的解析結果：一塊連續的字串池 + 依鍵排序的欄位表（不用 std::map<std::string, std::string>）
+- 欄位以換行或 ';' 分隔；前後空白（含 '\r'）會去除；空欄位略過；以 '#' 開頭的欄位到行尾為註解
+- "key = value" 以第一個 '=' 分隔；沒有 '=' 的欄位視為值為空的旗標（例如 "verbose"）
+- 鍵不可為空、不可含空白，否則為語法錯誤（回傳出錯欄位在原文中的位移）
+- 同一個鍵出現多次時以最後一次為準
+- Parse(content, errors)：不在第一個語法錯誤停下，略過出錯的欄位、把每個錯誤依出現順序附加到 errors
+- ParseInto(content, table)：解析到既有的 Table，沿用字串池與欄位表的容量
+- 所有鍵與值依序複製到同一個字串池；欄位表只存 32 位元位移與長度，查詢為二分搜尋 O(log n)
+- Table 不指向原文，原文（例如 mmap 映射）釋放後仍然有效
+*/
+
+// 開始命名空間
+namespace kv
+{
+	// 一個欄位（檢視指向 Table 的字串池，與 Table 同生命週期）
+	struct Field
+	{
+		std::string_view key;
+		std::string_view value;
+		// 在原文中的行號（以 1 起算）
+		int              line = 0;
+		// 整個欄位（去除前後空白）在原文中的位移與長度：錯誤描述子只記錄這兩個數字，報告時再回原文取字
+		std::size_t      source_offset = 0;
+		std::size_t      source_size   = 0;
+	};
+
+	// 語法錯誤
+	struct SyntaxError
+	{
+		// 出錯欄位在原文中的位移（交給 ScanResult::Locate 換算行號與該行內容）
+		std::size_t      offset = 0;
+		// 錯誤說明（靜態字面值）
+		std::string_view reason;
+	};
+
+	// 解析後的欄位表
+	class Table
+	{
+	public:
+		// 是否已解析（手動建立的 Config 尚未解析，需要時由呼叫端補做）
+		[[nodiscard]] bool parsed() const noexcept { return parsed_; }
+		// 欄位數（重複的鍵只算一次）
+		[[nodiscard]] std::size_t size() const noexcept { return entries_.size(); }
+		[[nodiscard]] bool empty() const noexcept { return entries_.empty(); }
+		// 依鍵排序的第 i 個欄位
+		[[nodiscard]] Field operator[](std::size_t i) const noexcept { return FieldOf(entries_[i]); }
+
+		// 二分搜尋：找到時回傳值
+		[[nodiscard]] std::optional<std::string_view> Find(std::string_view key) const noexcept;
+		// 是否有此鍵
+		[[nodiscard]] bool Contains(std::string_view key) const noexcept { return Find(key).has_value(); }
+
+		// 字串池大小（位元組）
+		[[nodiscard]] std::size_t pool_bytes() const noexcept { return pool_.size(); }
+
+		// 清空為未解析狀態，保留字串池與欄位表的容量（供 ParseInto 重複使用）
+		void clear() noexcept
+		{
+			pool_.clear();
+			entries_.clear();
+			parsed_ = false;
+		}
+
+	private:
+		friend std::expected<Table, SyntaxError> Parse(std::string_view content);
+		friend Table Parse(std::string_view content, std::vector<SyntaxError>& errors);
+		friend std::expected<void, SyntaxError> ParseInto(std::string_view content, Table& table);
+
+		// 各 Parse 共用的實作：解析到 table（先清空，沿用容量）；errors 為 nullptr 時在第一個語法錯誤停下
+		[[nodiscard]] static std::expected<void, SyntaxError> Build(Table& table, std::string_view content, std::vector<SyntaxError>* errors);
+
+		// 欄位表的一列：字串池中的位移與長度
+		struct Entry
+		{
+			std::uint32_t key_offset;
+			std::uint32_t key_size;
+			std::uint32_t value_offset;
+			std::uint32_t value_size;
+			std::uint32_t line;
+			std::uint32_t source_offset;
+			std::uint32_t source_size;
+		};
+
+		[[nodiscard]] std::string_view KeyOf(const Entry& e) const noexcept { return {pool_.data() + e.key_offset, e.key_size}; }
+		[[nodiscard]] Field FieldOf(const Entry& e) const noexcept
+		{
+			return {KeyOf(e), {pool_.data() + e.value_offset, e.value_size}, static_cast<int>(e.line), e.source_offset, e.source_size};
+		}
+
+		std::string        pool_;
+		std::vector<Entry> entries_;
+		bool               parsed_ = false;
+	};
+
+	// 解析 key = value 設定
+	[[nodiscard]] std::expected<Table, SyntaxError> Parse(std::string_view content);
+	// 解析 key = value 設定，略過語法錯誤的欄位（錯誤附加到 errors）；回傳的 Table 一定是已解析狀態
+	[[nodiscard]] Table Parse(std::string_view content, std::vector<SyntaxError>& errors);
+	// 解析到既有的 table（沿用它的容量：重複解析大小相近的設定時不再配置）；失敗時 table 內容未定義
+	[[nodiscard]] std::expected<void, SyntaxError> ParseInto(std::string_view content, Table& table);
+
+	// 拆開單一欄位（已去除前後空白的 "key = value"）：檢視指向 raw，規則與 Parse 相同，不檢查語法
+	[[nodiscard]] Field SplitField(std::string_view raw) noexcept;
+// 結束命名空間
+}
+
+#endif
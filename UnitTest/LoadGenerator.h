@@ -0,0 +1,88 @@
+// Include Guard：避免重複包含
+#ifndef LOAD_GENERATOR_H
+// 與上方成對
+#define LOAD_GENERATOR_H
+
+// FaultyConfigPipeline、Plan
+#include "FaultInjection.h"
+// metrics::Histogram（延遲分布）
+#include "Metrics.h"
+// 持續時間
+#include <chrono>
+// 固定寬度整數
+#include <cstdint>
+// 每次請求的操作
+#include <functional>
+// 報表輸出
+#include <ostream>
+// 錯誤比例
+#include <span>
+// 設定檔路徑
+#include <string>
+// 每個比例一份報表
+#include <vector>
+
+/*
+負載產生器：以固定的目標速率（open loop）從多個執行緒驅動管線，量測吞吐量與尾端延遲
+- 每個執行緒依 rate / threads 的間隔排程請求；延遲從「排定的開始時間」算起，
+  落後時排隊的時間也計入（不會因為系統變慢就少送請求而低估尾端延遲）
+- rate 為 0 時不限速（closed loop）：每個請求一結束就送下一個，延遲只含處理時間
+- 成功與失敗的延遲分開記錄在 metrics::Histogram（與量測層相同的對數-線性分格），結束後合併
+- SweepErrorRatios：同一設定檔、同一速率，依序以不同的注入比例（FaultInjection.h）各跑一輪，
+  比較錯誤比例上升時的吞吐量與 p99；需以 -DCONFIG_FAULTS=1 建置，否則每一輪的實際錯誤比例都是 0
+*/
+
+// 開始命名空間
+namespace load
+{
+	// 執行參數
+	struct Options
+	{
+		// 每秒請求數（所有執行緒合計）；0 表示不限速
+		double                   rate     = 10000;
+		// 送出請求的執行緒數
+		std::size_t              threads  = 1;
+		// 每一輪的長度
+		std::chrono::nanoseconds duration = std::chrono::seconds(1);
+	};
+
+	// 一次請求：參數為執行緒編號，回傳是否成功
+	using Operation = std::function<bool(std::size_t)>;
+
+	// 一輪的結果
+	struct Report
+	{
+		// 實際送出的請求數
+		std::uint64_t            requests = 0;
+		// 失敗的請求數
+		std::uint64_t            failures = 0;
+		// 第一個請求到最後一個請求結束的時間
+		std::chrono::nanoseconds elapsed{};
+		// 延遲（奈秒）：全部、成功、失敗
+		metrics::Histogram       latency;
+		metrics::Histogram       success_latency;
+		metrics::Histogram       failure_latency;
+
+		// 每秒完成的請求數
+		[[nodiscard]] double throughput() const noexcept;
+		// 失敗比例
+		[[nodiscard]] double error_ratio() const noexcept;
+	};
+
+	// 以 options 驅動 operation，全部執行緒結束後回傳合併的結果
+	[[nodiscard]] Report Run(const Options& options, const Operation& operation);
+
+	// 反覆對 path 執行 FaultyConfigPipeline
+	[[nodiscard]] Report RunPipeline(const Options& options, const std::string& path);
+
+	// 每個比例各一輪：在 stage 以該比例注入 kind，結束後停止注入
+	[[nodiscard]] std::vector<Report> SweepErrorRatios(const Options& options, const std::string& path,
+	                                                   fault::Stage stage, config::ErrorKind kind,
+	                                                   std::span<const double> ratios);
+
+	// 報表：表頭一行，之後每份報表一行（錯誤比例、吞吐量、p50 / p99 / p99.9、成功與失敗各自的 p99；延遲單位為微秒）
+	void WriteReports(std::ostream& out, std::span<const Report> reports);
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,152 @@
+// Include Guard：避免重複包含
+#ifndef LOG_H
+// 與上方成對
+#define LOG_H
+
+// 佇列游標、統計
+#include <atomic>
+// 背景執行緒等待
+#include <condition_variable>
+// 固定寬度整數
+#include <cstdint>
+// 背景執行緒的喚醒鎖
+#include <mutex>
+// 輸出目標
+#include <ostream>
+// 記錄內容
+#include <string_view>
+// 背景格式化執行緒
+#include <thread>
+// 環形緩衝區
+#include <vector>
+
+/*
+可插拔、可在編譯期移除的除錯日誌
+- CONFIG_LOG(level, "字面值訊息", 參數)：level 低於 CONFIG_LOG_LEVEL 時整段在編譯期被丟棄，不留任何成本
+  例如 -DCONFIG_LOG_LEVEL=4 （kOff）可完全移除管線中的日誌
+- Sink：日誌後端介面；預設為同步的 StreamSink（不再每行 std::endl 強制 flush）
+- AsyncRingSink：熱路徑只把「訊息指標 + 參數複本」放進無鎖環形緩衝區，由背景執行緒負責格式化與輸出；
+  背景執行緒沒有紀錄時等待條件變數（不輪詢），生產端只在它休眠時才上鎖喚醒
+*/
+
+// 預設保留所有等級（與原本的 DEBUG 輸出行為一致）
+#ifndef CONFIG_LOG_LEVEL
+#define CONFIG_LOG_LEVEL 0
+#endif
+
+// 記錄一行日誌；message 必須是字串字面值（AsyncRingSink 只保存其指標）
+#define CONFIG_LOG(level, message, ...)                                                        \
+	do                                                                                         \
+	{                                                                                          \
+		if constexpr (static_cast<int>(level) >= CONFIG_LOG_LEVEL)                             \
+			::logging::Emit((level), "" message __VA_OPT__(, ) __VA_ARGS__);                   \
+	} while (false)
+
+// 開始命名空間
+namespace logging 
+{
+	// 日誌等級：數值即 CONFIG_LOG_LEVEL 的比較基準
+	enum class Level : int 
+	{
+		kDebug = 0,
+		kInfo  = 1,
+		kWarn  = 2,
+		kError = 3,
+		kOff   = 4,
+	};
+
+	// 等級標籤（例如 "DEBUG"）
+	[[nodiscard]] std::string_view ToString(Level level) noexcept;
+
+	// 日誌後端介面；Write 可能被多個執行緒同時呼叫
+	class Sink 
+	{
+	public:
+		virtual ~Sink() = default;
+		// message 為靜態字面值；arg 只在呼叫期間有效
+		virtual void Write(Level level, std::string_view message, std::string_view arg) = 0;
+	};
+
+	// 同步輸出：kDebug/kInfo 寫到 out，kWarn 以上寫到 err；每行一次 write，不 flush
+	class StreamSink final : public Sink 
+	{
+	public:
+		StreamSink(std::ostream& out, std::ostream& err) noexcept : out_(out), err_(err) {}
+		void Write(Level level, std::string_view message, std::string_view arg) override;
+
+	private:
+		std::ostream& out_;
+		std::ostream& err_;
+	};
+
+	// 非同步輸出：多生產者無鎖環形緩衝區 + 單一背景格式化執行緒
+	class AsyncRingSink final : public Sink 
+	{
+	public:
+		// 每筆參數最多保留的位元組數（超過則截斷）
+		static constexpr std::size_t kArgCapacity = 192;
+
+		// capacity 會無條件進位成 2 的冪次；緩衝區滿時新紀錄被丟棄並計數，不阻塞熱路徑
+		explicit AsyncRingSink(std::ostream& target, std::size_t capacity = 4096);
+		// 解構：輸出剩餘紀錄後結束背景執行緒
+		~AsyncRingSink() override;
+
+		AsyncRingSink(const AsyncRingSink&)            = delete;
+		AsyncRingSink& operator=(const AsyncRingSink&) = delete;
+
+		// 熱路徑：複製紀錄到環形緩衝區
+		void Write(Level level, std::string_view message, std::string_view arg) override;
+		// 阻塞到目前已接受的紀錄都寫出並 flush 為止
+		void Flush();
+		// 因緩衝區滿而丟棄的筆數
+		[[nodiscard]] std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+	private:
+		// 一筆紀錄；sequence 為 Vyukov 有界佇列的槽位序號
+		struct Slot 
+		{
+			std::atomic<std::size_t> sequence{0};
+			Level                    level = Level::kDebug;
+			std::string_view         message;
+			std::uint16_t            arg_size = 0;
+			char                     arg[kArgCapacity];
+		};
+
+		// 背景執行緒：取出 → 格式化 → 批次寫出
+		void Consume();
+
+		std::ostream&              target_;
+		std::vector<Slot>          slots_;
+		std::size_t                mask_;
+		// 生產端游標（多執行緒競爭）
+		alignas(64) std::atomic<std::size_t>   enqueue_{0};
+		// 消費端游標（僅背景執行緒）
+		alignas(64) std::size_t                dequeue_ = 0;
+		// 已寫出的筆數（Flush 等待用）
+		std::atomic<std::uint64_t> written_{0};
+		// 已接受的筆數
+		std::atomic<std::uint64_t> accepted_{0};
+		std::atomic<std::uint64_t> dropped_{0};
+		std::atomic<bool>          stop_{false};
+		// 背景執行緒已宣告休眠（在 mutex_ 下設定）；生產端只在它為 true 時上鎖喚醒
+		std::atomic<bool>          sleeping_{false};
+		std::mutex                 mutex_;
+		std::condition_variable    wake_;
+		std::thread                worker_;
+	};
+
+	// 替換目前的日誌後端；傳入 nullptr 恢復預設（std::cout / std::cerr 的 StreamSink）
+	// 呼叫端須確保 sink 的生命週期涵蓋所有使用期間
+	void SetSink(Sink* sink) noexcept;
+	// 目前的日誌後端
+	[[nodiscard]] Sink& CurrentSink() noexcept;
+
+	// CONFIG_LOG 展開後的實際呼叫
+	inline void Emit(Level level, std::string_view message, std::string_view arg = {}) 
+	{
+		CurrentSink().Write(level, message, arg);
+	}
+// 結束命名空間
+}
+
+#endif
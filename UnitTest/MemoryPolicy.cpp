@@ -0,0 +1,105 @@
+// 引入對應的宣告標頭
+#include "MemoryPolicy.h"
+// errno
+#include <cerrno>
+// NUMA 節點遮罩
+#include <climits>
+// MPOL_PREFERRED / MPOL_MF_MOVE（核心介面標頭，不需要 libnuma）
+#include <linux/mempolicy.h>
+// mmap / madvise
+#include <sys/mman.h>
+// SYS_mbind / SYS_getcpu
+#include <sys/syscall.h>
+// syscall / sysconf
+#include <unistd.h>
+
+// 進入命名空間
+namespace memory
+{
+	// 僅供本檔使用
+	namespace
+	{
+		// 節點遮罩支援的節點數（足以涵蓋目前的多插槽主機）
+		constexpr std::size_t kMaxNodes = 1024;
+		constexpr std::size_t kMaskBits = sizeof(unsigned long) * CHAR_BIT;
+
+		[[nodiscard]] std::size_t PageSize() noexcept
+		{
+			static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+			return size;
+		}
+
+		[[nodiscard]] constexpr std::uintptr_t AlignUp(std::uintptr_t value, std::size_t alignment) noexcept
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		// 偏好 node：該節點沒有可用記憶體時仍可從其他節點配置；已存在的頁面搬到該節點
+		bool BindToNode(void* address, std::size_t length, int node) noexcept
+		{
+			if (node < 0 || static_cast<std::size_t>(node) >= kMaxNodes)
+				return false;
+			unsigned long mask[kMaxNodes / kMaskBits] = {};
+			mask[node / kMaskBits] = 1ul << (node % kMaskBits);
+			// maxnode 比遮罩位元數多 1：核心只讀取 maxnode - 1 個位元
+			return ::syscall(SYS_mbind, address, length, MPOL_PREFERRED, mask, kMaxNodes + 1, MPOL_MF_MOVE) == 0;
+		}
+	}
+
+	int CurrentNode() noexcept
+	{
+		unsigned cpu  = 0;
+		unsigned node = 0;
+		if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+			return 0;
+		return static_cast<int>(node);
+	}
+
+	// malloc 的區塊不一定對齊：只處理起點向上、終點向下對齊後的頁面
+	bool Prepare(void* data, std::size_t size, const Policy& policy) noexcept
+	{
+		if (data == nullptr || !policy.applies(size))
+			return false;
+		const std::size_t page = PageSize();
+		const auto begin = AlignUp(reinterpret_cast<std::uintptr_t>(data), page);
+		const auto end   = (reinterpret_cast<std::uintptr_t>(data) + size) / page * page;
+		if (end <= begin)
+			return false;
+
+		void* const       address = reinterpret_cast<void*>(begin);
+		const std::size_t length  = end - begin;
+		bool applied = false;
+		if (policy.huge_pages != HugePages::kNone)
+			applied |= ::madvise(address, length, MADV_HUGEPAGE) == 0;
+		if (policy.placement == Placement::kBind)
+			applied |= BindToNode(address, length, CurrentNode());
+		return applied;
+	}
+
+	// MAP_HUGETLB 需要系統預留大頁（vm.nr_hugepages）；沒有時退回一般頁加上 THP 建議
+	std::expected<Mapping, int> MapAnonymous(std::size_t size, const Policy& policy) noexcept
+	{
+		Mapping mapping;
+		if (policy.huge_pages == HugePages::kExplicit)
+		{
+			const std::size_t length = AlignUp(size, kHugePageSize);
+			void* address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (address != MAP_FAILED)
+				mapping = Mapping{address, length, true};
+		}
+		if (mapping.address == nullptr)
+		{
+			const std::size_t length = AlignUp(size, PageSize());
+			void* address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (address == MAP_FAILED)
+				return std::unexpected(errno);
+			mapping = Mapping{address, length, false};
+			if (policy.huge_pages != HugePages::kNone)
+				::madvise(address, length, MADV_HUGEPAGE);
+		}
+		if (policy.placement == Placement::kBind)
+			BindToNode(mapping.address, mapping.length, CurrentNode());
+		return mapping;
+	}
+// 結束命名空間
+}
@@ -0,0 +1,88 @@
+// Include Guard：避免重複包含
+#ifndef MEMORY_POLICY_H
+// 與上方成對
+#define MEMORY_POLICY_H
+
+// std::size_t
+#include <cstddef>
+// 固定寬度整數
+#include <cstdint>
+// std::expected
+#include <expected>
+
+/*
+大型設定內容的記憶體配置政策：大頁（減少 TLB miss）與 NUMA 節點放置
+- HugePages::kTransparent：對緩衝區 madvise(MADV_HUGEPAGE)，核心在 THP 為 madvise 模式時也會配置 2 MiB 頁
+- HugePages::kExplicit：匿名映射先以 MAP_HUGETLB 向預留的大頁池要求，池中沒有可用頁時退回 kTransparent；
+  std::string 的緩衝區由 malloc 配置，無法使用 MAP_HUGETLB，一律以 kTransparent 處理
+- Placement::kFirstTouch：緩衝區在呼叫端執行緒配置並第一次寫入（不取自其他執行緒用過的物件池、
+  mmap 模式改為讀進匿名映射），頁面落在消費它的工作執行緒所在的節點
+- Placement::kBind：同上，另外以 mbind 把頁面綁到呼叫端目前的節點（MPOL_PREFERRED：節點記憶體不足時仍可配置，
+  已存在的頁面一併搬移）
+- 小於 min_size 的緩衝區不做任何處理：建議與綁定只對大型內容划算
+- 所有系統呼叫失敗都只是少了最佳化，不回報錯誤；內容與結果和預設政策完全相同
+*/
+
+// 開始命名空間
+namespace memory
+{
+	// x86-64 / AArch64（4 KiB 基本頁）的 PMD 大頁大小
+	inline constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+	// 大頁要求
+	enum class HugePages : std::uint8_t
+	{
+		kNone,
+		kTransparent,
+		kExplicit,
+	};
+
+	// NUMA 放置
+	enum class Placement : std::uint8_t
+	{
+		kDefault,
+		kFirstTouch,
+		kBind,
+	};
+
+	// 配置政策；預設全部關閉（與原本的行為相同）
+	struct Policy
+	{
+		HugePages   huge_pages = HugePages::kNone;
+		Placement   placement  = Placement::kDefault;
+		// 套用政策的最小緩衝區大小
+		std::size_t min_size   = kHugePageSize;
+
+		[[nodiscard]] bool enabled() const noexcept
+		{
+			return huge_pages != HugePages::kNone || placement != Placement::kDefault;
+		}
+		// size 位元組的緩衝區是否要套用
+		[[nodiscard]] bool applies(std::size_t size) const noexcept
+		{
+			return enabled() && size >= min_size;
+		}
+	};
+
+	// 目前執行緒所在的 NUMA 節點（getcpu 失敗時為 0）
+	[[nodiscard]] int CurrentNode() noexcept;
+
+	// 對已配置、尚未寫入的緩衝區套用政策（只處理完整落在範圍內的頁面）；回傳是否有任何建議生效
+	bool Prepare(void* data, std::size_t size, const Policy& policy) noexcept;
+
+	// 一段匿名映射（由呼叫端以 munmap(address, length) 釋放）
+	struct Mapping
+	{
+		void*       address  = nullptr;
+		// 映射長度：size 向上取整到頁（MAP_HUGETLB 時為大頁）大小
+		std::size_t length   = 0;
+		// 是否由 MAP_HUGETLB 配置
+		bool        huge_tlb = false;
+	};
+
+	// 依政策建立可讀寫的匿名映射（尚未寫入）；mmap 失敗時回傳 errno
+	[[nodiscard]] std::expected<Mapping, int> MapAnonymous(std::size_t size, const Policy& policy) noexcept;
+// 結束命名空間
+}
+
+#endif
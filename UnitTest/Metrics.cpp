@@ -0,0 +1,223 @@
+// 引入對應的宣告標頭
+#include "Metrics.h"
+// std::max
+#include <algorithm>
+// std::bit_width
+#include <bit>
+// std::ceil
+#include <cmath>
+// 分片註冊
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// 進入命名空間
+namespace metrics 
+{
+	// 僅供本檔使用
+	namespace 
+	{
+		// 一個執行緒的分片：只有擁有者執行緒寫入（relaxed），讀取端合併時才讀
+		struct alignas(64) Shard 
+		{
+			std::array<std::array<std::atomic<std::uint64_t>, kBucketCount>, kStageCount>          buckets{};
+			std::array<std::atomic<std::uint64_t>, kStageCount>                                     sum_ns{};
+			std::array<std::array<std::atomic<std::uint64_t>, kMaxErrorAlternatives>, kStageCount> errors{};
+		};
+
+		// 所有分片：只在執行緒第一次記錄時上鎖註冊；分片在執行緒結束後仍保留，數據不會遺失
+		// baseline 為上次 Reset 時的合計：計數器只增不減，Reset 不寫入寫入端擁有的分片
+		struct Registry 
+		{
+			std::mutex                          mutex;
+			std::vector<std::unique_ptr<Shard>> shards;
+			Snapshot                            baseline;
+		};
+
+		Registry& Shards() 
+		{
+			static Registry instance;
+			return instance;
+		}
+
+		// 目前執行緒的分片
+		Shard& LocalShard() 
+		{
+			thread_local Shard* shard = [] 
+			{
+				auto& registry = Shards();
+				std::lock_guard lock(registry.mutex);
+				registry.shards.push_back(std::make_unique<Shard>());
+				return registry.shards.back().get();
+			}();
+			return *shard;
+		}
+
+		// 單一寫入者的遞增：load + store 比 fetch_add 少一個 lock 前綴（只有擁有者執行緒寫入分片，Reset 也不例外）
+		void Bump(std::atomic<std::uint64_t>& counter, std::uint64_t by = 1) noexcept 
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+		}
+
+		// 所有分片目前的合計（呼叫端持有 registry.mutex）
+		Snapshot Total(const Registry& registry) 
+		{
+			Snapshot snap;
+			for (const auto& shard : registry.shards) 
+			{
+				for (std::size_t s = 0; s < kStageCount; ++s) 
+				{
+					auto& h = snap.latency[s];
+					for (std::size_t b = 0; b < kBucketCount; ++b) 
+					{
+						const auto n = shard->buckets[s][b].load(std::memory_order_relaxed);
+						h.buckets[b] += n;
+						h.count      += n;
+					}
+					h.sum_ns += shard->sum_ns[s].load(std::memory_order_relaxed);
+					for (std::size_t e = 0; e < kMaxErrorAlternatives; ++e) 
+						snap.errors[s][e] += shard->errors[s][e].load(std::memory_order_relaxed);
+				}
+			}
+			return snap;
+		}
+	}
+
+	// 階段名稱
+	std::string_view ToString(Stage stage) noexcept 
+	{
+		switch (stage) 
+		{
+			case Stage::kLoadConfig:   return "LoadConfig";
+			case Stage::kValidateData: return "ValidateData";
+			case Stage::kProcessData:  return "ProcessData";
+		}
+		return "Unknown";
+	}
+
+	// 對數-線性分格：小於 4 的值各自一格；其餘依最高位所在冪次，再以其後 2 個位元細分
+	std::size_t BucketOf(std::uint64_t value) noexcept 
+	{
+		constexpr std::uint64_t kSub = std::uint64_t{1} << kSubBucketBits;
+		if (value < kSub) 
+			return static_cast<std::size_t>(value);
+		const auto width = static_cast<std::size_t>(std::bit_width(value));
+		const auto shift = width - 1 - kSubBucketBits;
+		const auto sub   = static_cast<std::size_t>((value >> shift) & (kSub - 1));
+		return ((width - kSubBucketBits) << kSubBucketBits) + sub;
+	}
+
+	// 直方圖格的上界（含）
+	std::uint64_t BucketUpperBound(std::size_t bucket) noexcept 
+	{
+		constexpr std::size_t kSub = std::size_t{1} << kSubBucketBits;
+		if (bucket < kSub) 
+			return bucket;
+		const std::size_t width = (bucket >> kSubBucketBits) + kSubBucketBits;
+		const std::size_t sub   = bucket & (kSub - 1);
+		const std::size_t shift = width - 1 - kSubBucketBits;
+		if (width >= 64 && sub == kSub - 1) 
+			return UINT64_MAX;
+		return (((std::uint64_t{kSub} + sub + 1) << shift)) - 1;
+	}
+
+	// 分位數
+	std::uint64_t Histogram::Percentile(double q) const noexcept 
+	{
+		if (count == 0) 
+			return 0;
+		// nearest-rank：第 ceil(q × count) 筆（至少第 1 筆）
+		const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count))));
+		std::uint64_t seen = 0;
+		for (std::size_t b = 0; b < kBucketCount; ++b) 
+		{
+			seen += buckets[b];
+			if (seen >= rank) 
+				return BucketUpperBound(b);
+		}
+		return BucketUpperBound(kBucketCount - 1);
+	}
+
+	// 熱路徑：只碰目前執行緒的分片
+	void RecordLatency(Stage stage, std::uint64_t nanoseconds) noexcept 
+	{
+		auto& shard = LocalShard();
+		const auto s = static_cast<std::size_t>(stage);
+		Bump(shard.buckets[s][BucketOf(nanoseconds)]);
+		Bump(shard.sum_ns[s], nanoseconds);
+	}
+
+	// 熱路徑：只碰目前執行緒的分片
+	void RecordError(Stage stage, std::size_t alternative) noexcept 
+	{
+		auto& shard = LocalShard();
+		const auto idx = alternative < kMaxErrorAlternatives ? alternative : kMaxErrorAlternatives - 1;
+		Bump(shard.errors[static_cast<std::size_t>(stage)][idx]);
+	}
+
+	// 合併：逐一讀取每個分片並相加，再扣除上次 Reset 時的合計
+	Snapshot TakeSnapshot() 
+	{
+		auto& registry = Shards();
+		std::lock_guard lock(registry.mutex);
+		Snapshot snap = Total(registry);
+		const Snapshot& base = registry.baseline;
+		for (std::size_t s = 0; s < kStageCount; ++s) 
+		{
+			auto& h = snap.latency[s];
+			for (std::size_t b = 0; b < kBucketCount; ++b) 
+				h.buckets[b] -= base.latency[s].buckets[b];
+			h.count  -= base.latency[s].count;
+			h.sum_ns -= base.latency[s].sum_ns;
+			for (std::size_t e = 0; e < kMaxErrorAlternatives; ++e) 
+				snap.errors[s][e] -= base.errors[s][e];
+		}
+		return snap;
+	}
+
+	// 記下目前的合計作為新的起點；不寫入分片，因此寫入端不會把清除前的計數寫回（進行中的那一筆計入 Reset 之前或之後）
+	void Reset() noexcept 
+	{
+		auto& registry = Shards();
+		std::lock_guard lock(registry.mutex);
+		registry.baseline = Total(registry);
+	}
+
+	// Prometheus 文字格式：延遲為累積 histogram，錯誤為 counter
+	std::string ExportPrometheus(const Snapshot& snapshot) 
+	{
+		std::string out;
+		out += "# TYPE config_stage_latency_ns histogram\n";
+		for (std::size_t s = 0; s < kStageCount; ++s) 
+		{
+			const auto  name = std::string(ToString(static_cast<Stage>(s)));
+			const auto& h    = snapshot.latency[s];
+			std::uint64_t cumulative = 0;
+			for (std::size_t b = 0; b < kBucketCount; ++b) 
+			{
+				// 只輸出有資料的格（累積值在空格之間不變）
+				if (h.buckets[b] == 0) 
+					continue;
+				cumulative += h.buckets[b];
+				out += "config_stage_latency_ns_bucket{stage=\"" + name + "\",le=\"" +
+				       std::to_string(BucketUpperBound(b)) + "\"} " + std::to_string(cumulative) + "\n";
+			}
+			out += "config_stage_latency_ns_bucket{stage=\"" + name + "\",le=\"+Inf\"} " + std::to_string(h.count) + "\n";
+			out += "config_stage_latency_ns_sum{stage=\"" + name + "\"} " + std::to_string(h.sum_ns) + "\n";
+			out += "config_stage_latency_ns_count{stage=\"" + name + "\"} " + std::to_string(h.count) + "\n";
+		}
+		out += "# TYPE config_stage_errors_total counter\n";
+		for (std::size_t s = 0; s < kStageCount; ++s) 
+		{
+			for (std::size_t e = 0; e < kMaxErrorAlternatives; ++e) 
+			{
+				if (snapshot.errors[s][e] == 0) 
+					continue;
+				out += "config_stage_errors_total{stage=\"" + std::string(ToString(static_cast<Stage>(s))) +
+				       "\",alternative=\"" + std::to_string(e) + "\"} " + std::to_string(snapshot.errors[s][e]) + "\n";
+			}
+		}
+		return out;
+	}
+// 結束命名空間
+}
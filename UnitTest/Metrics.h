@@ -0,0 +1,127 @@
+// Include Guard：避免重複包含
+#ifndef METRICS_H
+// 與上方成對
+#define METRICS_H
+
+// 每個 bucket 的計數
+#include <array>
+// 執行緒本地分片的計數器
+#include <atomic>
+// 計時
+#include <chrono>
+// 固定寬度整數
+#include <cstdint>
+// 匯出文字
+#include <string>
+// 階段名稱
+#include <string_view>
+// std::forward
+#include <utility>
+
+/*
+熱路徑量測（可在編譯期移除）
+- 每個階段一組 HDR 風格的對數-線性延遲直方圖（2 的冪次區間再各分 4 格，相對誤差 ≤ 25%）
+- 依 PipelineError 的 variant 索引計數每個階段的錯誤
+- 每個執行緒寫自己的分片（只做 relaxed 原子加法，無鎖、無共享快取線），Snapshot 讀取時才合併
+- CONFIG_METRICS 為 0（預設）時 Instrument 直接回傳原本的函式，不加任何程式碼
+*/
+
+// 預設關閉；以 -DCONFIG_METRICS=1 開啟
+#ifndef CONFIG_METRICS
+#define CONFIG_METRICS 0
+#endif
+
+// 開始命名空間
+namespace metrics 
+{
+	// 被量測的管線階段
+	enum class Stage : std::uint8_t 
+	{
+		kLoadConfig   = 0,
+		kValidateData = 1,
+		kProcessData  = 2,
+	};
+
+	// 階段數量
+	inline constexpr std::size_t kStageCount = 3;
+	// 每個階段最多區分的錯誤型別數（variant 索引超過時歸入最後一格）
+	inline constexpr std::size_t kMaxErrorAlternatives = 8;
+	// 每個 2 的冪次區間細分的格數（log2）
+	inline constexpr std::size_t kSubBucketBits = 2;
+	// 直方圖格數：64 個冪次區間 × 4 格
+	inline constexpr std::size_t kBucketCount = 64 << kSubBucketBits;
+
+	// 階段名稱（匯出用標籤）
+	[[nodiscard]] std::string_view ToString(Stage stage) noexcept;
+
+	// 數值 → 直方圖格索引
+	[[nodiscard]] std::size_t BucketOf(std::uint64_t value) noexcept;
+	// 直方圖格的上界（含）
+	[[nodiscard]] std::uint64_t BucketUpperBound(std::size_t bucket) noexcept;
+
+	// 一個階段的延遲直方圖（合併後的快照）
+	struct Histogram 
+	{
+		std::array<std::uint64_t, kBucketCount> buckets{};
+		std::uint64_t count  = 0;
+		std::uint64_t sum_ns = 0;
+
+		// 分位數（q 介於 0 ~ 1）；回傳該格上界，無資料時為 0
+		[[nodiscard]] std::uint64_t Percentile(double q) const noexcept;
+	};
+
+	// 所有階段的快照
+	struct Snapshot 
+	{
+		std::array<Histogram, kStageCount> latency;
+		std::array<std::array<std::uint64_t, kMaxErrorAlternatives>, kStageCount> errors{};
+	};
+
+	// 記錄一次階段延遲（奈秒）；只寫入目前執行緒的分片
+	void RecordLatency(Stage stage, std::uint64_t nanoseconds) noexcept;
+	// 記錄一次階段錯誤（依 variant 索引）
+	void RecordError(Stage stage, std::size_t alternative) noexcept;
+	// 合併所有執行緒的分片
+	[[nodiscard]] Snapshot TakeSnapshot();
+	// 之後的快照從目前的合計重新起算（例如每個匯出週期後）；可與寫入端並行
+	void Reset() noexcept;
+	// 以 Prometheus 文字格式匯出快照，供 metrics scraper 讀取
+	[[nodiscard]] std::string ExportPrometheus(const Snapshot& snapshot);
+
+	// 取得錯誤的分類索引：variant 取 index()，其他型別（例如錯誤碼）取其數值
+	template<typename E>
+	[[nodiscard]] std::size_t ErrorAlternative(const E& error) noexcept 
+	{
+		if constexpr (requires { error.index(); }) 
+			return error.index();
+		else if constexpr (requires { error.kind; }) 
+			return static_cast<std::size_t>(error.kind);
+		else 
+			return 0;
+	}
+
+	// 包裝一個回傳 std::expected 的階段：量測延遲並依錯誤型別計數
+	// CONFIG_METRICS 為 0 時直接回傳原函式，呼叫端不需任何 #if
+	template<typename Fn>
+	[[nodiscard]] constexpr auto Instrument([[maybe_unused]] Stage stage, Fn&& fn) 
+	{
+#if CONFIG_METRICS
+		return [stage, fn = std::forward<Fn>(fn)](auto&&... args) 
+		{
+			const auto start = std::chrono::steady_clock::now();
+			auto result = fn(std::forward<decltype(args)>(args)...);
+			const auto elapsed = std::chrono::steady_clock::now() - start;
+			RecordLatency(stage, static_cast<std::uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+			if (!result) 
+				RecordError(stage, ErrorAlternative(result.error()));
+			return result;
+		};
+#else
+		return std::forward<Fn>(fn);
+#endif
+	}
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,390 @@
+// Include Guard：避免重複包含
+#ifndef PIPELINE_H
+// 與上方成對
+#define PIPELINE_H
+
+// LoadConfig / ValidateData / ProcessData 與各階段的錯誤清單
+#include "Config.h"
+// 錯誤 variant 之間的轉換
+#include "VariantMerge.h"
+// 錯誤的來源脈絡（with_context）
+#include "ErrorContext.h"
+// std::size_t
+#include <cstddef>
+// 檔案編號
+#include <cstdint>
+// std::optional：收集模式的階段結果
+#include <optional>
+// std::expected / std::unexpect
+#include <expected>
+// 階段物件
+#include <tuple>
+// std::invoke_result_t
+#include <type_traits>
+// std::forward / std::move
+#include <utility>
+
+/*
+編譯期組合的管線：Pipeline<Stage...>
+- 每個階段是一個函式物件：以 Errors（meta::TypeList）宣告它實際會產生的錯誤，operator() 回傳
+  StageResult<Errors, Out>（錯誤只含這些成員）；管線在編譯期檢查階段回傳的錯誤都在它宣告的清單中
+- Pipeline::Error 是各階段 Errors 的聯集（依序合併、去除重複），不需要手動維護錯誤清單
+- 各階段的串接全部在標頭內展開成巢狀的 inline 呼叫：成功時直接把值交給下一階段，
+  不再逐段建構、拆開中間的 expected / and_then lambda；失敗時只有一條路徑把錯誤轉成 Error 後回傳
+- 階段的錯誤以 meta::Widen 放進 Error（編譯期檢查 Error 涵蓋所有成員）；型別相同時不做任何轉換
+- 內建階段呼叫標上 config::Exact 的函式，錯誤本來就只含該階段的成員；整條路徑上唯一的轉換是 Widen
+- with_context(file)：同一組階段，但失敗時在錯誤上附加一層 ContextFrame（階段位置、檔案編號、位移），
+  錯誤型別為 Traced<Error>；成功路徑與原本的管線完全相同。階段本身回傳 Traced 時（例如內層的 with_context 管線）
+  沿用它的堆疊再推一層，得到由內而外的完整來源路徑
+- 執行策略是 BasicPipeline 的第一個模板參數：Pipeline<Stage...> 即 BasicPipeline<FailFast, Stage...>，行為與成本不變；
+  BasicPipeline<CollectAll, Stage...> 一次執行收集所有彼此獨立的錯誤，錯誤型別為 ErrorList（Error 的小型向量）
+- 收集模式下，提供 Collect(input, ErrorList&) 的階段自行附加錯誤並在可以的時候繼續產出結果
+  （例如讀檔略過語法錯誤的欄位、驗證回報每個違規欄位），之後的收集階段照常執行；
+  只組合部分階段時改收集到只含該階段錯誤的清單（LoadErrorList 等）再放寬，同樣不收窄；
+  沒有 Collect 的階段依賴前面的結果正確，只在目前沒有任何錯誤時執行，失敗時附加一筆後停止
+- PooledConfigPipeline：同樣三個階段的緩衝區重用版本（BufferPool.h），成功與失敗路徑都把緩衝區歸還物件池
+*/
+
+// 開始命名空間
+namespace config
+{
+	// 階段的回傳型別：錯誤只含 Errors 的成員
+	template<typename Errors, typename T>
+	using StageResult = std::expected<T, meta::AsVariant<Errors>>;
+
+	// 讀檔階段
+	struct LoadStage
+	{
+		using Errors = LoadErrors;
+
+		[[nodiscard]] StageResult<Errors, Config> operator()(const std::string& filename) const
+		{
+			return LoadConfig(filename, Exact{});
+		}
+		// 收集模式：略過出錯的欄位，仍回傳其餘欄位
+		[[nodiscard]] std::optional<Config> Collect(const std::string& filename, ErrorList& errors) const
+		{
+			return LoadConfig(filename, errors);
+		}
+		[[nodiscard]] std::optional<Config> Collect(const std::string& filename, LoadErrorList& errors) const
+		{
+			return LoadConfig(filename, errors);
+		}
+	};
+
+	// 驗證階段：右值輸入時沿用 Config::data 的緩衝區
+	struct ValidateStage
+	{
+		using Errors = ValidateErrors;
+
+		template<typename ConfigRef>
+		[[nodiscard]] StageResult<Errors, ValidatedData> operator()(ConfigRef&& config) const
+		{
+			return ValidateData(std::forward<ConfigRef>(config), Exact{});
+		}
+		// 收集模式：回報所有違規欄位
+		template<typename ConfigRef>
+		[[nodiscard]] std::optional<ValidatedData> Collect(ConfigRef&& config, ErrorList& errors) const
+		{
+			return ValidateData(std::forward<ConfigRef>(config), errors);
+		}
+		template<typename ConfigRef>
+		[[nodiscard]] std::optional<ValidatedData> Collect(ConfigRef&& config, ValidateErrorList& errors) const
+		{
+			return ValidateData(std::forward<ConfigRef>(config), errors);
+		}
+	};
+
+	// 處理階段
+	struct ProcessStage
+	{
+		using Errors = ProcessErrors;
+
+		template<typename DataRef>
+		[[nodiscard]] StageResult<Errors, Result> operator()(DataRef&& data) const
+		{
+			return ProcessData(std::forward<DataRef>(data), Exact{});
+		}
+	};
+
+	// 緩衝區重用模式的三個階段：內容緩衝區、掃描結果與欄位表取自物件池，用完歸還
+	struct PooledLoadStage
+	{
+		using Errors = LoadErrors;
+
+		[[nodiscard]] StageResult<Errors, Config> operator()(const std::string& filename) const
+		{
+			return LoadConfigPooled(filename, Exact{});
+		}
+	};
+	struct PooledValidateStage
+	{
+		using Errors = ValidateErrors;
+
+		[[nodiscard]] StageResult<Errors, ValidatedData> operator()(Config&& config) const
+		{
+			return ValidateDataPooled(std::move(config), Exact{});
+		}
+	};
+	struct PooledProcessStage
+	{
+		using Errors = ProcessErrors;
+
+		[[nodiscard]] StageResult<Errors, Result> operator()(ValidatedData&& data) const
+		{
+			return ProcessDataPooled(std::move(data), Exact{});
+		}
+	};
+
+	// 實作細節
+	namespace detail
+	{
+		// 依序套用各階段後的成功型別
+		template<typename In, typename... Stages>
+		struct ChainOutput
+		{
+			using type = std::remove_cvref_t<In>;
+		};
+		template<typename In, typename Stage, typename... Rest>
+		struct ChainOutput<In, Stage, Rest...>
+			: ChainOutput<typename std::invoke_result_t<const Stage&, In>::value_type, Rest...>
+		{
+		};
+
+		// 錯誤本體：Traced（內層 with_context 管線）取其錯誤，其他原樣
+		template<typename E>
+		struct ErrorBody
+		{
+			using type = E;
+		};
+		template<typename E, std::size_t N>
+		struct ErrorBody<Traced<E, N>>
+		{
+			using type = E;
+		};
+
+		// 階段回傳的錯誤都在它宣告的 Errors 中
+		template<typename Stage, typename Out>
+		inline constexpr bool kDeclaresErrors =
+			meta::kWidensTo<typename ErrorBody<typename Out::error_type>::type, meta::AsVariant<typename Stage::Errors>>;
+
+		// 階段是否支援收集模式
+		template<typename Stage, typename Value>
+		inline constexpr bool kCollects = requires(const Stage& stage, Value&& value, ErrorList& errors) {
+			stage.Collect(std::forward<Value>(value), errors);
+		};
+	}
+
+	// 執行策略：任何一段失敗即回傳（預設）
+	struct FailFast {};
+	// 執行策略：一次執行收集所有彼此獨立的錯誤
+	struct CollectAll {};
+
+	// 以執行策略組合的管線
+	template<typename Policy, typename... Stages>
+	class BasicPipeline;
+
+	// 編譯期組合的管線（第一個錯誤即停止）
+	template<typename... Stages>
+	using Pipeline = BasicPipeline<FailFast, Stages...>;
+
+	// 失敗時附加來源脈絡的管線（由 Pipeline::with_context 建立）
+	template<std::size_t N, typename... Stages>
+	class ContextPipeline;
+
+	// 第一個錯誤即停止
+	template<typename... Stages>
+	class BasicPipeline<FailFast, Stages...>
+	{
+		static_assert(sizeof...(Stages) > 0, "Pipeline needs at least one stage");
+
+	public:
+		// 各階段錯誤的聯集
+		using Error = meta::UnionVariant<typename Stages::Errors...>;
+		// 以 In 為輸入時的最終成功型別
+		template<typename In>
+		using Output = typename detail::ChainOutput<In, Stages...>::type;
+
+		constexpr BasicPipeline() = default;
+		constexpr explicit BasicPipeline(Stages... stages) : stages_(std::move(stages)...) {}
+
+		// 執行整條管線；任何一段失敗即回傳，後續階段不執行
+		template<typename In>
+		[[nodiscard]] constexpr std::expected<Output<In>, Error> operator()(In&& input) const
+		{
+			return Step<std::expected<Output<In>, Error>, 0>(std::forward<In>(input));
+		}
+
+		// 同一組階段，失敗時附加來源脈絡（最多 N 層）
+		template<std::size_t N = kDefaultContextDepth>
+		[[nodiscard]] constexpr ContextPipeline<N, Stages...> with_context(std::uint32_t file = 0) const
+		{
+			return ContextPipeline<N, Stages...>(file, stages_);
+		}
+
+	private:
+		// 第 I 段：成功則把值直接交給第 I + 1 段
+		template<typename R, std::size_t I, typename Value>
+		[[nodiscard]] constexpr R Step(Value&& value) const
+		{
+			if constexpr (I == sizeof...(Stages))
+				return R{std::in_place, std::forward<Value>(value)};
+			else
+			{
+				const auto& stage = std::get<I>(stages_);
+				auto out = stage(std::forward<Value>(value));
+				static_assert(detail::kDeclaresErrors<std::remove_cvref_t<decltype(stage)>, decltype(out)>,
+				              "Pipeline: stage returns an error type not listed in its Errors");
+				if (!out) [[unlikely]]
+					return R{std::unexpect, meta::Widen<Error>(std::move(out).error())};
+				return Step<R, I + 1>(std::move(*out));
+			}
+		}
+
+		[[no_unique_address]] std::tuple<Stages...> stages_{};
+	};
+
+	// 收集所有彼此獨立的錯誤
+	template<typename... Stages>
+	class BasicPipeline<CollectAll, Stages...>
+	{
+		static_assert(sizeof...(Stages) > 0, "Pipeline needs at least one stage");
+
+	public:
+		// 各階段錯誤的聯集
+		using Error     = meta::UnionVariant<typename Stages::Errors...>;
+		// 一次執行收集到的所有錯誤（依發生順序）
+		using ErrorList = util::SmallVector<Error, kInlineErrors>;
+		// 以 In 為輸入時的最終成功型別
+		template<typename In>
+		using Output = typename detail::ChainOutput<In, Stages...>::type;
+
+		constexpr BasicPipeline() = default;
+		constexpr explicit BasicPipeline(Stages... stages) : stages_(std::move(stages)...) {}
+
+		// 執行整條管線；有任何錯誤時回傳全部
+		template<typename In>
+		[[nodiscard]] std::expected<Output<In>, ErrorList> operator()(In&& input) const
+		{
+			ErrorList errors;
+			auto out = Step<Output<In>, 0>(std::forward<In>(input), errors);
+			if (!errors.empty())
+				return std::unexpected(std::move(errors));
+			return std::move(*out);
+		}
+
+	private:
+		// 第 I 段：收集階段即使已有錯誤也執行；其他階段只在沒有錯誤時執行
+		template<typename R, std::size_t I, typename Value>
+		[[nodiscard]] std::optional<R> Step(Value&& value, ErrorList& errors) const
+		{
+			if constexpr (I == sizeof...(Stages))
+				return std::optional<R>(std::in_place, std::forward<Value>(value));
+			else
+			{
+				const auto& stage = std::get<I>(stages_);
+				if constexpr (detail::kCollects<std::remove_cvref_t<decltype(stage)>, Value>)
+				{
+					auto out = Collect(stage, std::forward<Value>(value), errors);
+					if (!out)
+						return std::nullopt;
+					return Step<R, I + 1>(std::move(*out), errors);
+				}
+				else
+				{
+					if (!errors.empty())
+						return std::nullopt;
+					auto out = stage(std::forward<Value>(value));
+					static_assert(detail::kDeclaresErrors<std::remove_cvref_t<decltype(stage)>, decltype(out)>,
+					              "Pipeline: stage returns an error type not listed in its Errors");
+					if (!out) [[unlikely]]
+					{
+						errors.push_back(meta::Widen<Error>(std::move(out).error()));
+						return std::nullopt;
+					}
+					return Step<R, I + 1>(std::move(*out), errors);
+				}
+			}
+		}
+
+		// 階段以 config::ErrorList 收集；Error 不同時（只組合部分階段）改收集到只含該階段錯誤的清單，逐筆放寬
+		template<typename Stage, typename Value>
+		[[nodiscard]] static auto Collect(const Stage& stage, Value&& value, ErrorList& errors)
+		{
+			if constexpr (std::is_same_v<ErrorList, config::ErrorList>)
+				return stage.Collect(std::forward<Value>(value), errors);
+			else
+			{
+				util::SmallVector<meta::AsVariant<typename Stage::Errors>, kInlineErrors> collected;
+				auto out = stage.Collect(std::forward<Value>(value), collected);
+				for (auto& error : collected)
+					errors.push_back(meta::Widen<Error>(std::move(error)));
+				return out;
+			}
+		}
+
+		[[no_unique_address]] std::tuple<Stages...> stages_{};
+	};
+
+	// 失敗時附加來源脈絡的管線
+	template<std::size_t N, typename... Stages>
+	class ContextPipeline
+	{
+	public:
+		// 各階段錯誤的聯集；作為其他 ContextPipeline 的階段時使用
+		using Errors = meta::Union<typename Stages::Errors...>;
+		// 錯誤本體 + 來源脈絡
+		using Error  = Traced<meta::AsVariant<Errors>, N>;
+		// 以 In 為輸入時的最終成功型別
+		template<typename In>
+		using Output = typename detail::ChainOutput<In, Stages...>::type;
+
+		constexpr ContextPipeline(std::uint32_t file, const std::tuple<Stages...>& stages) : file_(file), stages_(stages) {}
+
+		// 執行整條管線；任何一段失敗即附加一層脈絡後回傳
+		template<typename In>
+		[[nodiscard]] constexpr std::expected<Output<In>, Error> operator()(In&& input) const
+		{
+			return Step<std::expected<Output<In>, Error>, 0>(std::forward<In>(input));
+		}
+
+		// 檔案編號
+		[[nodiscard]] constexpr std::uint32_t file() const noexcept { return file_; }
+
+	private:
+		// 與 Pipeline::Step 相同，只有失敗分支多推一層脈絡
+		template<typename R, std::size_t I, typename Value>
+		[[nodiscard]] constexpr R Step(Value&& value) const
+		{
+			if constexpr (I == sizeof...(Stages))
+				return R{std::in_place, std::forward<Value>(value)};
+			else
+			{
+				const auto& stage = std::get<I>(stages_);
+				auto out = stage(std::forward<Value>(value));
+				static_assert(detail::kDeclaresErrors<std::remove_cvref_t<decltype(stage)>, decltype(out)>,
+				              "Pipeline: stage returns an error type not listed in its Errors");
+				if (!out) [[unlikely]]
+					return R{std::unexpect, AddContext<typename Error::error_type, N>(std::move(out).error(), static_cast<std::uint16_t>(I), file_)};
+				return Step<R, I + 1>(std::move(*out));
+			}
+		}
+
+		std::uint32_t                               file_ = 0;
+		[[no_unique_address]] std::tuple<Stages...> stages_{};
+	};
+
+	// 完整管線：讀檔 → 驗證 → 處理
+	using ConfigPipeline = Pipeline<LoadStage, ValidateStage, ProcessStage>;
+	// 各階段錯誤的聯集恰好就是 PipelineError（同樣的成員、同樣的順序）
+	static_assert(std::is_same_v<ConfigPipeline::Error, PipelineError>);
+	// 緩衝區重用的完整管線：穩定狀態下每次執行不配置記憶體
+	using PooledConfigPipeline = Pipeline<PooledLoadStage, PooledValidateStage, PooledProcessStage>;
+	static_assert(std::is_same_v<PooledConfigPipeline::Error, PipelineError>);
+	// 同一組階段，收集所有讀檔與驗證錯誤
+	using CollectingConfigPipeline = BasicPipeline<CollectAll, LoadStage, ValidateStage, ProcessStage>;
+	static_assert(std::is_same_v<CollectingConfigPipeline::ErrorList, ErrorList>);
+// 結束命名空間
+}
+
+#endif
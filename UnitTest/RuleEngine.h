@@ -0,0 +1,152 @@
+// Include Guard：避免重複包含
+#ifndef RULE_ENGINE_H
+// 與上方成對
+#define RULE_ENGINE_H
+
+// ValidationError / Config
+#include "Config.h"
+// 已解析的欄位表
+#include "KeyValue.h"
+// std::size_t
+#include <cstddef>
+// 固定寬度整數（範圍、位移）
+#include <cstdint>
+// std::expected / std::unexpected
+#include <expected>
+// 樣式規則
+#include <regex>
+// 鍵、樣式字串
+#include <string>
+// 檢視
+#include <string_view>
+// 規則清單與 SoA 欄位
+#include <vector>
+
+/*
+批次驗證規則引擎：規則集編譯一次，之後每份設定只掃一次欄位表
+- RuleSet 以建構式 API 收集規則：必填、整數範圍、列舉、正規表示式（完整比對）、長度上限、禁止子字串
+- Compile() 把規則依鍵排序、分組，轉成 structure-of-arrays 的 Program：
+  鍵只存一次（字串池 + 位移），同一個鍵的規則在各欄位陣列中相鄰，評估一個欄位時只碰到連續的一小段
+- 鍵為 kAnyField（"*"）的規則套用到每個欄位（例如禁止值中出現 "invalid_field"）
+- Evaluate() 同時走訪兩份依鍵排序的表（欄位表與程式的鍵），O(欄位數 + 鍵數)；
+  回傳所有不合規的欄位（每個欄位一筆 ValidationError，取它第一條不通過的規則），而不是只有第一個
+- 正規表示式在 Compile 時建好；樣式錯誤、範圍上下界顛倒等以 RuleError 回報，不拋例外
+*/
+
+// 開始命名空間
+namespace rules
+{
+	// 套用到每個欄位的規則所用的鍵
+	inline constexpr std::string_view kAnyField = "*";
+
+	// 規則種類
+	enum class Op : std::uint8_t
+	{
+		kRequired,
+		kRange,
+		kOneOf,
+		kMatches,
+		kMaxLength,
+		kForbid,
+	};
+
+	// 規則集編譯錯誤
+	struct RuleError
+	{
+		// 出錯的規則（加入順序，以 0 起算）
+		std::size_t rule = 0;
+		// 原因
+		std::string reason;
+	};
+
+	class Program;
+
+	// 規則集（編譯前）
+	class RuleSet
+	{
+	public:
+		// 必須出現
+		RuleSet& Required(std::string key);
+		// 十進位整數，且介於 [lo, hi]
+		RuleSet& Range(std::string key, std::int64_t lo, std::int64_t hi);
+		// 必須是其中之一
+		RuleSet& OneOf(std::string key, std::vector<std::string> values);
+		// 整個值符合 ECMAScript 正規表示式
+		RuleSet& Matches(std::string key, std::string pattern);
+		// 長度不超過 n 個位元組
+		RuleSet& MaxLength(std::string key, std::size_t n);
+		// 值中不可出現 text
+		RuleSet& Forbid(std::string key, std::string text);
+
+		// 規則數
+		[[nodiscard]] std::size_t size() const noexcept { return specs_.size(); }
+
+		// 編譯成 Program
+		[[nodiscard]] std::expected<Program, RuleError> Compile() const;
+
+	private:
+		// 一條規則的原始描述
+		struct Spec
+		{
+			Op                       op;
+			std::string              key;
+			std::int64_t             lo = 0;
+			std::int64_t             hi = 0;
+			std::vector<std::string> values{};
+			std::string              text{};
+		};
+
+		std::vector<Spec> specs_;
+	};
+
+	// 編譯後的規則程式（structure-of-arrays）；可在多個執行緒同時 Evaluate
+	class Program
+	{
+	public:
+		// 編入陣列的規則數（必填只記在鍵上，不計入）、不同的鍵數
+		[[nodiscard]] std::size_t size() const noexcept { return op_.size(); }
+		[[nodiscard]] std::size_t key_count() const noexcept { return key_offset_.size(); }
+
+		// 評估所有規則；回傳所有不合規的欄位（依鍵排序），全部通過時為空
+		[[nodiscard]] std::vector<config::ValidationError> Evaluate(const kv::Table& fields) const;
+		// 同上，作用在 Config 上（尚未解析的 Config 先解析；語法錯誤以一筆 ValidationError 回報）
+		[[nodiscard]] std::expected<void, std::vector<config::ValidationError>> Validate(const config::Config& config) const;
+
+	private:
+		friend class RuleSet;
+
+		// 第 k 個鍵
+		[[nodiscard]] std::string_view KeyAt(std::size_t k) const noexcept { return {pool_.data() + key_offset_[k], key_size_[k]}; }
+		// 字串池中的一段
+		[[nodiscard]] std::string_view PoolAt(std::uint32_t offset, std::uint32_t size) const noexcept { return {pool_.data() + offset, size}; }
+		// 依序執行 [first, last) 的規則；回傳是否全部通過
+		[[nodiscard]] bool Run(std::size_t first, std::size_t last, std::string_view value) const;
+
+		// 鍵（依鍵排序、不重複）與各自的規則區段 [first_rule_[k], first_rule_[k + 1])
+		std::string                pool_;
+		std::vector<std::uint32_t> key_offset_;
+		std::vector<std::uint32_t> key_size_;
+		std::vector<std::uint32_t> first_rule_;
+		std::vector<std::uint8_t>  required_;
+		// 套用到每個欄位的規則：[any_first_, size())
+		std::size_t                any_first_ = 0;
+
+		// 規則（同一個鍵的規則相鄰）：每個欄位一個陣列
+		std::vector<Op>            op_;
+		// kRange：上下界；kMaxLength：hi 為上限
+		std::vector<std::int64_t>  lo_;
+		std::vector<std::int64_t>  hi_;
+		// kOneOf：列舉值的 [arg_, arg_ + count_)；kForbid：字串池中的位移與長度；kMatches：patterns_ 的索引
+		std::vector<std::uint32_t> arg_;
+		std::vector<std::uint32_t> count_;
+
+		// 列舉值在字串池中的位移與長度（每條規則的區段各自排序，二分搜尋）
+		std::vector<std::uint32_t> choice_offset_;
+		std::vector<std::uint32_t> choice_size_;
+		// 正規表示式
+		std::vector<std::regex>    patterns_;
+	};
+// 結束命名空間
+}
+
+#endif
@@ -0,0 +1,125 @@
+// Include Guard：避免重複包含
+#ifndef SCANNER_H
+// 與上方成對
+#define SCANNER_H
+
+// std::size_t
+#include <cstddef>
+// 固定寬度整數（狀態表）
+#include <cstdint>
+// std::optional：查詢某個樣式的第一次出現位置
+#include <optional>
+// std::string：保存樣式
+#include <string>
+// std::string_view：掃描輸入不需擁有記憶體
+#include <string_view>
+// std::vector：狀態表、命中清單
+#include <vector>
+
+/*
+多樣式掃描器（Aho-Corasick）
+- 建構時把所有哨兵字串（例如 "malformed"、"invalid_field"）編譯成一張 DFA
+- Scan 對輸入只走訪一次，回報每一個命中的樣式編號與位元組位移
+- 支援 SSE2 時，以 16 位元組為單位跳過不含任何樣式首字元的區塊（同時取得換行位置）
+- 各管線階段改為讀取 ScanResult，而不是各自再 find 一次
+- 同一趟走訪順便記錄所有換行位移，錯誤位移可用二分搜尋在 O(log n) 內換算成行號與該行內容
+*/
+
+// 開始命名空間
+namespace scanner 
+{
+	// 一次命中：哪個樣式、從哪個位元組位移開始
+	struct Hit 
+	{
+		// 樣式編號（建構掃描器時的順序）
+		std::size_t pattern;
+		// 命中起點的位元組位移（以 0 起算）
+		std::size_t offset;
+	};
+
+	// 位移換算後的行資訊
+	struct LineLocation 
+	{
+		// 行號（以 1 起算）
+		int              line_number;
+		// 該行內容（不含換行字元；檢視指向原始輸入）
+		std::string_view line_content;
+	};
+
+	// 一次掃描的結果：依命中結尾位置遞增排序的命中清單，以及換行索引
+	struct ScanResult 
+	{
+		// 所有命中
+		std::vector<Hit> hits;
+		// 每個 '\n' 的位元組位移（遞增），與命中在同一趟走訪中建立
+		std::vector<std::size_t> newlines;
+		// 是否已經掃描過（手動建立的資料結構預設為 false，呼叫端可據此補掃）
+		bool scanned = false;
+
+		// 是否曾命中指定樣式
+		[[nodiscard]] bool Contains(std::size_t pattern) const noexcept;
+		// 指定樣式第一次出現的位移；未出現則為 std::nullopt
+		[[nodiscard]] std::optional<std::size_t> First(std::size_t pattern) const noexcept;
+		// 將位移換算為行號與該行內容（text 必須是產生此結果的同一份輸入）；O(log n)
+		[[nodiscard]] LineLocation Locate(std::string_view text, std::size_t offset) const noexcept;
+	};
+
+	// 串流掃描的進度：跨區塊保留 DFA 狀態，切在區塊邊界上的樣式仍能被偵測
+	struct StreamState 
+	{
+		// 目前 DFA 狀態
+		std::uint32_t state = 0;
+		// 已掃描的位元組數（下一個區塊的起始位移）
+		std::size_t   offset = 0;
+		// 已掃描內容中的換行數（不保留位移，記憶體固定）
+		std::size_t   newline_count = 0;
+
+		// 位移 pos 所在的行號；chunk 必須是最近一次 Feed 的結果，且 pos 與該區塊之間沒有換行（跨邊界命中的起點可在前一區塊）
+		[[nodiscard]] int LineOf(const ScanResult& chunk, std::size_t pos) const noexcept;
+	};
+
+	// Aho-Corasick 多樣式比對器：建構一次、可重複用於多份輸入（Scan 為 const，可跨執行緒共用）
+	class MultiPatternScanner 
+	{
+	public:
+		// 以一組樣式建立自動機；樣式編號即為其在清單中的索引
+		explicit MultiPatternScanner(std::vector<std::string> patterns);
+
+		// 單次走訪輸入，回報所有命中
+		[[nodiscard]] ScanResult Scan(std::string_view text) const;
+		// 同上，寫入既有的結果（清空後沿用 hits / newlines 的容量，重複掃描大小相近的輸入時不再配置）
+		void Scan(std::string_view text, ScanResult& into) const;
+		// 串流掃描：接續 stream 的狀態掃描下一個區塊；回傳的命中與換行為絕對位移，只含本區塊新增的部分
+		[[nodiscard]] ScanResult Feed(StreamState& stream, std::string_view chunk) const;
+
+		// 樣式數量
+		[[nodiscard]] std::size_t pattern_count() const noexcept { return patterns_.size(); }
+		// 取得指定樣式
+		[[nodiscard]] const std::string& pattern(std::size_t id) const { return patterns_[id]; }
+
+	private:
+		// Scan / Feed 共用的走訪：從 state 開始，位移加上 base
+		void Run(std::uint32_t& resume, std::string_view text, std::size_t base, ScanResult& result) const;
+
+		// 首字元種類不超過此數時啟用 SIMD 前置過濾
+		static constexpr std::size_t kMaxPrefilterBytes = 8;
+
+		// 原始樣式
+		std::vector<std::string>   patterns_;
+		// 各樣式的首字元（去重）
+		std::vector<unsigned char> first_bytes_;
+		// 位元組 → 字元類別（只出現在樣式中的位元組各自一類，其餘全歸類別 0）
+		std::uint16_t              byte_class_[256] = {};
+		// 字元類別數量（含「其他」類別）
+		std::size_t                class_count_ = 1;
+		// 完整 DFA 轉移表：next_[state * class_count_ + cls]
+		std::vector<std::uint32_t> next_;
+		// 每個狀態輸出的樣式：output_begin_[s] ~ output_begin_[s + 1] 為 outputs_ 的區間
+		std::vector<std::uint32_t> output_begin_;
+		// 扁平化的輸出樣式編號
+		std::vector<std::uint32_t> outputs_;
+	};
+// 結束命名空間
+}
+
+#endif
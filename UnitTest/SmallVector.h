@@ -0,0 +1,154 @@
+// Include Guard：避免重複包含
+#ifndef SMALL_VECTOR_H
+// 與上方成對
+#define SMALL_VECTOR_H
+
+// std::byte
+#include <cstddef>
+// std::construct_at / std::destroy_at / std::launder
+#include <memory>
+// std::is_nothrow_move_constructible_v
+#include <type_traits>
+// std::forward / std::move
+#include <utility>
+// 溢出時的儲存空間
+#include <vector>
+
+/*
+小型向量：前 N 個元素放在物件內部，超過時才整批搬到 std::vector
+- 錯誤清單通常只有一兩筆：收集模式的管線在常見情況下不配置任何記憶體
+- 元素始終連續（data() / begin() / end() 為指標）；溢出後直到 clear() 都留在 std::vector，
+  clear() 回到內部儲存，但保留 std::vector 的容量，再次溢出時不必重新配置
+*/
+
+// 開始命名空間
+namespace util
+{
+	template<typename T, std::size_t N>
+	class SmallVector
+	{
+		static_assert(N > 0, "SmallVector needs inline capacity");
+
+	public:
+		using value_type = T;
+
+		SmallVector() noexcept = default;
+		~SmallVector() { clear(); }
+
+		SmallVector(const SmallVector& other)
+		{
+			for (const T& value : other)
+				emplace_back(value);
+		}
+		SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			TakeFrom(other);
+		}
+		SmallVector& operator=(const SmallVector& other)
+		{
+			if (this != &other)
+			{
+				clear();
+				for (const T& value : other)
+					emplace_back(value);
+			}
+			return *this;
+		}
+		SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this != &other)
+			{
+				clear();
+				TakeFrom(other);
+			}
+			return *this;
+		}
+
+		// 加入一個元素（先建好再搬移：args 可以指向本身的元素）
+		template<typename... Args>
+		T& emplace_back(Args&&... args)
+		{
+			if (spilled_)
+				return heap_.emplace_back(std::forward<Args>(args)...);
+			if (size_ < N)
+				return *std::construct_at(InlineAt(size_++), std::forward<Args>(args)...);
+
+			// 內部儲存已滿：全部搬到 std::vector
+			T value(std::forward<Args>(args)...);
+			heap_.reserve(N * 2);
+			for (std::size_t i = 0; i < size_; ++i)
+				heap_.push_back(std::move(*InlineAt(i)));
+			DestroyInline();
+			spilled_ = true;
+			return heap_.emplace_back(std::move(value));
+		}
+		void push_back(const T& value) { emplace_back(value); }
+		void push_back(T&& value) { emplace_back(std::move(value)); }
+
+		// 清空並回到內部儲存（heap_ 只清空元素、保留容量）
+		void clear() noexcept
+		{
+			if (spilled_)
+			{
+				heap_.clear();
+				spilled_ = false;
+			}
+			else
+				DestroyInline();
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept { return spilled_ ? heap_.size() : size_; }
+		[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+		// 是否仍在物件內部（沒有配置）
+		[[nodiscard]] bool is_inline() const noexcept { return !spilled_; }
+		[[nodiscard]] static constexpr std::size_t inline_capacity() noexcept { return N; }
+
+		[[nodiscard]] T* data() noexcept { return spilled_ ? heap_.data() : InlineAt(0); }
+		[[nodiscard]] const T* data() const noexcept { return spilled_ ? heap_.data() : InlineAt(0); }
+		[[nodiscard]] T* begin() noexcept { return data(); }
+		[[nodiscard]] T* end() noexcept { return data() + size(); }
+		[[nodiscard]] const T* begin() const noexcept { return data(); }
+		[[nodiscard]] const T* end() const noexcept { return data() + size(); }
+		[[nodiscard]] T& operator[](std::size_t i) noexcept { return data()[i]; }
+		[[nodiscard]] const T& operator[](std::size_t i) const noexcept { return data()[i]; }
+		[[nodiscard]] T& front() noexcept { return data()[0]; }
+		[[nodiscard]] const T& front() const noexcept { return data()[0]; }
+
+	private:
+		[[nodiscard]] T* InlineAt(std::size_t i) noexcept { return std::launder(reinterpret_cast<T*>(storage_)) + i; }
+		[[nodiscard]] const T* InlineAt(std::size_t i) const noexcept { return std::launder(reinterpret_cast<const T*>(storage_)) + i; }
+
+		// 解構內部儲存的元素
+		void DestroyInline() noexcept
+		{
+			for (std::size_t i = 0; i < size_; ++i)
+				std::destroy_at(InlineAt(i));
+			size_ = 0;
+		}
+
+		// 接管 other 的元素（呼叫端保證自己是空的）；other 變成空的
+		void TakeFrom(SmallVector& other)
+		{
+			if (other.spilled_)
+			{
+				heap_    = std::move(other.heap_);
+				spilled_ = true;
+				other.heap_.clear();
+				other.spilled_ = false;
+				return;
+			}
+			for (std::size_t i = 0; i < other.size_; ++i)
+				std::construct_at(InlineAt(i), std::move(*other.InlineAt(i)));
+			size_ = other.size_;
+			other.DestroyInline();
+		}
+
+		alignas(T) std::byte storage_[N * sizeof(T)];
+		std::size_t          size_    = 0;
+		bool                 spilled_ = false;
+		std::vector<T>       heap_;
+	};
+// 結束命名空間
+}
+
+#endif
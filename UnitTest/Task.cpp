@@ -0,0 +1,104 @@
+// 引入對應的宣告標頭
+#include "Task.h"
+// std::byte
+#include <cstddef>
+// std::unique_ptr
+#include <memory>
+// operator new / delete
+#include <new>
+// 區塊清單
+#include <vector>
+
+// 進入命名空間
+namespace coro
+{
+	// 僅供本檔使用的區塊池
+	namespace
+	{
+		// 大小級距：64 位元組一級，共 32 級（最大 2 KB）
+		constexpr std::size_t kGranule    = 64;
+		constexpr std::size_t kClassCount = 32;
+		// 每次向系統要一整塊，切成這麼多個框架
+		constexpr std::size_t kSlabFrames = 64;
+
+		// 空閒框架串列的節點（直接放在框架記憶體開頭）
+		struct FreeNode
+		{
+			FreeNode* next;
+		};
+
+		// 每個執行緒一份：不需任何同步
+		struct FramePool
+		{
+			FreeNode*                               free[kClassCount] = {};
+			std::vector<std::unique_ptr<std::byte[]>> slabs;
+			FramePoolStats                          stats;
+		};
+
+		thread_local FramePool pool;
+
+		// 框架大小 → 級距（超過最大級距回傳 kClassCount）
+		[[nodiscard]] std::size_t ClassOf(std::size_t size) noexcept
+		{
+			const std::size_t cls = (size + kGranule - 1) / kGranule;
+			return cls == 0 ? 0 : (cls <= kClassCount ? cls - 1 : kClassCount);
+		}
+	}
+
+	// 目前執行緒的統計
+	FramePoolStats FrameStats() noexcept
+	{
+		return pool.stats;
+	}
+
+	namespace detail
+	{
+		// 先取空閒串列，沒有才切一塊新的
+		void* AllocateFrame(std::size_t size)
+		{
+			const std::size_t cls = ClassOf(size);
+			if (cls == kClassCount)
+			{
+				++pool.stats.oversized;
+				return ::operator new(size);
+			}
+
+			if (FreeNode* node = pool.free[cls]; node != nullptr)
+			{
+				pool.free[cls] = node->next;
+				++pool.stats.frames;
+				return node;
+			}
+
+			// 新區塊：第一個框架直接回傳，其餘放入空閒串列
+			const std::size_t block = (cls + 1) * kGranule;
+			auto slab = std::make_unique<std::byte[]>(block * kSlabFrames);
+			std::byte* base = slab.get();
+			pool.slabs.push_back(std::move(slab));
+			for (std::size_t i = kSlabFrames - 1; i > 0; --i)
+			{
+				auto* node = reinterpret_cast<FreeNode*>(base + i * block);
+				node->next = pool.free[cls];
+				pool.free[cls] = node;
+			}
+			++pool.stats.slabs;
+			++pool.stats.frames;
+			return base;
+		}
+
+		// 歸還到目前執行緒的空閒串列（同大小的下一個框架直接重用）
+		void FreeFrame(void* frame, std::size_t size) noexcept
+		{
+			const std::size_t cls = ClassOf(size);
+			if (cls == kClassCount)
+			{
+				::operator delete(frame, size);
+				return;
+			}
+			auto* node = static_cast<FreeNode*>(frame);
+			node->next = pool.free[cls];
+			pool.free[cls] = node;
+		}
+	}
+// 結束命名空間
+}
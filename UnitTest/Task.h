@@ -0,0 +1,227 @@
+// Include Guard：避免重複包含
+#ifndef TASK_H
+// 與上方成對
+#define TASK_H
+
+// PipelineError
+#include "Config.h"
+// std::coroutine_handle / std::suspend_always
+#include <coroutine>
+// std::size_t
+#include <cstddef>
+// std::terminate
+#include <exception>
+// std::expected
+#include <expected>
+// 結果暫存
+#include <optional>
+// std::move / std::exchange
+#include <utility>
+
+/*
+以協程撰寫的管線階段
+- Task<T> 是惰性啟動的協程，結果為 std::expected<T, PipelineError>
+- 在 Task 內 co_await 另一個 Task<U> 或 std::expected<U, PipelineError>：成功時得到 U；
+  失敗時不再恢復目前的協程，錯誤直接沿著 co_await 鏈傳到最外層（與 and_then 的短路相同）
+- co_return 可接受 T、std::unexpected(...) 或 std::expected<T, PipelineError>
+- 協程框架由每個執行緒各自的固定大小區塊池配置，同大小的框架重複使用，不經過全域 operator new
+- 框架必須在配置它的執行緒結束前銷毀（區塊池隨執行緒結束釋放）
+*/
+
+// 開始命名空間
+namespace coro
+{
+	using config::PipelineError;
+
+	// 目前執行緒的框架池統計
+	struct FramePoolStats
+	{
+		// 由區塊池配置的框架總數
+		std::size_t frames    = 0;
+		// 向系統要的區塊數（每塊可切出多個同大小的框架）
+		std::size_t slabs     = 0;
+		// 超過最大區塊大小、改用 operator new 的框架數
+		std::size_t oversized = 0;
+	};
+
+	// 取得目前執行緒的框架池統計
+	[[nodiscard]] FramePoolStats FrameStats() noexcept;
+
+	template<typename T>
+	class Task;
+
+	// 實作細節：框架池與共用的 promise 基底
+	namespace detail
+	{
+		// 從目前執行緒的區塊池配置 / 歸還協程框架
+		[[nodiscard]] void* AllocateFrame(std::size_t size);
+		void                FreeFrame(void* frame, std::size_t size) noexcept;
+
+		// 所有 Task promise 的共同部分：錯誤、等待者與 co_await 鏈
+		struct PromiseBase
+		{
+			// 完成（或短路）後要恢復的協程；最外層為 noop
+			std::coroutine_handle<> continuation = std::noop_coroutine();
+			// co_await 本協程的上一層 promise；最外層為 nullptr
+			PromiseBase*            parent       = nullptr;
+			// 失敗時的錯誤
+			std::optional<PipelineError> error;
+			// 已完成（正常結束或因錯誤短路）
+			bool                    finished     = false;
+
+			// 協程框架一律從區塊池配置
+			static void* operator new(std::size_t size) { return AllocateFrame(size); }
+			static void  operator delete(void* frame, std::size_t size) noexcept { FreeFrame(frame, size); }
+
+			// 本協程以錯誤結束：錯誤沿著 co_await 鏈往上交給最外層，中間各層都不再恢復；
+			// 回傳最外層的等待者（交給對稱轉移）
+			[[nodiscard]] std::coroutine_handle<> Unwind() noexcept
+			{
+				PromiseBase* p = this;
+				p->finished = true;
+				while (p->parent != nullptr)
+				{
+					p->parent->error    = std::move(p->error);
+					p->parent->finished = true;
+					p = p->parent;
+				}
+				return p->continuation;
+			}
+		};
+
+		// co_await std::expected：成功時不暫停，失敗時短路
+		template<typename U>
+		struct ExpectedAwaiter
+		{
+			std::expected<U, PipelineError> value;
+
+			[[nodiscard]] bool await_ready() const noexcept { return value.has_value(); }
+			template<typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept
+			{
+				self.promise().error = std::move(value.error());
+				return self.promise().Unwind();
+			}
+			[[nodiscard]] U await_resume() { return std::move(*value); }
+		};
+
+		// 結束時：成功則恢復等待者，失敗則短路整條鏈
+		struct FinalAwaiter
+		{
+			[[nodiscard]] bool await_ready() const noexcept { return false; }
+			template<typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept
+			{
+				auto& p = self.promise();
+				if (p.error)
+					return p.Unwind();
+				p.finished = true;
+				return p.continuation;
+			}
+			void await_resume() const noexcept {}
+		};
+	}
+
+	// 惰性協程：第一次被 co_await（或 IoContext::Post）時才開始執行；只能移動
+	template<typename T>
+	class Task
+	{
+	public:
+		struct promise_type : detail::PromiseBase
+		{
+			// 成功時的值
+			std::optional<T> value;
+
+			Task get_return_object() noexcept { return Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+			detail::FinalAwaiter final_suspend() const noexcept { return {}; }
+			// 錯誤以值傳回，不使用例外
+			void unhandled_exception() const noexcept { std::terminate(); }
+
+			// co_return：T 與 std::unexpected 都會轉成 std::expected
+			void return_value(std::expected<T, PipelineError> result)
+			{
+				if (result)
+					value.emplace(std::move(*result));
+				else
+					error.emplace(std::move(result.error()));
+			}
+
+			// co_await std::expected：成功取值，失敗短路
+			template<typename U>
+			detail::ExpectedAwaiter<U> await_transform(std::expected<U, PipelineError>&& result) noexcept
+			{
+				return {std::move(result)};
+			}
+			template<typename U>
+			detail::ExpectedAwaiter<U> await_transform(const std::expected<U, PipelineError>& result)
+			{
+				return {result};
+			}
+			// 其他可等待物件（Task、IoContext 的操作）原樣使用
+			template<typename Awaitable>
+			Awaitable&& await_transform(Awaitable&& awaitable) const noexcept
+			{
+				return std::forward<Awaitable>(awaitable);
+			}
+		};
+
+		Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (handle_)
+					handle_.destroy();
+				handle_ = std::exchange(other.handle_, {});
+			}
+			return *this;
+		}
+		~Task()
+		{
+			if (handle_)
+				handle_.destroy();
+		}
+
+		// 是否已完成（正常結束或因錯誤短路）
+		[[nodiscard]] bool done() const noexcept { return handle_ && handle_.promise().finished; }
+		// 取出結果；必須先確認 done()
+		[[nodiscard]] std::expected<T, PipelineError> result() &&
+		{
+			auto& p = handle_.promise();
+			if (p.error)
+				return std::unexpected(std::move(*p.error));
+			return std::move(*p.value);
+		}
+		// 最外層協程的 handle（交給 IoContext::Post 啟動）
+		[[nodiscard]] std::coroutine_handle<> handle() const noexcept { return handle_; }
+
+		// co_await 子 Task 的等待器
+		struct Awaiter
+		{
+			std::coroutine_handle<promise_type> child;
+
+			[[nodiscard]] bool await_ready() const noexcept { return false; }
+			// 對稱轉移：直接切到子協程，不經過事件迴圈
+			template<typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> parent) noexcept
+			{
+				child.promise().continuation = parent;
+				child.promise().parent       = &parent.promise();
+				return child;
+			}
+			[[nodiscard]] T await_resume() { return std::move(*child.promise().value); }
+		};
+
+		// co_await 子 Task：子協程成功時恢復目前協程並取值；失敗時整條鏈短路，目前協程不再恢復
+		Awaiter operator co_await() && noexcept { return Awaiter{handle_}; }
+
+	private:
+		explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+		std::coroutine_handle<promise_type> handle_;
+	};
+// 結束命名空間
+}
+
+#endif